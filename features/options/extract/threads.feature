@@ -0,0 +1,40 @@
+@extract @options @threads
+Feature: osrm-extract command line options: threads
+
+    Background:
+        Given the profile "car"
+        And a grid size of 5 meters
+        And the node map
+            """
+                    e       j
+            a b-----c-----d-i
+               `--h |      `k
+                   ||
+                  1||
+                   ||
+                   `f
+                    |
+                    g
+            """
+        And the ways
+            | nodes | highway    | name   | oneway | turn:lanes:forward                  |
+            | abc   | primary    | first  | yes    | left\|through\|through\|right       |
+            | cd    | primary    | first  | yes    | through\|through\|right             |
+            | di    | primary    | first  | yes    |                                     |
+            | dk    | primary    | third  | yes    |                                     |
+            | dj    | primary    | fourth |        |                                     |
+            | bhf   | primary    |        | yes    | right\|right                        |
+            | cfg   | primary    | second | yes    |                                     |
+            | ec    | primary    | second |        | left\|right                         |
+        And the relations
+            | type        | way:from | way:to | node:via | restriction   |
+            | restriction | abc      | cfg    | c        | no_right_turn |
+        And the data has been saved to disk
+
+    Scenario: osrm-extract - Output does not depend on the number of threads
+        When I run "osrm-extract --threads 1 --generate-edge-lookup --profile {profile_file} {osm_file}"
+        Then it should exit successfully
+        When I keep the extracted files as "serial"
+        And I run "osrm-extract --threads 4 --generate-edge-lookup --profile {profile_file} {osm_file}"
+        Then it should exit successfully
+        And the extracted files should be identical to "serial"
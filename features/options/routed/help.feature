@@ -21,6 +21,11 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-table-threads"
+        And stdout should contain "--max-isochrone-duration"
+        And stdout should contain "--max-batch-route-size"
+        And stdout should contain "--max-batch-nearest-size"
+        And stdout should contain "--max-batch-threads"
         And it should exit successfully
 
     Scenario: osrm-routed - Help, short
@@ -40,6 +45,11 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--max-trip-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-table-threads"
+        And stdout should contain "--max-isochrone-duration"
+        And stdout should contain "--max-batch-route-size"
+        And stdout should contain "--max-batch-nearest-size"
+        And stdout should contain "--max-batch-threads"
         And it should exit successfully
 
     Scenario: osrm-routed - Help, long
@@ -59,4 +69,9 @@ Feature: osrm-routed command line options: help
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-table-size"
         And stdout should contain "--max-matching-size"
+        And stdout should contain "--max-table-threads"
+        And stdout should contain "--max-isochrone-duration"
+        And stdout should contain "--max-batch-route-size"
+        And stdout should contain "--max-batch-nearest-size"
+        And stdout should contain "--max-batch-threads"
         And it should exit successfully
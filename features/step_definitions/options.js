@@ -106,6 +106,23 @@ module.exports = function () {
         assert.equal(actualData, expectedData);
     });
 
+    // outputs of the edge-expanded graph stage that must not depend on the number of threads
+    const extractedFiles = ['.edges', '.ebg', '.tld', '.tls', '.edge_segment_lookup', '.edge_penalties', '.icd'];
+
+    this.When(/^I keep the extracted files as "(.+)"$/, (name) => {
+        extractedFiles.forEach(ext => {
+            const file = this.processedCacheFile + ext;
+            fs.writeFileSync(file + '.' + name, fs.readFileSync(file));
+        });
+    });
+
+    this.Then(/^the extracted files should be identical to "(.+)"$/, (name) => {
+        extractedFiles.forEach(ext => {
+            const file = this.processedCacheFile + ext;
+            assert.ok(fs.readFileSync(file).equals(fs.readFileSync(file + '.' + name)), file + ' differs from ' + name);
+        });
+    });
+
     this.Given(/^the query options$/, (table, callback) => {
         table.raw().forEach(tuple => {
             this.queryParams[tuple[0]] = tuple[1];
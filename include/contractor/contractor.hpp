@@ -70,7 +70,10 @@ class Contractor
     void ReadNodeLevels(std::vector<float> &contraction_order) const;
     std::size_t
     WriteContractedGraph(unsigned number_of_edge_based_nodes,
-                         const util::DeallocatingVector<QueryEdge> &contracted_edge_list);
+                         const util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                         const std::vector<float> &node_levels);
+    void CustomizeGraph(const EdgeID max_edge_id,
+                        util::DeallocatingVector<extractor::EdgeBasedEdge> &edge_based_edge_list);
     void FindComponents(unsigned max_edge_id,
                         const util::DeallocatingVector<extractor::EdgeBasedEdge> &edges,
                         std::vector<extractor::EdgeBasedNode> &nodes) const;
@@ -71,6 +71,8 @@ struct ContractorConfig
     std::string geometry_path;
     std::string rtree_leaf_path;
     bool use_cached_priority;
+    // Only recompute the weights of the hierarchy in graph_output_path for the new metric
+    bool customize_only = false;
 
     unsigned requested_num_threads;
     double log_edge_updates_factor;
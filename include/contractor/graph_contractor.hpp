@@ -370,7 +370,8 @@ class GraphContractor
         {
             util::UnbufferedLog log;
             log << "using cached node priorities ...";
-            node_priorities.swap(node_levels);
+            // the cached levels are kept, GetNodeLevels() returns them for the downward sweep
+            node_priorities = node_levels;
             log << "ok";
         }
         else
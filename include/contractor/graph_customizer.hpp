@@ -0,0 +1,390 @@
+#ifndef GRAPH_CUSTOMIZER_HPP
+#define GRAPH_CUSTOMIZER_HPP
+
+#include "contractor/query_edge.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+// Recomputes the weights of an existing contraction hierarchy for a new metric.
+//
+// The shortcuts of the hierarchy are kept, only their weights and middle nodes are updated.
+// Every edge of the hierarchy is either a direct edge of the edge-expanded graph or the best
+// path over a lower node, so all weights can be computed bottom-up. Nodes of one round only
+// depend on earlier rounds and are processed in parallel.
+//
+// Shortcuts pruned by witness searches under the old metric are not recreated. Queries stay
+// correct paths but can lose optimality if the metric changes a lot, a full contraction
+// restores it.
+class GraphCustomizer
+{
+  private:
+    // A hierarchy edge in a single direction, stored at its lower node
+    struct CustomizerEdge
+    {
+        NodeID source;
+        NodeID target;
+        // middle node of a shortcut or the edge-based edge id of a direct edge
+        NodeID id;
+        EdgeWeight weight;
+        bool shortcut;
+        // source -> target if set, target -> source otherwise
+        bool forward;
+
+        bool operator<(const CustomizerEdge &other) const
+        {
+            return std::tie(source, target, forward) <
+                   std::tie(other.source, other.target, other.forward);
+        }
+    };
+
+    // A directed edge of the edge-expanded graph
+    struct Arc
+    {
+        NodeID source;
+        NodeID target;
+        EdgeWeight weight;
+        EdgeID edge_id;
+
+        bool operator<(const Arc &other) const
+        {
+            return std::tie(source, target, weight, edge_id) <
+                   std::tie(other.source, other.target, other.weight, other.edge_id);
+        }
+    };
+
+  public:
+    GraphCustomizer(const NodeID number_of_nodes,
+                    util::DeallocatingVector<QueryEdge> &contracted_edge_list)
+    {
+        edges.reserve(contracted_edge_list.size() * 2);
+        for (const auto &edge : contracted_edge_list)
+        {
+            if (edge.source >= number_of_nodes || edge.target >= number_of_nodes)
+            {
+                throw util::exception("Contracted edge " + std::to_string(edge.source) + " -> " +
+                                      std::to_string(edge.target) + " is out of range" +
+                                      SOURCE_REF);
+            }
+
+            if (edge.data.forward)
+            {
+                edges.push_back({edge.source, edge.target, 0, INVALID_EDGE_WEIGHT, false, true});
+            }
+            if (edge.data.backward)
+            {
+                edges.push_back({edge.source, edge.target, 0, INVALID_EDGE_WEIGHT, false, false});
+            }
+        }
+        contracted_edge_list.clear();
+
+        // parallel edges collapse into one, the weights are recomputed from scratch anyway
+        tbb::parallel_sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(),
+                                edges.end(),
+                                [](const CustomizerEdge &lhs, const CustomizerEdge &rhs) {
+                                    return !(lhs < rhs) && !(rhs < lhs);
+                                }),
+                    edges.end());
+        edges.shrink_to_fit();
+
+        first_edge.resize(number_of_nodes + 1, 0);
+        for (const auto &edge : edges)
+        {
+            ++first_edge[edge.source + 1];
+        }
+        std::partial_sum(first_edge.begin(), first_edge.end(), first_edge.begin());
+
+        // edges point upwards, so every source of an edge into a node is a lower neighbour
+        std::vector<std::pair<NodeID, NodeID>> upwards;
+        upwards.reserve(edges.size());
+        for (const auto &edge : edges)
+        {
+            if (edge.source != edge.target)
+            {
+                upwards.emplace_back(edge.target, edge.source);
+            }
+        }
+        tbb::parallel_sort(upwards.begin(), upwards.end());
+        upwards.erase(std::unique(upwards.begin(), upwards.end()), upwards.end());
+
+        first_lower_neighbour.resize(number_of_nodes + 1, 0);
+        lower_neighbours.reserve(upwards.size());
+        for (const auto &pair : upwards)
+        {
+            ++first_lower_neighbour[pair.first + 1];
+            lower_neighbours.push_back(pair.second);
+        }
+        std::partial_sum(first_lower_neighbour.begin(),
+                         first_lower_neighbour.end(),
+                         first_lower_neighbour.begin());
+
+        BuildRounds(number_of_nodes);
+    }
+
+    // Sets the weights of all hierarchy edges to the ones implied by the edge-expanded graph
+    void Run(const util::DeallocatingVector<extractor::EdgeBasedEdge> &edge_based_edge_list)
+    {
+        arcs.clear();
+        arcs.reserve(edge_based_edge_list.size());
+        for (const auto &edge : edge_based_edge_list)
+        {
+            // eigenloops are never part of the hierarchy
+            if (edge.source == edge.target)
+            {
+                continue;
+            }
+
+            // same weight handling as in the GraphContractor
+            const EdgeWeight weight = std::max(static_cast<EdgeWeight>(edge.weight), 1);
+            if (edge.forward)
+            {
+                arcs.push_back({edge.source, edge.target, weight, edge.edge_id});
+            }
+            if (edge.backward)
+            {
+                arcs.push_back({edge.target, edge.source, weight, edge.edge_id});
+            }
+        }
+        tbb::parallel_sort(arcs.begin(), arcs.end());
+
+        util::Log() << "Customizing " << edges.size() << " edges in " << NumberOfRounds()
+                    << " rounds";
+
+        for (const auto round : util::irange<std::size_t>(0, NumberOfRounds()))
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(
+                    first_round_node[round], first_round_node[round + 1], CustomizeGrainSize),
+                [this](const tbb::blocked_range<std::size_t> &range) {
+                    for (auto position = range.begin(), end = range.end(); position != end;
+                         ++position)
+                    {
+                        CustomizeNode(round_nodes[position]);
+                    }
+                });
+        }
+
+        arcs.clear();
+        arcs.shrink_to_fit();
+    }
+
+    // Returns the customized hierarchy, edges that became unusable are dropped
+    void GetEdges(util::DeallocatingVector<QueryEdge> &contracted_edge_list)
+    {
+        for (std::size_t index = 0; index < edges.size(); ++index)
+        {
+            const auto &edge = edges[index];
+            if (edge.weight == INVALID_EDGE_WEIGHT)
+            {
+                continue;
+            }
+
+            QueryEdge query_edge;
+            query_edge.source = edge.source;
+            query_edge.target = edge.target;
+            query_edge.data.id = edge.id;
+            query_edge.data.shortcut = edge.shortcut;
+            query_edge.data.weight = edge.weight;
+            query_edge.data.forward = edge.forward;
+            query_edge.data.backward = !edge.forward;
+
+            // backward sorts before forward, merge both directions if they are identical
+            if (!edge.forward && index + 1 < edges.size())
+            {
+                const auto &next = edges[index + 1];
+                if (next.source == edge.source && next.target == edge.target &&
+                    next.weight == edge.weight && next.shortcut == edge.shortcut &&
+                    next.id == edge.id)
+                {
+                    query_edge.data.forward = true;
+                    ++index;
+                }
+            }
+
+            contracted_edge_list.push_back(query_edge);
+        }
+
+        edges.clear();
+        edges.shrink_to_fit();
+    }
+
+    std::size_t NumberOfRounds() const
+    {
+        return first_round_node.empty() ? 0 : first_round_node.size() - 1;
+    }
+
+  private:
+    static constexpr std::size_t CustomizeGrainSize = 256;
+
+    // Groups the nodes into rounds so that all lower neighbours of a node are in earlier rounds
+    void BuildRounds(const NodeID number_of_nodes)
+    {
+        std::vector<NodeID> remaining_lower_neighbours(number_of_nodes);
+        std::vector<NodeID> current_round;
+        for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        {
+            remaining_lower_neighbours[node] =
+                first_lower_neighbour[node + 1] - first_lower_neighbour[node];
+            if (remaining_lower_neighbours[node] == 0)
+            {
+                current_round.push_back(node);
+            }
+        }
+
+        round_nodes.reserve(number_of_nodes);
+        std::vector<NodeID> next_round;
+        while (!current_round.empty())
+        {
+            first_round_node.push_back(round_nodes.size());
+            round_nodes.insert(round_nodes.end(), current_round.begin(), current_round.end());
+
+            next_round.clear();
+            for (const auto node : current_round)
+            {
+                NodeID last_target = SPECIAL_NODEID;
+                for (auto edge = first_edge[node]; edge < first_edge[node + 1]; ++edge)
+                {
+                    const NodeID target = edges[edge].target;
+                    if (target == node || target == last_target)
+                    {
+                        continue;
+                    }
+                    last_target = target;
+
+                    if (--remaining_lower_neighbours[target] == 0)
+                    {
+                        next_round.push_back(target);
+                    }
+                }
+            }
+            current_round.swap(next_round);
+        }
+        first_round_node.push_back(round_nodes.size());
+
+        if (round_nodes.size() != number_of_nodes)
+        {
+            throw util::exception("Contracted graph is not a hierarchy, " +
+                                  std::to_string(number_of_nodes - round_nodes.size()) +
+                                  " nodes are part of a cycle" + SOURCE_REF);
+        }
+    }
+
+    EdgeWeight FindArcWeight(const NodeID source, const NodeID target, EdgeID &edge_id) const
+    {
+        const Arc key{source, target, 0, 0};
+        const auto arc = std::lower_bound(arcs.begin(), arcs.end(), key);
+        if (arc == arcs.end() || arc->source != source || arc->target != target)
+        {
+            return INVALID_EDGE_WEIGHT;
+        }
+        edge_id = arc->edge_id;
+        return arc->weight;
+    }
+
+    void CustomizeNode(const NodeID node)
+    {
+        const auto begin = edges.begin() + first_edge[node];
+        const auto end = edges.begin() + first_edge[node + 1];
+
+        // start with the direct edges, an edge without one is a pure shortcut
+        for (auto edge = begin; edge != end; ++edge)
+        {
+            EdgeID edge_id = SPECIAL_EDGEID;
+            edge->weight = edge->forward ? FindArcWeight(node, edge->target, edge_id)
+                                         : FindArcWeight(edge->target, node, edge_id);
+            edge->id = edge->weight == INVALID_EDGE_WEIGHT ? 0 : edge_id;
+            edge->shortcut = false;
+        }
+
+        // relax all triangles node -> middle -> target with a lower middle node, the edges of
+        // the middle node are final since it belongs to an earlier round
+        for (auto neighbour = first_lower_neighbour[node];
+             neighbour < first_lower_neighbour[node + 1];
+             ++neighbour)
+        {
+            const NodeID middle = lower_neighbours[neighbour];
+            const auto middle_begin = edges.begin() + first_edge[middle];
+            const auto middle_end = edges.begin() + first_edge[middle + 1];
+
+            EdgeWeight weight_to_middle = INVALID_EDGE_WEIGHT;
+            EdgeWeight weight_from_middle = INVALID_EDGE_WEIGHT;
+            for (auto edge = std::lower_bound(middle_begin,
+                                              middle_end,
+                                              node,
+                                              [](const CustomizerEdge &lhs, const NodeID rhs) {
+                                                  return lhs.target < rhs;
+                                              });
+                 edge != middle_end && edge->target == node;
+                 ++edge)
+            {
+                (edge->forward ? weight_from_middle : weight_to_middle) = edge->weight;
+            }
+
+            // both ranges are sorted by target and direction
+            auto edge = begin;
+            auto middle_edge = middle_begin;
+            while (edge != end && middle_edge != middle_end)
+            {
+                const auto key = std::tie(edge->target, edge->forward);
+                const auto middle_key = std::tie(middle_edge->target, middle_edge->forward);
+                if (key < middle_key)
+                {
+                    ++edge;
+                    continue;
+                }
+                if (middle_key < key)
+                {
+                    ++middle_edge;
+                    continue;
+                }
+
+                const EdgeWeight first_half = edge->forward ? weight_to_middle : weight_from_middle;
+                if (first_half != INVALID_EDGE_WEIGHT &&
+                    middle_edge->weight != INVALID_EDGE_WEIGHT &&
+                    first_half + middle_edge->weight < edge->weight)
+                {
+                    edge->weight = first_half + middle_edge->weight;
+                    edge->id = middle;
+                    edge->shortcut = true;
+                }
+                ++edge;
+                ++middle_edge;
+            }
+        }
+    }
+
+    std::vector<CustomizerEdge> edges;
+    std::vector<EdgeID> first_edge;
+    std::vector<EdgeID> first_lower_neighbour;
+    std::vector<NodeID> lower_neighbours;
+    std::vector<std::size_t> first_round_node;
+    std::vector<NodeID> round_nodes;
+    std::vector<Arc> arcs;
+};
+}
+}
+
+#endif // GRAPH_CUSTOMIZER_HPP
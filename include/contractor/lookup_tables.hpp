@@ -0,0 +1,207 @@
+#ifndef OSRM_CONTRACTOR_LOOKUP_TABLES_HPP
+#define OSRM_CONTRACTOR_LOOKUP_TABLES_HPP
+
+#include "util/typedefs.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+struct Segment final
+{
+    OSMNodeID from, to;
+    bool operator==(const Segment &other) const
+    {
+        return std::tie(from, to) == std::tie(other.from, other.to);
+    }
+};
+
+struct SpeedSource final
+{
+    unsigned speed;
+    std::uint8_t source;
+};
+
+struct SegmentSpeedSource final
+{
+    Segment segment;
+    SpeedSource speed_source;
+    // < operator is overloaded here to return a > comparison to be used by the
+    // std::lower_bound() call in the find() function
+    bool operator<(const SegmentSpeedSource &other) const
+    {
+        return std::tie(segment.from, segment.to) > std::tie(other.segment.from, other.segment.to);
+    }
+};
+
+struct Turn final
+{
+    OSMNodeID from, via, to;
+    bool operator==(const Turn &other) const
+    {
+        return std::tie(from, via, to) == std::tie(other.from, other.via, other.to);
+    }
+};
+
+struct PenaltySource final
+{
+    double penalty;
+    std::uint8_t source;
+};
+struct TurnPenaltySource final
+{
+    Turn segment;
+    PenaltySource penalty_source;
+    // < operator is overloaded here to return a > comparison to be used by the
+    // std::lower_bound() call in the find() function
+    bool operator<(const TurnPenaltySource &other) const
+    {
+        return std::tie(segment.from, segment.via, segment.to) >
+               std::tie(other.segment.from, other.segment.via, other.segment.to);
+    }
+};
+using TurnPenaltySourceFlatMap = std::vector<TurnPenaltySource>;
+using SegmentSpeedSourceFlatMap = std::vector<SegmentSpeedSource>;
+
+// Find is a binary Search over a flattened key,val Segment storage
+// It takes the flat map and a Segment/PenaltySource object that has an overloaded
+// `==` operator, to make the std::lower_bound call work generically
+template <typename FlatMap, typename SegmentKey>
+auto find(const FlatMap &map, const SegmentKey &key)
+{
+    const auto last = end(map);
+    auto it = std::lower_bound(begin(map), last, key);
+
+    if (it != last && (it->segment == key.segment))
+        return it;
+
+    return last;
+}
+
+// Functions for parsing files and creating lookup tables.
+//
+// Every file is memory mapped and split into chunks at line boundaries, all chunks of all files
+// are parsed in parallel and the sorted chunks are merged in parallel afterwards. On duplicates
+// the file given last wins, within a file the first line wins. The source of an entry is the
+// one-based index of the file it was read from.
+
+SegmentSpeedSourceFlatMap
+parse_segment_lookup_from_csv_files(const std::vector<std::string> &segment_speed_filenames);
+
+TurnPenaltySourceFlatMap
+parse_turn_penalty_lookup_from_csv_files(const std::vector<std::string> &turn_penalty_filenames);
+
+// Binary update files start with a fingerprint and this header, followed by fixed-width records
+// sorted ascending by their OSM node ids. They are written by osrm-convert-lookups.
+struct UpdateFileHeader final
+{
+    enum RecordType : std::uint32_t
+    {
+        SEGMENT_SPEEDS = 1,
+        TURN_PENALTIES = 2
+    };
+
+    std::uint32_t record_type;
+    std::uint32_t record_size;
+    std::uint64_t number_of_records;
+};
+
+struct SegmentSpeedRecord final
+{
+    static const constexpr auto RECORD_TYPE = UpdateFileHeader::SEGMENT_SPEEDS;
+
+    OSMNodeID from, to;
+    std::uint32_t speed;
+    std::uint32_t padding;
+
+    bool operator<(const SegmentSpeedRecord &other) const
+    {
+        return std::tie(from, to) < std::tie(other.from, other.to);
+    }
+};
+
+struct TurnPenaltyRecord final
+{
+    static const constexpr auto RECORD_TYPE = UpdateFileHeader::TURN_PENALTIES;
+
+    OSMNodeID from, via, to;
+    double penalty;
+
+    bool operator<(const TurnPenaltyRecord &other) const
+    {
+        return std::tie(from, via, to) < std::tie(other.from, other.via, other.to);
+    }
+};
+
+static_assert(sizeof(UpdateFileHeader) == 16, "UpdateFileHeader is part of the file format");
+static_assert(sizeof(SegmentSpeedRecord) == 24, "SegmentSpeedRecord is part of the file format");
+static_assert(sizeof(TurnPenaltyRecord) == 32, "TurnPenaltyRecord is part of the file format");
+
+// Checks for the fingerprint that CSV files do not have
+bool isBinaryUpdateFile(const std::string &filename);
+
+void writeSegmentSpeedFile(const std::string &filename, const SegmentSpeedSourceFlatMap &lookup);
+void writeTurnPenaltyFile(const std::string &filename, const TurnPenaltySourceFlatMap &lookup);
+
+// The records of a memory mapped binary update file
+template <typename Record> class MappedUpdateFile
+{
+  public:
+    MappedUpdateFile(const std::string &filename, const std::uint8_t source);
+
+    const Record *begin() const { return first; }
+    const Record *end() const { return last; }
+    std::size_t size() const { return last - first; }
+    std::uint8_t GetSource() const { return source; }
+
+  private:
+    boost::interprocess::mapped_region region;
+    const Record *first;
+    const Record *last;
+    std::uint8_t source;
+};
+
+// Lookups over a mix of CSV and binary update files with later files taking precedence.
+// CSV files are parsed into a flat map while binary files are searched where they are mapped.
+class SegmentSpeedLookup
+{
+  public:
+    SegmentSpeedLookup() = default;
+    explicit SegmentSpeedLookup(const std::vector<std::string> &segment_speed_filenames);
+
+    boost::optional<SpeedSource> Find(const OSMNodeID from, const OSMNodeID to) const;
+
+  private:
+    SegmentSpeedSourceFlatMap csv_lookup;
+    // ordered by descending source
+    std::vector<MappedUpdateFile<SegmentSpeedRecord>> binary_files;
+};
+
+class TurnPenaltyLookup
+{
+  public:
+    TurnPenaltyLookup() = default;
+    explicit TurnPenaltyLookup(const std::vector<std::string> &turn_penalty_filenames);
+
+    boost::optional<PenaltySource>
+    Find(const OSMNodeID from, const OSMNodeID via, const OSMNodeID to) const;
+
+  private:
+    TurnPenaltySourceFlatMap csv_lookup;
+    // ordered by descending source
+    std::vector<MappedUpdateFile<TurnPenaltyRecord>> binary_files;
+};
+}
+}
+
+#endif // OSRM_CONTRACTOR_LOOKUP_TABLES_HPP
@@ -0,0 +1,29 @@
+#ifndef SWEEP_EDGE_HPP
+#define SWEEP_EDGE_HPP
+
+#include "util/typedefs.hpp"
+
+namespace osrm
+{
+namespace contractor
+{
+
+// The downward sweep stores all nodes of the hierarchy ordered by descending contraction level.
+// Nodes are identified by their position in this order. Every node lists the downward edges
+// that end in it, so a single linear pass over the positions relaxes every downward path.
+struct SweepNode
+{
+    // index of the first downward edge ending in this node
+    EdgeID first_edge;
+};
+
+struct SweepEdge
+{
+    // position of the (higher) node the downward edge starts at
+    NodeID source;
+    EdgeWeight weight;
+};
+}
+}
+
+#endif // SWEEP_EDGE_HPP
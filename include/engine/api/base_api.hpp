@@ -5,11 +5,16 @@
 #include "engine/datafacade/datafacade_base.hpp"
 
 #include "engine/api/json_factory.hpp"
+#include "engine/api/pbf_factory.hpp"
 #include "engine/hint.hpp"
+#include "util/json_writer.hpp"
 
 #include <boost/assert.hpp>
 #include <boost/range/algorithm/transform.hpp>
 
+#include <protozero/pbf_writer.hpp>
+
+#include <cstdint>
 #include <vector>
 
 namespace osrm
@@ -60,6 +65,51 @@ class BaseAPI
         }
     }
 
+    // Streaming version of MakeWaypoint, writes the same object
+    void WriteWaypoint(util::json::Writer &writer, const PhantomNode &phantom) const
+    {
+        writer.StartObject();
+        WriteWaypointMembers(writer, phantom);
+        writer.EndObject();
+    }
+
+    // Writes the members of a waypoint into an object that was already started
+    void WriteWaypointMembers(util::json::Writer &writer, const PhantomNode &phantom) const
+    {
+        if (parameters.generate_hints)
+        {
+            writer.WriteKey("hint");
+            writer.WriteString(Hint{phantom, facade.GetCheckSum()}.ToBase64());
+        }
+        writer.WriteKey("name");
+        writer.WriteString(facade.GetNameForID(phantom.name_id));
+        writer.WriteKey("location");
+        writer.StartArray();
+        writer.WriteNumber(static_cast<double>(util::toFloating(phantom.location.lon)));
+        writer.WriteNumber(static_cast<double>(util::toFloating(phantom.location.lat)));
+        writer.EndArray();
+    }
+
+    // Protobuf version of MakeWaypoint, writes a Waypoint message with the given tag
+    void WriteWaypoint(protozero::pbf_writer &writer,
+                       const std::uint32_t tag,
+                       const PhantomNode &phantom) const
+    {
+        protozero::pbf_writer waypoint(writer, tag);
+        WriteWaypointMembers(waypoint, phantom);
+    }
+
+    void WriteWaypointMembers(protozero::pbf_writer &waypoint, const PhantomNode &phantom) const
+    {
+        if (parameters.generate_hints)
+        {
+            waypoint.add_string(pbf::WAYPOINT_HINT_TAG,
+                                Hint{phantom, facade.GetCheckSum()}.ToBase64());
+        }
+        waypoint.add_string(pbf::WAYPOINT_NAME_TAG, facade.GetNameForID(phantom.name_id));
+        pbf::writeLocation(waypoint, pbf::WAYPOINT_LOCATION_TAG, phantom.location);
+    }
+
     const datafacade::BaseDataFacade &facade;
     const BaseParameters &parameters;
 };
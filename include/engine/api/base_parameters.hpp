@@ -55,12 +55,19 @@ namespace api
  *              optional per coordinate
  *  - bearings: limits the search for segments in the road network to given bearing(s) in degree
  *              towards true north in clockwise direction, optional per coordinate
+ *  - format: output format of the response, either JSON or a protobuf message (PBF)
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
  */
 struct BaseParameters
 {
+    enum class OutputFormatType
+    {
+        JSON,
+        PBF
+    };
+
     std::vector<util::Coordinate> coordinates;
     std::vector<boost::optional<Hint>> hints;
     std::vector<boost::optional<double>> radiuses;
@@ -69,13 +76,18 @@ struct BaseParameters
     // Adds hints to response which can be included in subsequent requests, see `hints` above.
     bool generate_hints = true;
 
+    // Only used by osrm-routed to pick the encoding of the response, library users select the
+    // format by the result type they pass to OSRM.
+    OutputFormatType format = OutputFormatType::JSON;
+
     BaseParameters(const std::vector<util::Coordinate> coordinates_ = {},
                    const std::vector<boost::optional<Hint>> hints_ = {},
                    std::vector<boost::optional<double>> radiuses_ = {},
                    std::vector<boost::optional<Bearing>> bearings_ = {},
-                   bool generate_hints_ = true)
+                   bool generate_hints_ = true,
+                   OutputFormatType format_ = OutputFormatType::JSON)
         : coordinates(coordinates_), hints(hints_), radiuses(radiuses_), bearings(bearings_),
-          generate_hints(generate_hints_)
+          generate_hints(generate_hints_), format(format_)
     {
     }
 
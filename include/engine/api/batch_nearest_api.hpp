@@ -0,0 +1,95 @@
+#ifndef ENGINE_API_BATCH_NEAREST_API_HPP
+#define ENGINE_API_BATCH_NEAREST_API_HPP
+
+#include "engine/api/base_api.hpp"
+#include "engine/api/batch_nearest_parameters.hpp"
+
+#include "engine/phantom_node.hpp"
+
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/assert.hpp>
+
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class BatchNearestAPI final : public BaseAPI
+{
+  public:
+    BatchNearestAPI(const datafacade::BaseDataFacade &facade_,
+                    const BatchNearestParameters &parameters_)
+        : BaseAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    // One array of waypoints per coordinate, empty if no segment was found for it
+    void MakeResponse(const std::vector<std::vector<PhantomNodeWithDistance>> &phantom_nodes,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(phantom_nodes.size() == parameters.coordinates.size());
+
+        util::json::Array waypoints;
+        waypoints.values.reserve(phantom_nodes.size());
+        for (const auto &candidates : phantom_nodes)
+        {
+            util::json::Array coordinate_waypoints;
+            coordinate_waypoints.values.reserve(candidates.size());
+            for (const auto &phantom_with_distance : candidates)
+            {
+                auto waypoint = MakeWaypoint(phantom_with_distance.phantom_node);
+                waypoint.values["distance"] = phantom_with_distance.distance;
+                coordinate_waypoints.values.push_back(std::move(waypoint));
+            }
+            waypoints.values.push_back(std::move(coordinate_waypoints));
+        }
+
+        response.values["code"] = "Ok";
+        response.values["waypoints"] = std::move(waypoints);
+    }
+
+    // Streaming version of the response above
+    void MakeResponse(const std::vector<std::vector<PhantomNodeWithDistance>> &phantom_nodes,
+                      util::json::Writer &writer) const
+    {
+        BOOST_ASSERT(phantom_nodes.size() == parameters.coordinates.size());
+
+        writer.StartObject();
+        writer.WriteKey("code");
+        writer.WriteString("Ok");
+
+        writer.WriteKey("waypoints");
+        writer.StartArray();
+        for (const auto &candidates : phantom_nodes)
+        {
+            writer.StartArray();
+            for (const auto &phantom_with_distance : candidates)
+            {
+                writer.StartObject();
+                WriteWaypointMembers(writer, phantom_with_distance.phantom_node);
+                writer.WriteKey("distance");
+                writer.WriteNumber(phantom_with_distance.distance);
+                writer.EndObject();
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+  protected:
+    const BatchNearestParameters &parameters;
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
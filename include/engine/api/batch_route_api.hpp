@@ -0,0 +1,106 @@
+#ifndef ENGINE_API_BATCH_ROUTE_HPP
+#define ENGINE_API_BATCH_ROUTE_HPP
+
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/api/route_api.hpp"
+
+#include "engine/datafacade/datafacade_base.hpp"
+
+#include "engine/internal_route_result.hpp"
+#include "engine/phantom_node.hpp"
+
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class BatchRouteAPI final : public RouteAPI
+{
+  public:
+    BatchRouteAPI(const datafacade::BaseDataFacade &facade_,
+                  const BatchRouteParameters &parameters_)
+        : RouteAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    // Route object of a single pair, null if there is no route between its locations.
+    // Only reads the facade, so the routes of different pairs can be built concurrently.
+    util::json::Value MakeBatchRoute(const InternalRouteResult &raw_route) const
+    {
+        if (!raw_route.is_valid())
+        {
+            return util::json::Null();
+        }
+        return MakeRoute(raw_route.segment_end_coordinates,
+                         raw_route.unpacked_path_segments,
+                         raw_route.source_traversed_in_reverse,
+                         raw_route.target_traversed_in_reverse);
+    }
+
+    void MakeResponse(const std::vector<PhantomNode> &phantoms,
+                      std::vector<util::json::Value> routes,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(routes.size() == parameters.pairs.size());
+
+        util::json::Array waypoints;
+        waypoints.values.reserve(phantoms.size());
+        for (const auto &phantom : phantoms)
+        {
+            waypoints.values.push_back(BaseAPI::MakeWaypoint(phantom));
+        }
+
+        util::json::Array json_routes;
+        json_routes.values = std::move(routes);
+
+        response.values["waypoints"] = std::move(waypoints);
+        response.values["routes"] = std::move(json_routes);
+        response.values["code"] = "Ok";
+    }
+
+    // Streaming version of the response above, the routes are written in the order of the pairs
+    void MakeResponse(const std::vector<PhantomNode> &phantoms,
+                      const std::vector<util::json::Value> &routes,
+                      util::json::Writer &writer) const
+    {
+        BOOST_ASSERT(routes.size() == parameters.pairs.size());
+
+        writer.StartObject();
+        writer.WriteKey("code");
+        writer.WriteString("Ok");
+
+        writer.WriteKey("waypoints");
+        writer.StartArray();
+        for (const auto &phantom : phantoms)
+        {
+            BaseAPI::WriteWaypoint(writer, phantom);
+        }
+        writer.EndArray();
+
+        writer.WriteKey("routes");
+        writer.StartArray();
+        for (const auto &route : routes)
+        {
+            writer.WriteValue(route);
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+  protected:
+    const BatchRouteParameters &parameters;
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
@@ -0,0 +1,87 @@
+/*
+
+Copyright (c) 2017, Project OSRM contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef ENGINE_API_BATCH_ROUTE_PARAMETERS_HPP
+#define ENGINE_API_BATCH_ROUTE_PARAMETERS_HPP
+
+#include "engine/api/route_parameters.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+/**
+ * Parameters specific to the OSRM Batch Route service.
+ *
+ * Holds member attributes:
+ *  - pairs: independent routes to compute, each given by the indices of its source and
+ *           destination in the coordinates
+ *
+ * All route options except alternatives and continue_straight apply to every route. Every
+ * coordinate is snapped once, no matter how many pairs refer to it.
+ *
+ * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
+ *      NearestParameters, TripParameters, MatchParameters, TileParameters and
+ *      BatchRouteParameters
+ */
+struct BatchRouteParameters : public RouteParameters
+{
+    using Pair = std::pair<std::size_t, std::size_t>;
+
+    std::vector<Pair> pairs;
+
+    BatchRouteParameters() { overview = OverviewType::False; }
+
+    template <typename... Args>
+    BatchRouteParameters(std::vector<Pair> pairs_, Args... args_)
+        : RouteParameters{std::forward<Args>(args_)...}, pairs{std::move(pairs_)}
+    {
+    }
+
+    bool IsValid() const
+    {
+        const auto in_range = [this](const Pair &pair) {
+            return pair.first < coordinates.size() && pair.second < coordinates.size();
+        };
+        return BaseParameters::IsValid() && !coordinates.empty() && !pairs.empty() &&
+               !alternatives && std::all_of(pairs.begin(), pairs.end(), in_range);
+    }
+};
+}
+}
+}
+
+#endif // ENGINE_API_BATCH_ROUTE_PARAMETERS_HPP
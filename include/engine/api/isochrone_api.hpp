@@ -0,0 +1,117 @@
+#ifndef ENGINE_API_ISOCHRONE_API_HPP
+#define ENGINE_API_ISOCHRONE_API_HPP
+
+#include "engine/api/base_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include "engine/api/json_factory.hpp"
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+// Directed road segment that can be entered within the duration budget of an isochrone.
+// The weights are the weights at which the start and the end of the segment are reached,
+// the start weight is negative for the segment the source is snapped to.
+struct IsochroneSegment
+{
+    util::Coordinate from;
+    util::Coordinate to;
+    EdgeWeight from_weight;
+    EdgeWeight to_weight;
+};
+
+class IsochroneAPI final : public BaseAPI
+{
+  public:
+    IsochroneAPI(const datafacade::BaseDataFacade &facade_, const IsochroneParameters &parameters_)
+        : BaseAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    void MakeResponse(const PhantomNode &source,
+                      const std::vector<IsochroneSegment> &segments,
+                      const std::vector<util::Coordinate> &polygon,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(parameters.coordinates.size() == 1);
+
+        util::json::Array waypoints;
+        waypoints.values.push_back(MakeWaypoint(source));
+
+        switch (parameters.output)
+        {
+        case IsochroneParameters::OutputType::Segments:
+            response.values["segments"] = MakeSegments(segments);
+            break;
+        case IsochroneParameters::OutputType::Polygon:
+            response.values["polygon"] = MakePolygon(polygon);
+            break;
+        }
+
+        response.values["code"] = "Ok";
+        response.values["waypoints"] = std::move(waypoints);
+    }
+
+  protected:
+    util::json::Array MakeSegments(const std::vector<IsochroneSegment> &segments) const
+    {
+        util::json::Array json_segments;
+        json_segments.values.resize(segments.size());
+        std::transform(segments.begin(),
+                       segments.end(),
+                       json_segments.values.begin(),
+                       [](const IsochroneSegment &segment) {
+                           const util::Coordinate locations[] = {segment.from, segment.to};
+                           util::json::Object json_segment;
+                           json_segment.values["geometry"] = json::makeGeoJSONGeometry(
+                               std::begin(locations), std::end(locations));
+                           json_segment.values["duration"] =
+                               std::max(segment.from_weight, 0) / 10.;
+                           return json_segment;
+                       });
+        return json_segments;
+    }
+
+    // GeoJSON polygon with a single closed ring
+    util::json::Object MakePolygon(const std::vector<util::Coordinate> &polygon) const
+    {
+        util::json::Array ring;
+        ring.values.reserve(polygon.size() + 1);
+        std::transform(polygon.begin(),
+                       polygon.end(),
+                       std::back_inserter(ring.values),
+                       &json::detail::coordinateToLonLat);
+        if (!polygon.empty())
+        {
+            ring.values.push_back(json::detail::coordinateToLonLat(polygon.front()));
+        }
+
+        util::json::Array rings;
+        rings.values.push_back(std::move(ring));
+
+        util::json::Object geojson;
+        geojson.values["type"] = "Polygon";
+        geojson.values["coordinates"] = std::move(rings);
+        return geojson;
+    }
+
+    const IsochroneParameters &parameters;
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
@@ -11,6 +11,10 @@
 
 #include "util/integer_range.hpp"
 
+#include <protozero/pbf_writer.hpp>
+
+#include <string>
+
 namespace osrm
 {
 namespace engine
@@ -48,34 +52,117 @@ class MatchAPI final : public RouteAPI
         response.values["code"] = "Ok";
     }
 
-  protected:
-    // FIXME this logic is a little backwards. We should change the output format of the
-    // map_matching
-    // routing algorithm to be easier to consume here.
-    util::json::Array
-    MakeTracepoints(const std::vector<map_matching::SubMatching> &sub_matchings) const
+    // Streaming version of the response above. Tracepoints are written directly, every matching
+    // is built as json::Object and written before the next one is assembled.
+    void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      util::json::Writer &writer) const
     {
-        util::json::Array waypoints;
-        waypoints.values.reserve(parameters.coordinates.size());
+        BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
 
-        struct MatchingIndex
+        writer.StartObject();
+        writer.WriteKey("code");
+        writer.WriteString("Ok");
+
+        writer.WriteKey("tracepoints");
+        writer.StartArray();
+        for (const auto &matching_index : MakeMatchingIndices(sub_matchings))
         {
-            MatchingIndex() = default;
-            MatchingIndex(unsigned sub_matching_index_, unsigned point_index_)
-                : sub_matching_index(sub_matching_index_), point_index(point_index_)
+            if (matching_index.NotMatched())
             {
+                writer.WriteNull();
+                continue;
             }
+            const auto &phantom =
+                sub_matchings[matching_index.sub_matching_index].nodes[matching_index.point_index];
+            writer.StartObject();
+            BaseAPI::WriteWaypointMembers(writer, phantom);
+            writer.WriteKey("matchings_index");
+            writer.WriteNumber(matching_index.sub_matching_index);
+            writer.WriteKey("waypoint_index");
+            writer.WriteNumber(matching_index.point_index);
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.WriteKey("matchings");
+        writer.StartArray();
+        for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            auto route = MakeRoute(sub_routes[index].segment_end_coordinates,
+                                   sub_routes[index].unpacked_path_segments,
+                                   sub_routes[index].source_traversed_in_reverse,
+                                   sub_routes[index].target_traversed_in_reverse);
+            route.values["confidence"] = sub_matchings[index].confidence;
+            writer.WriteValue(std::move(route));
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+    // Protobuf version of the response above
+    void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      std::string &buffer) const
+    {
+        BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
 
-            unsigned sub_matching_index = std::numeric_limits<unsigned>::max();
-            unsigned point_index = std::numeric_limits<unsigned>::max();
+        protozero::pbf_writer response(buffer);
+        response.add_string(pbf::RESPONSE_CODE_TAG, "Ok");
 
-            bool NotMatched()
+        for (const auto &matching_index : MakeMatchingIndices(sub_matchings))
+        {
+            protozero::pbf_writer tracepoint(response, pbf::RESPONSE_TRACEPOINTS_TAG);
+            if (matching_index.NotMatched())
             {
-                return sub_matching_index == std::numeric_limits<unsigned>::max() &&
-                       point_index == std::numeric_limits<unsigned>::max();
+                continue;
             }
-        };
+            const auto &phantom =
+                sub_matchings[matching_index.sub_matching_index].nodes[matching_index.point_index];
+            BaseAPI::WriteWaypointMembers(tracepoint, phantom);
+            tracepoint.add_uint32(pbf::WAYPOINT_MATCHINGS_INDEX_TAG,
+                                  matching_index.sub_matching_index);
+            tracepoint.add_uint32(pbf::WAYPOINT_WAYPOINT_INDEX_TAG, matching_index.point_index);
+        }
 
+        for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            protozero::pbf_writer route_writer(response, pbf::RESPONSE_MATCHINGS_TAG);
+            WriteRoute(route_writer,
+                       sub_routes[index].segment_end_coordinates,
+                       sub_routes[index].unpacked_path_segments,
+                       sub_routes[index].source_traversed_in_reverse,
+                       sub_routes[index].target_traversed_in_reverse);
+            route_writer.add_double(pbf::ROUTE_CONFIDENCE_TAG, sub_matchings[index].confidence);
+        }
+    }
+
+  protected:
+    struct MatchingIndex
+    {
+        MatchingIndex() = default;
+        MatchingIndex(unsigned sub_matching_index_, unsigned point_index_)
+            : sub_matching_index(sub_matching_index_), point_index(point_index_)
+        {
+        }
+
+        unsigned sub_matching_index = std::numeric_limits<unsigned>::max();
+        unsigned point_index = std::numeric_limits<unsigned>::max();
+
+        bool NotMatched() const
+        {
+            return sub_matching_index == std::numeric_limits<unsigned>::max() &&
+                   point_index == std::numeric_limits<unsigned>::max();
+        }
+    };
+
+    // FIXME this logic is a little backwards. We should change the output format of the
+    // map_matching
+    // routing algorithm to be easier to consume here.
+    std::vector<MatchingIndex>
+    MakeMatchingIndices(const std::vector<map_matching::SubMatching> &sub_matchings) const
+    {
         std::vector<MatchingIndex> trace_idx_to_matching_idx(parameters.coordinates.size());
         for (auto sub_matching_index :
              util::irange(0u, static_cast<unsigned>(sub_matchings.size())))
@@ -87,10 +174,17 @@ class MatchAPI final : public RouteAPI
                     MatchingIndex{sub_matching_index, point_index};
             }
         }
+        return trace_idx_to_matching_idx;
+    }
+
+    util::json::Array
+    MakeTracepoints(const std::vector<map_matching::SubMatching> &sub_matchings) const
+    {
+        util::json::Array waypoints;
+        waypoints.values.reserve(parameters.coordinates.size());
 
-        for (auto trace_index : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        for (const auto &matching_index : MakeMatchingIndices(sub_matchings))
         {
-            auto matching_index = trace_idx_to_matching_idx[trace_index];
             if (matching_index.NotMatched())
             {
                 waypoints.values.push_back(util::json::Null());
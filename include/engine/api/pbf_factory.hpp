@@ -0,0 +1,99 @@
+#ifndef ENGINE_API_PBF_FACTORY_HPP
+#define ENGINE_API_PBF_FACTORY_HPP
+
+#include "util/coordinate.hpp"
+
+#include <protozero/pbf_writer.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+namespace pbf
+{
+
+// Field numbers of the protobuf encoded responses (format=pbf), see docs/http.md for the schema.
+
+// message Response
+const constexpr std::uint32_t RESPONSE_CODE_TAG = 1;
+const constexpr std::uint32_t RESPONSE_MESSAGE_TAG = 2;
+const constexpr std::uint32_t RESPONSE_WAYPOINTS_TAG = 3;
+const constexpr std::uint32_t RESPONSE_ROUTES_TAG = 4;
+const constexpr std::uint32_t RESPONSE_SOURCES_TAG = 5;
+const constexpr std::uint32_t RESPONSE_DESTINATIONS_TAG = 6;
+const constexpr std::uint32_t RESPONSE_DURATIONS_TAG = 7;
+const constexpr std::uint32_t RESPONSE_TRACEPOINTS_TAG = 8;
+const constexpr std::uint32_t RESPONSE_MATCHINGS_TAG = 9;
+
+// message Waypoint, unmatched tracepoints are empty messages
+const constexpr std::uint32_t WAYPOINT_HINT_TAG = 1;
+const constexpr std::uint32_t WAYPOINT_NAME_TAG = 2;
+const constexpr std::uint32_t WAYPOINT_LOCATION_TAG = 3;
+const constexpr std::uint32_t WAYPOINT_MATCHINGS_INDEX_TAG = 4;
+const constexpr std::uint32_t WAYPOINT_WAYPOINT_INDEX_TAG = 5;
+
+// message Route
+const constexpr std::uint32_t ROUTE_DISTANCE_TAG = 1;
+const constexpr std::uint32_t ROUTE_DURATION_TAG = 2;
+const constexpr std::uint32_t ROUTE_GEOMETRY_TAG = 3;
+const constexpr std::uint32_t ROUTE_LEGS_TAG = 4;
+const constexpr std::uint32_t ROUTE_CONFIDENCE_TAG = 5;
+
+// message RouteLeg
+const constexpr std::uint32_t LEG_DISTANCE_TAG = 1;
+const constexpr std::uint32_t LEG_DURATION_TAG = 2;
+
+// Durations of the table are packed row by row in deciseconds, this marks missing routes
+const constexpr std::int32_t NO_DURATION = -1;
+
+// Writes the location as packed [longitude, latitude] pair in fixed point (1e-6 degree)
+inline void writeLocation(protozero::pbf_writer &writer,
+                          const std::uint32_t tag,
+                          const util::Coordinate location)
+{
+    protozero::packed_field_sint32 packed(writer, tag);
+    packed.add_element(static_cast<std::int32_t>(location.lon));
+    packed.add_element(static_cast<std::int32_t>(location.lat));
+}
+
+// Writes the coordinates as packed [longitude, latitude] pairs in fixed point (1e-6 degree).
+// Every pair but the first is stored as difference to its predecessor, which keeps the zigzag
+// encoded varints small.
+template <typename ForwardIter>
+void writeGeometry(protozero::pbf_writer &writer,
+                   const std::uint32_t tag,
+                   ForwardIter begin,
+                   ForwardIter end)
+{
+    protozero::packed_field_sint32 packed(writer, tag);
+    std::int32_t last_lon = 0;
+    std::int32_t last_lat = 0;
+    for (auto iter = begin; iter != end; ++iter)
+    {
+        const auto lon = static_cast<std::int32_t>(iter->lon);
+        const auto lat = static_cast<std::int32_t>(iter->lat);
+        packed.add_element(lon - last_lon);
+        packed.add_element(lat - last_lat);
+        last_lon = lon;
+        last_lat = lat;
+    }
+}
+
+inline void writeError(std::string &buffer, const std::string &code, const std::string &message)
+{
+    buffer.clear();
+    protozero::pbf_writer response(buffer);
+    response.add_string(RESPONSE_CODE_TAG, code);
+    response.add_string(RESPONSE_MESSAGE_TAG, message);
+}
+}
+}
+}
+}
+
+#endif // ENGINE_API_PBF_FACTORY_HPP
@@ -3,6 +3,7 @@
 
 #include "engine/api/base_api.hpp"
 #include "engine/api/json_factory.hpp"
+#include "engine/api/pbf_factory.hpp"
 #include "engine/api/route_parameters.hpp"
 
 #include "engine/datafacade/datafacade_base.hpp"
@@ -20,7 +21,11 @@
 #include "util/coordinate.hpp"
 #include "util/integer_range.hpp"
 
+#include <protozero/pbf_writer.hpp>
+
+#include <cmath>
 #include <iterator>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -61,6 +66,42 @@ class RouteAPI : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    // Protobuf version of the response above
+    void MakeResponse(const InternalRouteResult &raw_route, std::string &buffer) const
+    {
+        protozero::pbf_writer response(buffer);
+        response.add_string(pbf::RESPONSE_CODE_TAG, "Ok");
+
+        BOOST_ASSERT(!raw_route.segment_end_coordinates.empty());
+        BaseAPI::WriteWaypoint(response,
+                               pbf::RESPONSE_WAYPOINTS_TAG,
+                               raw_route.segment_end_coordinates.front().source_phantom);
+        for (const auto &phantoms : raw_route.segment_end_coordinates)
+        {
+            BaseAPI::WriteWaypoint(response, pbf::RESPONSE_WAYPOINTS_TAG, phantoms.target_phantom);
+        }
+
+        {
+            protozero::pbf_writer route_writer(response, pbf::RESPONSE_ROUTES_TAG);
+            WriteRoute(route_writer,
+                       raw_route.segment_end_coordinates,
+                       raw_route.unpacked_path_segments,
+                       raw_route.source_traversed_in_reverse,
+                       raw_route.target_traversed_in_reverse);
+        }
+        if (raw_route.has_alternative())
+        {
+            std::vector<std::vector<PathData>> wrapped_leg(1);
+            wrapped_leg.front() = raw_route.unpacked_alternative;
+            protozero::pbf_writer route_writer(response, pbf::RESPONSE_ROUTES_TAG);
+            WriteRoute(route_writer,
+                       raw_route.segment_end_coordinates,
+                       wrapped_leg,
+                       raw_route.alt_source_traversed_in_reverse,
+                       raw_route.alt_target_traversed_in_reverse);
+        }
+    }
+
   protected:
     template <typename ForwardIter>
     util::json::Value MakeGeometry(ForwardIter begin, ForwardIter end) const
@@ -79,13 +120,15 @@ class RouteAPI : public BaseAPI
         return json::makeGeoJSONGeometry(begin, end);
     }
 
-    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
-                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
-                                 const std::vector<bool> &source_traversed_in_reverse,
-                                 const std::vector<bool> &target_traversed_in_reverse) const
+    // Assembles the legs of a route and their geometries, including the post-processed steps
+    // if they were requested
+    void MakeLegs(const std::vector<PhantomNodes> &segment_end_coordinates,
+                  const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                  const std::vector<bool> &source_traversed_in_reverse,
+                  const std::vector<bool> &target_traversed_in_reverse,
+                  std::vector<guidance::RouteLeg> &legs,
+                  std::vector<guidance::LegGeometry> &leg_geometries) const
     {
-        std::vector<guidance::RouteLeg> legs;
-        std::vector<guidance::LegGeometry> leg_geometries;
         auto number_of_legs = segment_end_coordinates.size();
         legs.reserve(number_of_legs);
         leg_geometries.reserve(number_of_legs);
@@ -166,6 +209,21 @@ class RouteAPI : public BaseAPI
             leg_geometries.push_back(std::move(leg_geometry));
             legs.push_back(std::move(leg));
         }
+    }
+
+    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
+                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                                 const std::vector<bool> &source_traversed_in_reverse,
+                                 const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        MakeLegs(segment_end_coordinates,
+                 unpacked_path_segments,
+                 source_traversed_in_reverse,
+                 target_traversed_in_reverse,
+                 legs,
+                 leg_geometries);
 
         auto route = guidance::assembleRoute(legs);
         boost::optional<util::json::Value> json_overview;
@@ -261,6 +319,47 @@ class RouteAPI : public BaseAPI
         return result;
     }
 
+    // Protobuf version of MakeRoute, writes the members of a Route message. Steps and
+    // annotations are not part of the protobuf format, the overview geometry is always
+    // written as packed coordinates.
+    void WriteRoute(protozero::pbf_writer &route_writer,
+                    const std::vector<PhantomNodes> &segment_end_coordinates,
+                    const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                    const std::vector<bool> &source_traversed_in_reverse,
+                    const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        BOOST_ASSERT(!parameters.steps && !parameters.annotations);
+
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        MakeLegs(segment_end_coordinates,
+                 unpacked_path_segments,
+                 source_traversed_in_reverse,
+                 target_traversed_in_reverse,
+                 legs,
+                 leg_geometries);
+
+        const auto route = guidance::assembleRoute(legs);
+        route_writer.add_double(pbf::ROUTE_DISTANCE_TAG, std::round(route.distance * 10) / 10.);
+        route_writer.add_double(pbf::ROUTE_DURATION_TAG, std::round(route.duration * 10) / 10.);
+
+        if (parameters.overview != RouteParameters::OverviewType::False)
+        {
+            const auto use_simplification =
+                parameters.overview == RouteParameters::OverviewType::Simplified;
+            const auto overview = guidance::assembleOverview(leg_geometries, use_simplification);
+            pbf::writeGeometry(
+                route_writer, pbf::ROUTE_GEOMETRY_TAG, overview.begin(), overview.end());
+        }
+
+        for (const auto &leg : legs)
+        {
+            protozero::pbf_writer leg_writer(route_writer, pbf::ROUTE_LEGS_TAG);
+            leg_writer.add_double(pbf::LEG_DISTANCE_TAG, std::round(leg.distance * 10) / 10.);
+            leg_writer.add_double(pbf::LEG_DURATION_TAG, std::round(leg.duration * 10) / 10.);
+        }
+    }
+
     const RouteParameters &parameters;
 };
 
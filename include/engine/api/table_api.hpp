@@ -3,6 +3,7 @@
 
 #include "engine/api/base_api.hpp"
 #include "engine/api/json_factory.hpp"
+#include "engine/api/pbf_factory.hpp"
 #include "engine/api/table_parameters.hpp"
 
 #include "engine/datafacade/datafacade_base.hpp"
@@ -19,7 +20,11 @@
 
 #include <boost/range/algorithm/transform.hpp>
 
+#include <protozero/pbf_writer.hpp>
+
+#include <cstdint>
 #include <iterator>
+#include <string>
 
 namespace osrm
 {
@@ -70,6 +75,46 @@ class TableAPI final : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    // Streaming version of the response above, writes the durations row by row without
+    // building an intermediate json::Object
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<PhantomNode> &phantoms,
+                              util::json::Writer &writer) const
+    {
+        const auto number_of_sources =
+            parameters.sources.empty() ? phantoms.size() : parameters.sources.size();
+        const auto number_of_destinations =
+            parameters.destinations.empty() ? phantoms.size() : parameters.destinations.size();
+
+        writer.StartObject();
+        writer.WriteKey("code");
+        writer.WriteString("Ok");
+        writer.WriteKey("sources");
+        WriteWaypoints(writer, phantoms, parameters.sources);
+        writer.WriteKey("destinations");
+        WriteWaypoints(writer, phantoms, parameters.destinations);
+        writer.WriteKey("durations");
+        WriteTable(writer, durations, number_of_sources, number_of_destinations);
+        writer.EndObject();
+    }
+
+    // Protobuf version of the response above, the durations are a single packed array
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<PhantomNode> &phantoms,
+                              std::string &buffer) const
+    {
+        protozero::pbf_writer response(buffer);
+        response.add_string(pbf::RESPONSE_CODE_TAG, "Ok");
+        WriteWaypoints(response, pbf::RESPONSE_SOURCES_TAG, phantoms, parameters.sources);
+        WriteWaypoints(
+            response, pbf::RESPONSE_DESTINATIONS_TAG, phantoms, parameters.destinations);
+        protozero::packed_field_sint32 packed(response, pbf::RESPONSE_DURATIONS_TAG);
+        for (const auto duration : durations)
+        {
+            packed.add_element(duration == INVALID_EDGE_WEIGHT ? pbf::NO_DURATION : duration);
+        }
+    }
+
   protected:
     virtual util::json::Array MakeWaypoints(const std::vector<PhantomNode> &phantoms) const
     {
@@ -124,6 +169,82 @@ class TableAPI final : public BaseAPI
         return json_table;
     }
 
+    // Writes the waypoints of the given indices, or of all phantoms if indices is empty
+    virtual void WriteWaypoints(util::json::Writer &writer,
+                                const std::vector<PhantomNode> &phantoms,
+                                const std::vector<std::size_t> &indices) const
+    {
+        writer.StartArray();
+        if (indices.empty())
+        {
+            BOOST_ASSERT(phantoms.size() == parameters.coordinates.size());
+            for (const auto &phantom : phantoms)
+            {
+                BaseAPI::WriteWaypoint(writer, phantom);
+            }
+        }
+        else
+        {
+            for (const auto idx : indices)
+            {
+                BOOST_ASSERT(idx < phantoms.size());
+                BaseAPI::WriteWaypoint(writer, phantoms[idx]);
+            }
+        }
+        writer.EndArray();
+    }
+
+    virtual void WriteTable(util::json::Writer &writer,
+                            const std::vector<EdgeWeight> &values,
+                            std::size_t number_of_rows,
+                            std::size_t number_of_columns) const
+    {
+        BOOST_ASSERT(values.size() == number_of_rows * number_of_columns);
+        writer.StartArray();
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            writer.StartArray();
+            const auto row_begin_iterator = values.begin() + (row * number_of_columns);
+            const auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
+            for (auto iterator = row_begin_iterator; iterator != row_end_iterator; ++iterator)
+            {
+                if (*iterator == INVALID_EDGE_WEIGHT)
+                {
+                    writer.WriteNull();
+                }
+                else
+                {
+                    writer.WriteNumber(*iterator / 10.);
+                }
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+    }
+
+    virtual void WriteWaypoints(protozero::pbf_writer &writer,
+                                const std::uint32_t tag,
+                                const std::vector<PhantomNode> &phantoms,
+                                const std::vector<std::size_t> &indices) const
+    {
+        if (indices.empty())
+        {
+            BOOST_ASSERT(phantoms.size() == parameters.coordinates.size());
+            for (const auto &phantom : phantoms)
+            {
+                BaseAPI::WriteWaypoint(writer, tag, phantom);
+            }
+        }
+        else
+        {
+            for (const auto idx : indices)
+            {
+                BOOST_ASSERT(idx < phantoms.size());
+                BaseAPI::WriteWaypoint(writer, tag, phantoms[idx]);
+            }
+        }
+    }
+
     const TableParameters &parameters;
 };
 
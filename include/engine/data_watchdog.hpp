@@ -12,6 +12,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include <cstddef>
 #include <memory>
 
 namespace osrm
@@ -25,10 +26,13 @@ namespace engine
 class DataWatchdog
 {
   public:
-    DataWatchdog()
-        : shared_barriers{std::make_shared<storage::SharedBarriers>()},
+    // snapping_cache_size: memory budget in bytes of the snapping cache of each facade
+    // warm_up: fault in the r-tree leaves of each new facade before it is used
+    DataWatchdog(const std::size_t snapping_cache_size, const bool warm_up)
+        : snapping_cache_size(snapping_cache_size), warm_up(warm_up),
+          shared_barriers{std::make_shared<storage::SharedBarriers>()},
           shared_regions(storage::makeSharedMemory(storage::CURRENT_REGION)),
-          current_timestamp{storage::REGION_NONE, 0}
+          current_timestamp{storage::REGION_NONE, storage::REGION_NONE, 0}
     {
     }
 
@@ -38,8 +42,10 @@ class DataWatchdog
         return storage::SharedMemory::RegionExists(storage::CURRENT_REGION);
     }
 
-    using RegionsLock =
+    using RegionLock =
         boost::interprocess::sharable_lock<boost::interprocess::named_sharable_mutex>;
+    // locks of the data region and of the weights region, the latter might not be locked
+    using RegionsLock = std::pair<RegionLock, RegionLock>;
     using LockAndFacade = std::pair<RegionsLock, std::shared_ptr<datafacade::BaseDataFacade>>;
 
     // This will either update the contens of facade or just leave it as is
@@ -54,15 +60,17 @@ class DataWatchdog
 
         const auto get_locked_facade = [this, shared_timestamp](
             const std::shared_ptr<datafacade::SharedMemoryDataFacade> &facade) {
-            if (current_timestamp.region == storage::REGION_1)
+            BOOST_ASSERT(current_timestamp.region == storage::REGION_1 ||
+                         current_timestamp.region == storage::REGION_2);
+            RegionLock data_lock(shared_barriers->GetRegionMutex(current_timestamp.region));
+            RegionLock weights_lock;
+            if (current_timestamp.weights_region != storage::REGION_NONE)
             {
-                return std::make_pair(RegionsLock(shared_barriers->region_1_mutex), facade);
-            }
-            else
-            {
-                BOOST_ASSERT(current_timestamp.region == storage::REGION_2);
-                return std::make_pair(RegionsLock(shared_barriers->region_2_mutex), facade);
+                weights_lock =
+                    RegionLock(shared_barriers->GetRegionMutex(current_timestamp.weights_region));
             }
+            return std::make_pair(std::make_pair(std::move(data_lock), std::move(weights_lock)),
+                                  facade);
         };
 
         // this blocks handle the common case when there is no data update -> we will only need a
@@ -116,14 +124,25 @@ class DataWatchdog
             current_timestamp = *shared_timestamp;
         }
 
-        auto new_facade = std::make_shared<datafacade::SharedMemoryDataFacade>(
-            shared_barriers, current_timestamp.region, current_timestamp.timestamp);
+        auto new_facade =
+            std::make_shared<datafacade::SharedMemoryDataFacade>(shared_barriers,
+                                                                 current_timestamp.region,
+                                                                 current_timestamp.weights_region,
+                                                                 current_timestamp.timestamp);
+        new_facade->InitializeSnappingCache(snapping_cache_size);
+        if (warm_up)
+        {
+            new_facade->WarmUp();
+        }
         cached_facade = new_facade;
 
         return get_locked_facade(new_facade);
     }
 
   private:
+    const std::size_t snapping_cache_size;
+    const bool warm_up;
+
     // mutexes should be mutable even on const objects: This enables
     // marking functions as logical const and thread-safe.
     std::shared_ptr<storage::SharedBarriers> shared_barriers;
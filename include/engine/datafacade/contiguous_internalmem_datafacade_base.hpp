@@ -2,6 +2,7 @@
 #define CONTIGUOUS_INTERNALMEM_DATAFACADE_HPP
 
 #include "engine/datafacade/datafacade_base.hpp"
+#include "engine/datafacade/snapping_cache.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
@@ -22,6 +23,7 @@
 #include "util/rectangle.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
+#include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
@@ -45,6 +47,9 @@ namespace engine
 namespace datafacade
 {
 
+// Datasource of all segments if the weights were not updated from external sources
+const DatasourceID BASE_DATASOURCE = 0;
+
 /**
  * This base class implements the Datafacade interface for accessing
  * data that's stored in a single large block of memory (RAM).
@@ -66,6 +71,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
     using SharedGeospatialQuery = GeospatialQuery<SharedRTree, BaseDataFacade>;
     using RTreeNode = SharedRTree::TreeNode;
+    using RTreeLeafNode = SharedRTree::LeafNode;
 
     unsigned m_check_sum;
     std::unique_ptr<QueryGraph> m_query_graph;
@@ -88,6 +94,9 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     util::ShM<EdgeWeight, true>::vector m_geometry_fwd_weight_list;
     util::ShM<EdgeWeight, true>::vector m_geometry_rev_weight_list;
     util::ShM<bool, true>::vector m_is_core_node;
+    util::ShM<contractor::SweepNode, true>::vector m_sweep_node_list;
+    util::ShM<NodeID, true>::vector m_sweep_position_list;
+    util::ShM<contractor::SweepEdge, true>::vector m_sweep_edge_list;
     util::ShM<uint8_t, true>::vector m_datasource_list;
     util::ShM<std::uint32_t, true>::vector m_lane_description_offsets;
     util::ShM<extractor::guidance::TurnLaneType::Mask, true>::vector m_lane_description_masks;
@@ -99,6 +108,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     std::unique_ptr<SharedRTree> m_static_rtree;
     std::unique_ptr<SharedGeospatialQuery> m_geospatial_query;
+    std::unique_ptr<SnappingCache> m_snapping_cache;
     boost::filesystem::path file_index_path;
 
     std::shared_ptr<util::RangeTable<16, true>> m_name_table;
@@ -145,20 +155,32 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const auto file_index_ptr =
             data_layout.GetBlockPtr<char>(memory_block, storage::DataLayout::FILE_INDEX_PATH);
         file_index_path = boost::filesystem::path(file_index_ptr);
-        if (!boost::filesystem::exists(file_index_path))
-        {
-            util::Log(logDEBUG) << "Leaf file name " << file_index_path.string();
-            throw util::exception("Could not load " + file_index_path.string() +
-                                  "Is any data loaded into shared memory?" + SOURCE_REF);
-        }
 
         auto tree_ptr =
             data_layout.GetBlockPtr<RTreeNode>(memory_block, storage::DataLayout::R_SEARCH_TREE);
-        m_static_rtree.reset(
-            new SharedRTree(tree_ptr,
-                            data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE],
-                            file_index_path,
-                            m_coordinate_list));
+        const auto tree_size = data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE];
+
+        // the leaves are either part of the memory block or mapped from the leaf file
+        const auto number_of_leaves = data_layout.num_entries[storage::DataLayout::R_SEARCH_LEAVES];
+        if (number_of_leaves > 0)
+        {
+            auto leaves_ptr = data_layout.GetBlockPtr<RTreeLeafNode>(
+                memory_block, storage::DataLayout::R_SEARCH_LEAVES);
+            m_static_rtree.reset(new SharedRTree(
+                tree_ptr, tree_size, leaves_ptr, number_of_leaves, m_coordinate_list));
+        }
+        else
+        {
+            if (!boost::filesystem::exists(file_index_path))
+            {
+                util::Log(logDEBUG) << "Leaf file name " << file_index_path.string();
+                throw util::exception("Could not load " + file_index_path.string() +
+                                      "Is any data loaded into shared memory?" + SOURCE_REF);
+            }
+
+            m_static_rtree.reset(
+                new SharedRTree(tree_ptr, tree_size, file_index_path, m_coordinate_list));
+        }
         m_geospatial_query.reset(
             new SharedGeospatialQuery(*m_static_rtree, m_coordinate_list, *this));
     }
@@ -178,6 +200,25 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         m_query_graph.reset(new QueryGraph(node_list, edge_list));
     }
 
+    void InitializeSweepPointers(storage::DataLayout &data_layout, char *memory_block)
+    {
+        auto sweep_nodes_ptr = data_layout.GetBlockPtr<contractor::SweepNode>(
+            memory_block, storage::DataLayout::GRAPH_SWEEP_NODE_LIST);
+        m_sweep_node_list.reset(
+            sweep_nodes_ptr, data_layout.num_entries[storage::DataLayout::GRAPH_SWEEP_NODE_LIST]);
+
+        auto sweep_positions_ptr = data_layout.GetBlockPtr<NodeID>(
+            memory_block, storage::DataLayout::GRAPH_SWEEP_POSITION_LIST);
+        m_sweep_position_list.reset(
+            sweep_positions_ptr,
+            data_layout.num_entries[storage::DataLayout::GRAPH_SWEEP_POSITION_LIST]);
+
+        auto sweep_edges_ptr = data_layout.GetBlockPtr<contractor::SweepEdge>(
+            memory_block, storage::DataLayout::GRAPH_SWEEP_EDGE_LIST);
+        m_sweep_edge_list.reset(
+            sweep_edges_ptr, data_layout.num_entries[storage::DataLayout::GRAPH_SWEEP_EDGE_LIST]);
+    }
+
     void InitializeNodeAndEdgeInformationPointers(storage::DataLayout &data_layout,
                                                   char *memory_block)
     {
@@ -322,6 +363,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             data_layout.num_entries[storage::DataLayout::GEOMETRIES_NODE_LIST]);
         m_geometry_node_list = std::move(geometry_node_list);
 
+        InitializeGeometryWeightPointers(data_layout, memory_block);
+    }
+
+    void InitializeGeometryWeightPointers(storage::DataLayout &data_layout, char *memory_block)
+    {
         auto geometries_fwd_weight_list_ptr = data_layout.GetBlockPtr<EdgeWeight>(
             memory_block, storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
         util::ShM<EdgeWeight, true>::vector geometry_fwd_weight_list(
@@ -401,6 +447,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
     {
         InitializeGraphPointer(data_layout, memory_block);
+        InitializeSweepPointers(data_layout, memory_block);
         InitializeChecksumPointer(data_layout, memory_block);
         InitializeNodeAndEdgeInformationPointers(data_layout, memory_block);
         InitializeGeometryPointers(data_layout, memory_block);
@@ -414,6 +461,42 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         InitializeIntersectionClassPointers(data_layout, memory_block);
     }
 
+    // Replaces all weight blocks with the ones of a weight update, see
+    // storage::DataLayout::IsWeightBlock
+    void InitializeWeightPointers(storage::DataLayout &data_layout, char *memory_block)
+    {
+        InitializeGraphPointer(data_layout, memory_block);
+        InitializeSweepPointers(data_layout, memory_block);
+        InitializeChecksumPointer(data_layout, memory_block);
+        InitializeCoreInformationPointer(data_layout, memory_block);
+        InitializeGeometryWeightPointers(data_layout, memory_block);
+    }
+
+    // Caches the phantom nodes of repeatedly snapped coordinates in about memory_budget bytes,
+    // zero disables the cache. Has to be called before the facade is shared between threads.
+    void InitializeSnappingCache(const std::size_t memory_budget)
+    {
+        if (memory_budget > 0)
+        {
+            m_snapping_cache = std::make_unique<SnappingCache>(memory_budget);
+        }
+        else
+        {
+            m_snapping_cache.reset();
+        }
+    }
+
+    // Faults in the r-tree leaves so that the first queries on this facade do not stall on
+    // cold pages. Has to be called before the facade is shared between threads.
+    void WarmUp() const
+    {
+        TIMER_START(warm_up);
+        const auto number_of_segments = m_static_rtree->WarmUp();
+        TIMER_STOP(warm_up);
+        util::Log() << "Warmed up r-tree leaves with " << number_of_segments << " segments in "
+                    << TIMER_MSEC(warm_up) << "ms";
+    }
+
     // search graph access
     unsigned GetNumberOfNodes() const override final { return m_query_graph->GetNumberOfNodes(); }
 
@@ -464,6 +547,28 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return m_query_graph->FindSmallestEdge(from, to, filter);
     }
 
+    bool HasDownwardSweep() const override final
+    {
+        return !m_sweep_position_list.empty() &&
+               m_sweep_position_list.size() == m_query_graph->GetNumberOfNodes();
+    }
+
+    NodeID GetSweepPosition(const NodeID node) const override final
+    {
+        return m_sweep_position_list[node];
+    }
+
+    EdgeRange GetSweepEdgeRange(const NodeID position) const override final
+    {
+        return util::irange(m_sweep_node_list[position].first_edge,
+                            m_sweep_node_list[position + 1].first_edge);
+    }
+
+    const contractor::SweepEdge &GetSweepEdge(const EdgeID edge) const override final
+    {
+        return m_sweep_edge_list[edge];
+    }
+
     // node and edge information access
     util::Coordinate GetCoordinateOfNode(const NodeID id) const override final
     {
@@ -476,6 +581,28 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     }
 
     virtual std::vector<NodeID> GetUncompressedForwardGeometry(const EdgeID id) const override final
+    {
+        return util::toVector(GetUncompressedForwardGeometryRange(id));
+    }
+
+    virtual std::vector<NodeID> GetUncompressedReverseGeometry(const EdgeID id) const override final
+    {
+        return util::toVector(GetUncompressedReverseGeometryRange(id));
+    }
+
+    virtual std::vector<EdgeWeight>
+    GetUncompressedForwardWeights(const EdgeID id) const override final
+    {
+        return util::toVector(GetUncompressedForwardWeightsRange(id));
+    }
+
+    virtual std::vector<EdgeWeight>
+    GetUncompressedReverseWeights(const EdgeID id) const override final
+    {
+        return util::toVector(GetUncompressedReverseWeightsRange(id));
+    }
+
+    virtual GeometryRange GetUncompressedForwardGeometryRange(const EdgeID id) const override final
     {
         /*
          * NodeID's for geometries are stored in one place for
@@ -489,18 +616,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const unsigned begin = m_geometry_indices.at(id);
         const unsigned end = m_geometry_indices.at(id + 1);
 
-        std::vector<NodeID> result_nodes;
-
-        result_nodes.resize(end - begin);
-
-        std::copy(m_geometry_node_list.begin() + begin,
-                  m_geometry_node_list.begin() + end,
-                  result_nodes.begin());
-
-        return result_nodes;
+        const auto first = &m_geometry_node_list.at(begin);
+        return util::makeForwardRange(first, first + (end - begin));
     }
 
-    virtual std::vector<NodeID> GetUncompressedReverseGeometry(const EdgeID id) const override final
+    virtual GeometryRange GetUncompressedReverseGeometryRange(const EdgeID id) const override final
     {
         /*
          * NodeID's for geometries are stored in one place for
@@ -512,19 +632,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const unsigned begin = m_geometry_indices.at(id);
         const unsigned end = m_geometry_indices.at(id + 1);
 
-        std::vector<NodeID> result_nodes;
-
-        result_nodes.resize(end - begin);
-
-        std::copy(m_geometry_node_list.rbegin() + (m_geometry_node_list.size() - end),
-                  m_geometry_node_list.rbegin() + (m_geometry_node_list.size() - begin),
-                  result_nodes.begin());
-
-        return result_nodes;
+        const auto first = &m_geometry_node_list.at(begin);
+        return util::makeReverseRange(first, first + (end - begin));
     }
 
-    virtual std::vector<EdgeWeight>
-    GetUncompressedForwardWeights(const EdgeID id) const override final
+    virtual WeightRange GetUncompressedForwardWeightsRange(const EdgeID id) const override final
     {
         /*
          * EdgeWeights's for geometries are stored in one place for
@@ -536,18 +648,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const unsigned begin = m_geometry_indices.at(id) + 1;
         const unsigned end = m_geometry_indices.at(id + 1);
 
-        std::vector<EdgeWeight> result_weights;
-        result_weights.resize(end - begin);
-
-        std::copy(m_geometry_fwd_weight_list.begin() + begin,
-                  m_geometry_fwd_weight_list.begin() + end,
-                  result_weights.begin());
-
-        return result_weights;
+        const auto first = &m_geometry_fwd_weight_list.at(begin);
+        return util::makeForwardRange(first, first + (end - begin));
     }
 
-    virtual std::vector<EdgeWeight>
-    GetUncompressedReverseWeights(const EdgeID id) const override final
+    virtual WeightRange GetUncompressedReverseWeightsRange(const EdgeID id) const override final
     {
         /*
          * EdgeWeights for geometries are stored in one place for
@@ -561,14 +666,8 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const unsigned begin = m_geometry_indices.at(id);
         const unsigned end = m_geometry_indices.at(id + 1) - 1;
 
-        std::vector<EdgeWeight> result_weights;
-        result_weights.resize(end - begin);
-
-        std::copy(m_geometry_rev_weight_list.rbegin() + (m_geometry_rev_weight_list.size() - end),
-                  m_geometry_rev_weight_list.rbegin() + (m_geometry_rev_weight_list.size() - begin),
-                  result_weights.begin());
-
-        return result_weights;
+        const auto first = &m_geometry_rev_weight_list.at(begin);
+        return util::makeReverseRange(first, first + (end - begin));
     }
 
     virtual GeometryID GetGeometryIndexForEdgeID(const unsigned id) const override final
@@ -666,8 +765,15 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate);
+        const auto query = [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate);
+        };
+        if (!m_snapping_cache)
+        {
+            return query();
+        }
+        return m_snapping_cache->GetOrCompute({input_coordinate}, query);
     }
 
     std::pair<PhantomNode, PhantomNode> NearestPhantomNodeWithAlternativeFromBigComponent(
@@ -675,8 +781,15 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, max_distance);
+        const auto query = [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, max_distance);
+        };
+        if (!m_snapping_cache)
+        {
+            return query();
+        }
+        return m_snapping_cache->GetOrCompute({input_coordinate, max_distance}, query);
     }
 
     std::pair<PhantomNode, PhantomNode>
@@ -687,8 +800,16 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, max_distance, bearing, bearing_range);
+        const auto query = [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, max_distance, bearing, bearing_range);
+        };
+        if (!m_snapping_cache)
+        {
+            return query();
+        }
+        return m_snapping_cache->GetOrCompute(
+            {input_coordinate, max_distance, bearing, bearing_range}, query);
     }
 
     std::pair<PhantomNode, PhantomNode>
@@ -698,8 +819,16 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT(m_geospatial_query.get());
 
-        return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
-            input_coordinate, bearing, bearing_range);
+        const auto query = [&] {
+            return m_geospatial_query->NearestPhantomNodeWithAlternativeFromBigComponent(
+                input_coordinate, bearing, bearing_range);
+        };
+        if (!m_snapping_cache)
+        {
+            return query();
+        }
+        return m_snapping_cache->GetOrCompute({input_coordinate, -1., bearing, bearing_range},
+                                              query);
     }
 
     unsigned GetCheckSum() const override final { return m_check_sum; }
@@ -772,6 +901,20 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     // weights.
     virtual std::vector<uint8_t>
     GetUncompressedForwardDatasources(const EdgeID id) const override final
+    {
+        return util::toVector(GetUncompressedForwardDatasourcesRange(id));
+    }
+
+    // Returns the data source ids that were used to supply the edge
+    // weights.
+    virtual std::vector<uint8_t>
+    GetUncompressedReverseDatasources(const EdgeID id) const override final
+    {
+        return util::toVector(GetUncompressedReverseDatasourcesRange(id));
+    }
+
+    virtual DatasourceRange
+    GetUncompressedForwardDatasourcesRange(const EdgeID id) const override final
     {
         /*
          * Data sources for geometries are stored in one place for
@@ -785,31 +928,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const unsigned begin = m_geometry_indices.at(id) + 1;
         const unsigned end = m_geometry_indices.at(id + 1);
 
-        std::vector<uint8_t> result_datasources;
-        result_datasources.resize(end - begin);
-
-        // If there was no datasource info, return an array of 0's.
+        // If there was no datasource info, every segment uses the base profile
         if (m_datasource_list.empty())
         {
-            for (unsigned i = 0; i < end - begin; ++i)
-            {
-                result_datasources.push_back(0);
-            }
-        }
-        else
-        {
-            std::copy(m_datasource_list.begin() + begin,
-                      m_datasource_list.begin() + end,
-                      result_datasources.begin());
+            return DatasourceRange(&BASE_DATASOURCE, end - begin, 0);
         }
 
-        return result_datasources;
+        const auto first = &m_datasource_list.at(begin);
+        return util::makeForwardRange(first, first + (end - begin));
     }
 
-    // Returns the data source ids that were used to supply the edge
-    // weights.
-    virtual std::vector<uint8_t>
-    GetUncompressedReverseDatasources(const EdgeID id) const override final
+    virtual DatasourceRange
+    GetUncompressedReverseDatasourcesRange(const EdgeID id) const override final
     {
         /*
          * Datasources for geometries are stored in one place for
@@ -823,25 +953,14 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         const unsigned begin = m_geometry_indices.at(id);
         const unsigned end = m_geometry_indices.at(id + 1) - 1;
 
-        std::vector<uint8_t> result_datasources;
-        result_datasources.resize(end - begin);
-
-        // If there was no datasource info, return an array of 0's.
+        // If there was no datasource info, every segment uses the base profile
         if (m_datasource_list.empty())
         {
-            for (unsigned i = 0; i < end - begin; ++i)
-            {
-                result_datasources.push_back(0);
-            }
-        }
-        else
-        {
-            std::copy(m_datasource_list.rbegin() + (m_datasource_list.size() - end),
-                      m_datasource_list.rbegin() + (m_datasource_list.size() - begin),
-                      result_datasources.begin());
+            return DatasourceRange(&BASE_DATASOURCE, end - begin, 0);
         }
 
-        return result_datasources;
+        const auto first = &m_datasource_list.at(begin);
+        return util::makeReverseRange(first, first + (end - begin));
     }
 
     virtual std::string GetDatasourceName(const uint8_t datasource_name_id) const override final
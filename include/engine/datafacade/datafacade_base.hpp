@@ -4,6 +4,7 @@
 // Exposes all data access interfaces to the algorithms via base class ptr
 
 #include "contractor/query_edge.hpp"
+#include "contractor/sweep_edge.hpp"
 #include "extractor/edge_based_node.hpp"
 #include "extractor/external_memory_node.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
@@ -17,6 +18,7 @@
 #include "util/guidance/turn_lanes.hpp"
 #include "util/integer_range.hpp"
 #include "util/string_util.hpp"
+#include "util/strided_range.hpp"
 #include "util/typedefs.hpp"
 
 #include "osrm/coordinate.hpp"
@@ -35,6 +37,9 @@ namespace datafacade
 {
 
 using EdgeRange = util::range<EdgeID>;
+using GeometryRange = util::StridedRange<NodeID>;
+using WeightRange = util::StridedRange<EdgeWeight>;
+using DatasourceRange = util::StridedRange<DatasourceID>;
 
 class BaseDataFacade
 {
@@ -73,6 +78,15 @@ class BaseDataFacade
                                     const NodeID to,
                                     const std::function<bool(EdgeData)> filter) const = 0;
 
+    // downward sweep over the search graph, only available for fully contracted graphs
+    virtual bool HasDownwardSweep() const = 0;
+
+    virtual NodeID GetSweepPosition(const NodeID node) const = 0;
+
+    virtual EdgeRange GetSweepEdgeRange(const NodeID position) const = 0;
+
+    virtual const contractor::SweepEdge &GetSweepEdge(const EdgeID edge) const = 0;
+
     // node and edge information access
     virtual util::Coordinate GetCoordinateOfNode(const unsigned id) const = 0;
     virtual OSMNodeID GetOSMNodeIDOfNode(const unsigned id) const = 0;
@@ -94,6 +108,15 @@ class BaseDataFacade
     virtual std::vector<uint8_t> GetUncompressedForwardDatasources(const EdgeID id) const = 0;
     virtual std::vector<uint8_t> GetUncompressedReverseDatasources(const EdgeID id) const = 0;
 
+    // Same as the functions above but return views of the facade memory instead of copies.
+    // Reverse views iterate the shared arrays backwards.
+    virtual GeometryRange GetUncompressedForwardGeometryRange(const EdgeID id) const = 0;
+    virtual GeometryRange GetUncompressedReverseGeometryRange(const EdgeID id) const = 0;
+    virtual WeightRange GetUncompressedForwardWeightsRange(const EdgeID id) const = 0;
+    virtual WeightRange GetUncompressedReverseWeightsRange(const EdgeID id) const = 0;
+    virtual DatasourceRange GetUncompressedForwardDatasourcesRange(const EdgeID id) const = 0;
+    virtual DatasourceRange GetUncompressedReverseDatasourcesRange(const EdgeID id) const = 0;
+
     // Gets the name of a datasource
     virtual std::string GetDatasourceName(const uint8_t datasource_name_id) const = 0;
 
@@ -171,6 +194,9 @@ class BaseDataFacade
 
     virtual std::string GetTimestamp() const = 0;
 
+    // Changes whenever osrm-datastore loads a new dataset, datasets in process memory never change
+    virtual unsigned GetDataVersion() const { return 0; }
+
     virtual bool GetContinueStraightDefault() const = 0;
 
     virtual double GetMapMatchingMaxSpeed() const = 0;
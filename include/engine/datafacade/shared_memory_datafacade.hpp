@@ -25,16 +25,16 @@ class SharedMemoryDataFacade : public ContiguousInternalMemoryDataFacadeBase
 
   protected:
     std::unique_ptr<storage::SharedMemory> m_large_memory;
+    std::unique_ptr<storage::SharedMemory> m_weights_memory;
     std::shared_ptr<storage::SharedBarriers> shared_barriers;
     storage::SharedDataType data_region;
+    storage::SharedDataType weights_region;
     unsigned shared_timestamp;
 
     SharedMemoryDataFacade() {}
 
-  public:
-    // this function handle the deallocation of the shared memory it we can prove it will not be
-    // used anymore.  We crash hard here if something goes wrong (noexcept).
-    virtual ~SharedMemoryDataFacade() noexcept
+    // Removes region if it is no longer referenced by the current dataset and nobody uses it
+    void RemoveUnusedRegion(const storage::SharedDataType region) const noexcept
     {
         // Now check if this is still the newest dataset
         boost::interprocess::sharable_lock<boost::interprocess::named_upgradable_mutex>
@@ -42,38 +42,50 @@ class SharedMemoryDataFacade : public ContiguousInternalMemoryDataFacadeBase
                                  boost::interprocess::defer_lock);
 
         boost::interprocess::scoped_lock<boost::interprocess::named_sharable_mutex> exclusive_lock(
-            data_region == storage::REGION_1 ? shared_barriers->region_1_mutex
-                                             : shared_barriers->region_2_mutex,
-            boost::interprocess::defer_lock);
+            shared_barriers->GetRegionMutex(region), boost::interprocess::defer_lock);
 
         // if this returns false this is still in use
         if (current_regions_lock.try_lock() && exclusive_lock.try_lock())
         {
-            if (storage::SharedMemory::RegionExists(data_region))
+            if (storage::SharedMemory::RegionExists(region))
             {
                 auto shared_region = storage::makeSharedMemory(storage::CURRENT_REGION);
                 const auto current_timestamp =
                     static_cast<const storage::SharedDataTimestamp *>(shared_region->Ptr());
 
                 // check if the memory region referenced by this facade needs cleanup
-                if (current_timestamp->region == data_region)
+                if (current_timestamp->region == region ||
+                    current_timestamp->weights_region == region)
                 {
-                    util::Log(logDEBUG) << "Retaining data with shared timestamp "
-                                        << shared_timestamp;
+                    util::Log(logDEBUG) << "Retaining " << storage::regionToString(region)
+                                        << " with shared timestamp " << shared_timestamp;
                 }
                 else
                 {
-                    storage::SharedMemory::Remove(data_region);
+                    storage::SharedMemory::Remove(region);
                 }
             }
         }
     }
 
+  public:
+    // this function handle the deallocation of the shared memory it we can prove it will not be
+    // used anymore.  We crash hard here if something goes wrong (noexcept).
+    virtual ~SharedMemoryDataFacade() noexcept
+    {
+        if (weights_region != storage::REGION_NONE)
+        {
+            RemoveUnusedRegion(weights_region);
+        }
+        RemoveUnusedRegion(data_region);
+    }
+
     SharedMemoryDataFacade(const std::shared_ptr<storage::SharedBarriers> &shared_barriers_,
                            storage::SharedDataType data_region_,
+                           storage::SharedDataType weights_region_,
                            unsigned shared_timestamp_)
         : shared_barriers(shared_barriers_), data_region(data_region_),
-          shared_timestamp(shared_timestamp_)
+          weights_region(weights_region_), shared_timestamp(shared_timestamp_)
     {
         util::Log(logDEBUG) << "Loading new data with shared timestamp " << shared_timestamp;
 
@@ -83,7 +95,20 @@ class SharedMemoryDataFacade : public ContiguousInternalMemoryDataFacadeBase
         InitializeInternalPointers(*reinterpret_cast<storage::DataLayout *>(m_large_memory->Ptr()),
                                    reinterpret_cast<char *>(m_large_memory->Ptr()) +
                                        sizeof(storage::DataLayout));
+
+        // weights of a later update, everything else is shared with the data region
+        if (weights_region != storage::REGION_NONE)
+        {
+            BOOST_ASSERT(storage::SharedMemory::RegionExists(weights_region));
+            m_weights_memory = storage::makeSharedMemory(weights_region);
+
+            InitializeWeightPointers(
+                *reinterpret_cast<storage::DataLayout *>(m_weights_memory->Ptr()),
+                reinterpret_cast<char *>(m_weights_memory->Ptr()) + sizeof(storage::DataLayout));
+        }
     }
+
+    unsigned GetDataVersion() const override final { return shared_timestamp; }
 };
 }
 }
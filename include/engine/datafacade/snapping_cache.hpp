@@ -0,0 +1,163 @@
+#ifndef SNAPPING_CACHE_HPP
+#define SNAPPING_CACHE_HPP
+
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+#include "util/log.hpp"
+#include "util/metrics.hpp"
+#include "util/std_hash.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+/// Query of NearestPhantomNodeWithAlternativeFromBigComponent, unused options are negative
+struct SnappingCacheKey
+{
+    SnappingCacheKey(const util::Coordinate coordinate,
+                     const double max_distance = -1.,
+                     const int bearing = -1,
+                     const int bearing_range = -1)
+        : lon(static_cast<std::int32_t>(coordinate.lon)),
+          lat(static_cast<std::int32_t>(coordinate.lat)), max_distance(max_distance),
+          bearing(bearing), bearing_range(bearing_range)
+    {
+    }
+
+    bool operator==(const SnappingCacheKey &other) const
+    {
+        return lon == other.lon && lat == other.lat && max_distance == other.max_distance &&
+               bearing == other.bearing && bearing_range == other.bearing_range;
+    }
+
+    std::int32_t lon;
+    std::int32_t lat;
+    double max_distance;
+    int bearing;
+    int bearing_range;
+};
+
+/// Least recently used cache of snapped coordinates.
+///
+/// The cache belongs to a facade, so it is dropped together with the facade once osrm-datastore
+/// loaded new data. It is split into shards with a lock each to keep concurrent requests from
+/// serializing on a single mutex.
+class SnappingCache
+{
+  public:
+    using Value = std::pair<PhantomNode, PhantomNode>;
+
+    /// memory_budget: approximate number of bytes all entries may use
+    explicit SnappingCache(const std::size_t memory_budget)
+        : shard_capacity(std::max<std::size_t>(1, memory_budget / ENTRY_SIZE / NUM_SHARDS))
+    {
+    }
+
+    ~SnappingCache()
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        for (const auto &shard : shards)
+        {
+            hits += shard.hits;
+            misses += shard.misses;
+        }
+        if (hits + misses > 0)
+        {
+            util::Log() << "Snapping cache: " << hits << " hits, " << misses << " misses ("
+                        << (100 * hits / (hits + misses)) << "% hit rate)";
+        }
+    }
+
+    SnappingCache(const SnappingCache &) = delete;
+    SnappingCache &operator=(const SnappingCache &) = delete;
+
+    std::size_t Capacity() const { return shard_capacity * NUM_SHARDS; }
+
+    /// Returns the cached phantom nodes of the query or computes them with compute()
+    template <typename ComputeT> Value GetOrCompute(const SnappingCacheKey &key, ComputeT &&compute)
+    {
+        const auto hash = Hash()(key);
+        auto &shard = shards[(hash >> 8) % NUM_SHARDS];
+
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const auto entry = shard.entries.find(key);
+            if (entry != shard.entries.end())
+            {
+                ++shard.hits;
+                shard.lru.splice(shard.lru.begin(), shard.lru, entry->second);
+                util::metrics::Increment(util::metrics::Counter::SnappingCacheHits);
+                return entry->second->second;
+            }
+            ++shard.misses;
+        }
+        util::metrics::Increment(util::metrics::Counter::SnappingCacheMisses);
+
+        // the r-tree query runs without the lock, concurrent misses of the same key both query
+        auto value = compute();
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.entries.find(key) == shard.entries.end())
+        {
+            shard.lru.emplace_front(key, value);
+            shard.entries.emplace(key, shard.lru.begin());
+            if (shard.lru.size() > shard_capacity)
+            {
+                shard.entries.erase(shard.lru.back().first);
+                shard.lru.pop_back();
+            }
+        }
+        return value;
+    }
+
+  private:
+    struct Hash
+    {
+        std::size_t operator()(const SnappingCacheKey &key) const
+        {
+            return hash_val(key.lon, key.lat, key.max_distance, key.bearing, key.bearing_range);
+        }
+    };
+
+    using LRUList = std::list<std::pair<SnappingCacheKey, Value>>;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        // most recently used first
+        LRUList lru;
+        std::unordered_map<SnappingCacheKey, LRUList::iterator, Hash> entries;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+
+    static const constexpr std::size_t NUM_SHARDS = 16;
+    // list node with two pointers, hash map node with key, iterator, next pointer and hash,
+    // and the bucket pointer
+    static const constexpr std::size_t ENTRY_SIZE =
+        sizeof(LRUList::value_type) + 2 * sizeof(void *) + sizeof(SnappingCacheKey) +
+        sizeof(LRUList::iterator) + 3 * sizeof(void *);
+
+    const std::size_t shard_capacity;
+    std::array<Shard, NUM_SHARDS> shards;
+};
+}
+}
+}
+
+#endif // SNAPPING_CACHE_HPP
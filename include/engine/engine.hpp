@@ -2,6 +2,9 @@
 #define ENGINE_HPP
 
 #include "storage/shared_barriers.hpp"
+#include "engine/api/batch_nearest_parameters.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -11,6 +14,9 @@
 #include "engine/data_watchdog.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/engine_config.hpp"
+#include "engine/plugins/batch_nearest.hpp"
+#include "engine/plugins/batch_route.hpp"
+#include "engine/plugins/isochrone.hpp"
 #include "engine/plugins/match.hpp"
 #include "engine/plugins/nearest.hpp"
 #include "engine/plugins/table.hpp"
@@ -22,6 +28,8 @@
 #include "util/exception_utils.hpp"
 #include "util/json_container.hpp"
 
+#include <tbb/task_arena.h>
+
 #include <memory>
 #include <mutex>
 #include <string>
@@ -43,15 +51,32 @@ class Engine final
     Engine &operator=(const Engine &) = delete;
 
     Status Route(const api::RouteParameters &parameters, util::json::Object &result) const;
+    Status Route(const api::RouteParameters &parameters, std::string &result) const;
     Status Table(const api::TableParameters &parameters, util::json::Object &result) const;
+    Status Table(const api::TableParameters &parameters, util::json::Writer &result) const;
+    Status Table(const api::TableParameters &parameters, std::string &result) const;
     Status Nearest(const api::NearestParameters &parameters, util::json::Object &result) const;
     Status Trip(const api::TripParameters &parameters, util::json::Object &result) const;
     Status Match(const api::MatchParameters &parameters, util::json::Object &result) const;
+    Status Match(const api::MatchParameters &parameters, util::json::Writer &result) const;
+    Status Match(const api::MatchParameters &parameters, std::string &result) const;
     Status Tile(const api::TileParameters &parameters, std::string &result) const;
+    Status Isochrone(const api::IsochroneParameters &parameters,
+                     util::json::Object &result) const;
+    Status BatchRoute(const api::BatchRouteParameters &parameters,
+                      util::json::Object &result) const;
+    Status BatchRoute(const api::BatchRouteParameters &parameters,
+                      util::json::Writer &result) const;
+    Status BatchNearest(const api::BatchNearestParameters &parameters,
+                        util::json::Object &result) const;
+    Status BatchNearest(const api::BatchNearestParameters &parameters,
+                        util::json::Writer &result) const;
 
   private:
     std::unique_ptr<storage::SharedBarriers> lock;
     std::unique_ptr<DataWatchdog> watchdog;
+    // Shared by the batch plugins to limit the number of threads they use in total
+    const std::shared_ptr<tbb::task_arena> batch_arena;
 
     const plugins::ViaRoutePlugin route_plugin;
     const plugins::TablePlugin table_plugin;
@@ -59,6 +84,9 @@ class Engine final
     const plugins::TripPlugin trip_plugin;
     const plugins::MatchPlugin match_plugin;
     const plugins::TilePlugin tile_plugin;
+    const plugins::IsochronePlugin isochrone_plugin;
+    const plugins::BatchRoutePlugin batch_route_plugin;
+    const plugins::BatchNearestPlugin batch_nearest_plugin;
 
     // note in case of shared memory this will be empty, since the watchdog
     // will provide us with the up-to-date facade
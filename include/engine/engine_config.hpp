@@ -53,6 +53,29 @@ namespace engine
  *  - Match
  *  - Nearest
  *
+ * The maximum duration in seconds of an Isochrone request can be limited as well
+ * (-1 for unlimited), so can the number of pairs and of coordinates of a BatchRoute request
+ * and the number of coordinates of a BatchNearest request.
+ *
+ * The searches of a Table request run in parallel on threads that all Table requests share,
+ * so large matrices do not starve other services. Their number can be limited (-1 or 0 for
+ * one per core).
+ *
+ * The pairs of a BatchRoute request and the coordinates of a BatchNearest request are
+ * processed in parallel on threads that all batch requests share, their number can be limited
+ * as well (-1 or 0 for one per core).
+ *
+ * Route and Table can cache search results in a memory budget of megabytes each (0 disables
+ * the cache).
+ * Requests with the same snapped locations and search options are then answered from the
+ * cache, concurrent identical requests only search once.
+ *
+ * Snapped coordinates can be cached in a memory budget of megabytes (0 disables the cache).
+ * Coordinates queried again with the same radius and bearing skip the r-tree lookup.
+ *
+ * The r-tree leaves of a dataset can be faulted in before it serves its first request,
+ * also after osrm-datastore swapped in a new dataset.
+ *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
  *
  * \see OSRM, StorageConfig
@@ -67,7 +90,15 @@ struct EngineConfig final
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     int max_results_nearest = -1;
+    int max_table_threads = -1;
+    int max_duration_isochrone = -1;
+    int max_pairs_batch_route = -1;
+    int max_locations_batch_nearest = -1;
+    int max_batch_threads = -1;
+    int result_cache_size = 0;
+    int snapping_cache_size = 0;
     bool use_shared_memory = true;
+    bool warm_up = false;
 };
 }
 }
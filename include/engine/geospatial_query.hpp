@@ -372,26 +372,26 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
         int forward_offset = 0, forward_weight = 0;
         int reverse_offset = 0, reverse_weight = 0;
 
-        const std::vector<EdgeWeight> forward_weight_vector =
-            datafacade.GetUncompressedForwardWeights(data.packed_geometry_id);
-        const std::vector<EdgeWeight> reverse_weight_vector =
-            datafacade.GetUncompressedReverseWeights(data.packed_geometry_id);
+        const auto forward_weight_range =
+            datafacade.GetUncompressedForwardWeightsRange(data.packed_geometry_id);
+        const auto reverse_weight_range =
+            datafacade.GetUncompressedReverseWeightsRange(data.packed_geometry_id);
 
         for (std::size_t i = 0; i < data.fwd_segment_position; i++)
         {
-            forward_offset += forward_weight_vector[i];
+            forward_offset += forward_weight_range[i];
         }
-        forward_weight = forward_weight_vector[data.fwd_segment_position];
+        forward_weight = forward_weight_range[data.fwd_segment_position];
 
-        BOOST_ASSERT(data.fwd_segment_position < reverse_weight_vector.size());
+        BOOST_ASSERT(data.fwd_segment_position < reverse_weight_range.size());
 
-        for (std::size_t i = 0; i < reverse_weight_vector.size() - data.fwd_segment_position - 1;
+        for (std::size_t i = 0; i < reverse_weight_range.size() - data.fwd_segment_position - 1;
              i++)
         {
-            reverse_offset += reverse_weight_vector[i];
+            reverse_offset += reverse_weight_range[i];
         }
         reverse_weight =
-            reverse_weight_vector[reverse_weight_vector.size() - data.fwd_segment_position - 1];
+            reverse_weight_range[reverse_weight_range.size() - data.fwd_segment_position - 1];
 
         ratio = std::min(1.0, std::max(0.0, ratio));
         if (data.forward_segment_id.id != SPECIAL_SEGMENTID)
@@ -471,18 +471,18 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
         bool forward_edge_valid = false;
         bool reverse_edge_valid = false;
 
-        const std::vector<EdgeWeight> forward_weight_vector =
-            datafacade.GetUncompressedForwardWeights(segment.data.packed_geometry_id);
+        const auto forward_weight_range =
+            datafacade.GetUncompressedForwardWeightsRange(segment.data.packed_geometry_id);
 
-        if (forward_weight_vector[segment.data.fwd_segment_position] != INVALID_EDGE_WEIGHT)
+        if (forward_weight_range[segment.data.fwd_segment_position] != INVALID_EDGE_WEIGHT)
         {
             forward_edge_valid = segment.data.forward_segment_id.enabled;
         }
 
-        const std::vector<EdgeWeight> reverse_weight_vector =
-            datafacade.GetUncompressedReverseWeights(segment.data.packed_geometry_id);
-        if (reverse_weight_vector[reverse_weight_vector.size() - segment.data.fwd_segment_position -
-                                  1] != INVALID_EDGE_WEIGHT)
+        const auto reverse_weight_range =
+            datafacade.GetUncompressedReverseWeightsRange(segment.data.packed_geometry_id);
+        if (reverse_weight_range[reverse_weight_range.size() - segment.data.fwd_segment_position -
+                                 1] != INVALID_EDGE_WEIGHT)
         {
             reverse_edge_valid = segment.data.reverse_segment_id.enabled;
         }
@@ -51,8 +51,8 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
     // source node rev:       2 0 <- 1 <- 2
     const auto source_segment_start_coordinate =
         source_node.fwd_segment_position + (reversed_source ? 1 : 0);
-    const std::vector<NodeID> source_geometry =
-        facade.GetUncompressedForwardGeometry(source_node.packed_geometry_id);
+    const auto source_geometry =
+        facade.GetUncompressedForwardGeometryRange(source_node.packed_geometry_id);
     geometry.osm_node_ids.push_back(
         facade.GetOSMNodeIDOfNode(source_geometry[source_segment_start_coordinate]));
 
@@ -86,8 +86,8 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
     // segment leading to the target node
     geometry.segment_distances.push_back(cumulative_distance);
 
-    const std::vector<DatasourceID> forward_datasources =
-        facade.GetUncompressedForwardDatasources(target_node.packed_geometry_id);
+    const auto forward_datasources =
+        facade.GetUncompressedForwardDatasourcesRange(target_node.packed_geometry_id);
 
     geometry.annotations.emplace_back(
         LegGeometry::Annotation{current_distance,
@@ -103,8 +103,8 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
     // target node rev:       1       1 <- 2 <- 3
     const auto target_segment_end_coordinate =
         target_node.fwd_segment_position + (reversed_target ? 0 : 1);
-    const std::vector<NodeID> target_geometry =
-        facade.GetUncompressedForwardGeometry(target_node.packed_geometry_id);
+    const auto target_geometry =
+        facade.GetUncompressedForwardGeometryRange(target_node.packed_geometry_id);
     geometry.osm_node_ids.push_back(
         facade.GetOSMNodeIDOfNode(target_geometry[target_segment_end_coordinate]));
 
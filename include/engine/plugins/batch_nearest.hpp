@@ -0,0 +1,53 @@
+#ifndef BATCH_NEAREST_HPP
+#define BATCH_NEAREST_HPP
+
+#include "engine/api/batch_nearest_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <tbb/task_arena.h>
+
+#include <memory>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Snaps many coordinates in one request. The coordinates are processed in the order of their
+// Hilbert values, so consecutive lookups of a thread touch the same r-tree nodes and leaves.
+// The lookups run in parallel on the threads of the batch arena.
+class BatchNearestPlugin final : public BasePlugin
+{
+  public:
+    BatchNearestPlugin(const int max_locations_batch_nearest,
+                       const int max_results,
+                       std::shared_ptr<tbb::task_arena> batch_arena);
+
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::BatchNearestParameters &params,
+                         util::json::Object &result) const;
+
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::BatchNearestParameters &params,
+                         util::json::Writer &result) const;
+
+  private:
+    template <typename ResultT>
+    Status HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                             const api::BatchNearestParameters &params,
+                             ResultT &result) const;
+
+    const int max_locations_batch_nearest;
+    const int max_results;
+    // shared with the other batch plugins to bound the threads all batches use together
+    const std::shared_ptr<tbb::task_arena> batch_arena;
+};
+}
+}
+}
+
+#endif // BATCH_NEAREST_HPP
@@ -0,0 +1,55 @@
+#ifndef BATCH_ROUTE_HPP
+#define BATCH_ROUTE_HPP
+
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+#include "engine/routing_algorithms/direct_shortest_path.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <tbb/task_arena.h>
+
+#include <memory>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Computes the routes of many independent source and destination pairs in one request.
+// Every coordinate is snapped once, the pairs are searched in parallel on the threads of the
+// batch arena and each search uses the heaps of the thread it runs on.
+class BatchRoutePlugin final : public BasePlugin
+{
+  public:
+    BatchRoutePlugin(const int max_pairs_batch_route,
+                     std::shared_ptr<tbb::task_arena> batch_arena);
+
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::BatchRouteParameters &params,
+                         util::json::Object &result) const;
+
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::BatchRouteParameters &params,
+                         util::json::Writer &result) const;
+
+  private:
+    template <typename ResultT>
+    Status HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                             const api::BatchRouteParameters &params,
+                             ResultT &result) const;
+
+    mutable SearchEngineData heaps;
+    mutable routing_algorithms::DirectShortestPathRouting<RoutingDataFacade> direct_shortest_path;
+    const int max_pairs_batch_route;
+    // shared with the other batch plugins to bound the threads all batches use together
+    const std::shared_ptr<tbb::task_arena> batch_arena;
+};
+}
+}
+}
+
+#endif // BATCH_ROUTE_HPP
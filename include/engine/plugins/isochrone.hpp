@@ -0,0 +1,38 @@
+#ifndef ISOCHRONE_HPP
+#define ISOCHRONE_HPP
+
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+#include "engine/routing_algorithms/one_to_many_sweep.hpp"
+#include "engine/search_engine_data.hpp"
+#include "osrm/json_container.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Computes all road segments reachable from a single location within a duration budget.
+// All nodes are reached by a single downward sweep over the contracted graph instead of
+// running one query per target.
+class IsochronePlugin final : public BasePlugin
+{
+  public:
+    explicit IsochronePlugin(const int max_duration);
+
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::IsochroneParameters &params,
+                         util::json::Object &result) const;
+
+  private:
+    mutable SearchEngineData heaps;
+    mutable routing_algorithms::OneToManySweepRouting<RoutingDataFacade> sweep;
+    const int max_duration;
+};
+}
+}
+}
+
+#endif /* ISOCHRONE_HPP */
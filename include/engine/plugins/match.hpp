@@ -9,6 +9,7 @@
 #include "engine/routing_algorithms/shortest_path.hpp"
 #include "util/json_util.hpp"
 
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -37,10 +38,24 @@ class MatchPlugin : public BasePlugin
                          const api::MatchParameters &parameters,
                          util::json::Object &json_result) const;
 
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::MatchParameters &parameters,
+                         util::json::Writer &json_result) const;
+
+    // Steps and annotations are not supported by the protobuf format
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::MatchParameters &parameters,
+                         std::string &pbf_result) const;
+
   private:
+    template <typename ResultT>
+    Status HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                             const api::MatchParameters &parameters,
+                             ResultT &json_result) const;
+
     mutable SearchEngineData heaps;
-    mutable routing_algorithms::MapMatching<datafacade::BaseDataFacade> map_matching;
-    mutable routing_algorithms::ShortestPathRouting<datafacade::BaseDataFacade> shortest_path;
+    mutable routing_algorithms::MapMatching<RoutingDataFacade> map_matching;
+    mutable routing_algorithms::ShortestPathRouting<RoutingDataFacade> shortest_path;
     const int max_locations_map_matching;
 };
 }
@@ -2,14 +2,22 @@
 #define BASE_PLUGIN_HPP
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/pbf_factory.hpp"
+#include "engine/datafacade/contiguous_internalmem_datafacade_base.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/status.hpp"
 
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+#include "util/metrics.hpp"
+
+#include <boost/assert.hpp>
 
 #include <algorithm>
 #include <iterator>
@@ -23,9 +31,28 @@ namespace engine
 namespace plugins
 {
 
+// Facade type the routing algorithms are instantiated with. It implements the graph accessors
+// as final member functions, so the calls on the search hot path are resolved at compile time
+// and can be inlined. The virtual BaseDataFacade interface is only used at the plugin boundary.
+using RoutingDataFacade = datafacade::ContiguousInternalMemoryDataFacadeBase;
+
 class BasePlugin
 {
   protected:
+    // Both the shared memory and the process memory facade derive from RoutingDataFacade.
+    // The cast is checked in release builds too: a facade of any other type is reported as an
+    // error instead of being reinterpreted. It costs one dynamic_cast per request.
+    const RoutingDataFacade &GetRoutingFacade(const datafacade::BaseDataFacade &facade) const
+    {
+        const auto routing_facade = dynamic_cast<const RoutingDataFacade *>(&facade);
+        if (routing_facade == nullptr)
+        {
+            throw util::exception("Data facade does not provide the contiguous routing data " +
+                                  SOURCE_REF);
+        }
+        return *routing_facade;
+    }
+
     bool CheckAllCoordinates(const std::vector<util::Coordinate> &coordinates) const
     {
         return !std::any_of(
@@ -43,6 +70,27 @@ class BasePlugin
         return Status::Error;
     }
 
+    Status Error(const std::string &code,
+                 const std::string &message,
+                 util::json::Writer &json_writer) const
+    {
+        json_writer.StartObject();
+        json_writer.WriteKey("code");
+        json_writer.WriteString(code);
+        json_writer.WriteKey("message");
+        json_writer.WriteString(message);
+        json_writer.EndObject();
+        return Status::Error;
+    }
+
+    Status Error(const std::string &code,
+                 const std::string &message,
+                 std::string &pbf_result) const
+    {
+        api::pbf::writeError(pbf_result, code, message);
+        return Status::Error;
+    }
+
     // Decides whether to use the phantom node from a big or small component if both are found.
     // Returns true if all phantom nodes are in the same component after snapping.
     std::vector<PhantomNode>
@@ -112,6 +160,7 @@ class BasePlugin
                            const api::BaseParameters &parameters,
                            const std::vector<double> radiuses) const
     {
+        util::metrics::ScopedStage snapping_stage(util::metrics::Stage::Snapping);
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
         BOOST_ASSERT(radiuses.size() == parameters.coordinates.size());
@@ -154,71 +203,82 @@ class BasePlugin
                     const api::BaseParameters &parameters,
                     unsigned number_of_results) const
     {
+        util::metrics::ScopedStage snapping_stage(util::metrics::Stage::Snapping);
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
-        const bool use_bearings = !parameters.bearings.empty();
-        const bool use_radiuses = !parameters.radiuses.empty();
-
         BOOST_ASSERT(parameters.IsValid());
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            phantom_nodes[i] = GetPhantomNodes(facade, parameters, i, number_of_results);
+
+            // we didn't find a fitting node, return error
+            if (phantom_nodes[i].empty())
             {
-                phantom_nodes[i].push_back(PhantomNodeWithDistance{
-                    parameters.hints[i]->phantom,
-                    util::coordinate_calculation::haversineDistance(
-                        parameters.coordinates[i], parameters.hints[i]->phantom.location),
-                });
-                continue;
+                break;
             }
+        }
+        return phantom_nodes;
+    }
 
-            if (use_bearings && parameters.bearings[i])
+    // Nearest phantom nodes of a single coordinate, only reads the facade
+    std::vector<PhantomNodeWithDistance> GetPhantomNodes(const datafacade::BaseDataFacade &facade,
+                                                         const api::BaseParameters &parameters,
+                                                         const std::size_t i,
+                                                         unsigned number_of_results) const
+    {
+        BOOST_ASSERT(i < parameters.coordinates.size());
+
+        const bool use_hints = !parameters.hints.empty();
+        const bool use_bearings = !parameters.bearings.empty();
+        const bool use_radiuses = !parameters.radiuses.empty();
+
+        if (use_hints && parameters.hints[i] &&
+            parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+        {
+            return {PhantomNodeWithDistance{
+                parameters.hints[i]->phantom,
+                util::coordinate_calculation::haversineDistance(
+                    parameters.coordinates[i], parameters.hints[i]->phantom.location),
+            }};
+        }
+
+        if (use_bearings && parameters.bearings[i])
+        {
+            if (use_radiuses && parameters.radiuses[i])
             {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_nodes[i] = facade.NearestPhantomNodes(parameters.coordinates[i],
-                                                                  number_of_results,
-                                                                  *parameters.radiuses[i],
-                                                                  parameters.bearings[i]->bearing,
-                                                                  parameters.bearings[i]->range);
-                }
-                else
-                {
-                    phantom_nodes[i] = facade.NearestPhantomNodes(parameters.coordinates[i],
-                                                                  number_of_results,
-                                                                  parameters.bearings[i]->bearing,
-                                                                  parameters.bearings[i]->range);
-                }
+                return facade.NearestPhantomNodes(parameters.coordinates[i],
+                                                  number_of_results,
+                                                  *parameters.radiuses[i],
+                                                  parameters.bearings[i]->bearing,
+                                                  parameters.bearings[i]->range);
             }
             else
             {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_nodes[i] = facade.NearestPhantomNodes(
-                        parameters.coordinates[i], number_of_results, *parameters.radiuses[i]);
-                }
-                else
-                {
-                    phantom_nodes[i] =
-                        facade.NearestPhantomNodes(parameters.coordinates[i], number_of_results);
-                }
+                return facade.NearestPhantomNodes(parameters.coordinates[i],
+                                                  number_of_results,
+                                                  parameters.bearings[i]->bearing,
+                                                  parameters.bearings[i]->range);
             }
-
-            // we didn't find a fitting node, return error
-            if (phantom_nodes[i].empty())
+        }
+        else
+        {
+            if (use_radiuses && parameters.radiuses[i])
             {
-                break;
+                return facade.NearestPhantomNodes(
+                    parameters.coordinates[i], number_of_results, *parameters.radiuses[i]);
+            }
+            else
+            {
+                return facade.NearestPhantomNodes(parameters.coordinates[i], number_of_results);
             }
         }
-        return phantom_nodes;
     }
 
     std::vector<PhantomNodePair> GetPhantomNodes(const datafacade::BaseDataFacade &facade,
                                                  const api::BaseParameters &parameters) const
     {
+        util::metrics::ScopedStage snapping_stage(util::metrics::Stage::Snapping);
         std::vector<PhantomNodePair> phantom_node_pairs(parameters.coordinates.size());
 
         const bool use_hints = !parameters.hints.empty();
@@ -4,9 +4,17 @@
 #include "engine/plugins/plugin_base.hpp"
 
 #include "engine/api/table_parameters.hpp"
+#include "engine/result_cache.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/one_to_many_sweep.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <tbb/task_arena.h>
+
+#include <memory>
+#include <string>
 
 namespace osrm
 {
@@ -18,16 +26,37 @@ namespace plugins
 class TablePlugin final : public BasePlugin
 {
   public:
-    explicit TablePlugin(const int max_locations_distance_table);
+    TablePlugin(const int max_locations_distance_table,
+                const int max_table_threads,
+                const std::size_t result_cache_size);
 
     Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                          const api::TableParameters &params,
                          util::json::Object &result) const;
 
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::TableParameters &params,
+                         util::json::Writer &result) const;
+
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::TableParameters &params,
+                         std::string &result) const;
+
   private:
+    template <typename ResultT>
+    Status HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                             const api::TableParameters &params,
+                             ResultT &result) const;
+
     mutable SearchEngineData heaps;
-    mutable routing_algorithms::ManyToManyRouting<datafacade::BaseDataFacade> distance_table;
+    mutable routing_algorithms::ManyToManyRouting<RoutingDataFacade> distance_table;
+    mutable routing_algorithms::OneToManySweepRouting<RoutingDataFacade> sweep_table;
     const int max_locations_distance_table;
+    // Shared by all table requests to limit the number of threads they use in total. Sized
+    // for all available cores unless a smaller limit is configured.
+    mutable tbb::task_arena table_arena;
+    // empty if results are not cached
+    std::unique_ptr<ResultCache<std::vector<EdgeWeight>>> table_cache;
 };
 }
 }
@@ -4,6 +4,7 @@
 #include "engine/api/route_api.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/plugins/plugin_base.hpp"
+#include "engine/result_cache.hpp"
 
 #include "engine/routing_algorithms/alternative_path.hpp"
 #include "engine/routing_algorithms/direct_shortest_path.hpp"
@@ -29,18 +30,32 @@ class ViaRoutePlugin final : public BasePlugin
 {
   private:
     mutable SearchEngineData heaps;
-    mutable routing_algorithms::ShortestPathRouting<datafacade::BaseDataFacade> shortest_path;
-    mutable routing_algorithms::AlternativeRouting<datafacade::BaseDataFacade> alternative_path;
-    mutable routing_algorithms::DirectShortestPathRouting<datafacade::BaseDataFacade>
+    mutable routing_algorithms::ShortestPathRouting<RoutingDataFacade> shortest_path;
+    mutable routing_algorithms::AlternativeRouting<RoutingDataFacade> alternative_path;
+    mutable routing_algorithms::DirectShortestPathRouting<RoutingDataFacade>
         direct_shortest_path;
     const int max_locations_viaroute;
+    // empty if results are not cached
+    std::unique_ptr<ResultCache<InternalRouteResult>> route_cache;
 
   public:
-    explicit ViaRoutePlugin(int max_locations_viaroute);
+    // result_cache_size: memory budget in bytes of the route cache, 0 disables it
+    ViaRoutePlugin(int max_locations_viaroute, const std::size_t result_cache_size);
 
     Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                          const api::RouteParameters &route_parameters,
                          util::json::Object &json_result) const;
+
+    // Steps and annotations are not supported by the protobuf format
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::RouteParameters &route_parameters,
+                         std::string &pbf_result) const;
+
+  private:
+    template <typename ResultT>
+    Status HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                             const api::RouteParameters &route_parameters,
+                             ResultT &result) const;
 };
 }
 }
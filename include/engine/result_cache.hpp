@@ -0,0 +1,238 @@
+#ifndef ENGINE_RESULT_CACHE_HPP
+#define ENGINE_RESULT_CACHE_HPP
+
+#include "engine/internal_route_result.hpp"
+#include "engine/phantom_node.hpp"
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+/// Builds the binary key of a cached search from the snapped phantom nodes and the request
+/// parameters that influence the search.
+class ResultCacheKey
+{
+  public:
+    template <typename T> ResultCacheKey &Add(const T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic values can be added");
+        const auto offset = key.size();
+        key.resize(offset + sizeof(T));
+        std::memcpy(&key[offset], &value, sizeof(T));
+        return *this;
+    }
+
+    ResultCacheKey &Add(const util::Coordinate coordinate)
+    {
+        return Add(static_cast<std::int32_t>(coordinate.lon))
+            .Add(static_cast<std::int32_t>(coordinate.lat));
+    }
+
+    // all members are added explicitly, the padding of the struct is not initialized
+    ResultCacheKey &Add(const PhantomNode &phantom)
+    {
+        return Add(phantom.forward_segment_id.id)
+            .Add(static_cast<bool>(phantom.forward_segment_id.enabled))
+            .Add(phantom.reverse_segment_id.id)
+            .Add(static_cast<bool>(phantom.reverse_segment_id.enabled))
+            .Add(phantom.name_id)
+            .Add(phantom.forward_weight)
+            .Add(phantom.reverse_weight)
+            .Add(phantom.forward_offset)
+            .Add(phantom.reverse_offset)
+            .Add(phantom.packed_geometry_id)
+            .Add(static_cast<std::uint32_t>(phantom.component.id))
+            .Add(static_cast<bool>(phantom.component.is_tiny))
+            .Add(phantom.location)
+            .Add(phantom.input_location)
+            .Add(phantom.fwd_segment_position)
+            .Add(phantom.forward_travel_mode)
+            .Add(phantom.backward_travel_mode);
+    }
+
+    template <typename T> ResultCacheKey &Add(const std::vector<T> &values)
+    {
+        Add(values.size());
+        for (const auto &value : values)
+        {
+            Add(value);
+        }
+        return *this;
+    }
+
+    std::string key;
+};
+
+// Approximate number of bytes used by the cached search results
+template <typename T> std::size_t ApproximateSize(const T &)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "needs an ApproximateSize overload");
+    return sizeof(T);
+}
+
+template <typename T> std::size_t ApproximateSize(const std::vector<T> &values)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "needs an ApproximateSize overload");
+    return sizeof(values) + values.capacity() * sizeof(T);
+}
+
+inline std::size_t ApproximateSize(const std::vector<bool> &values)
+{
+    return sizeof(values) + values.capacity() / 8;
+}
+
+inline std::size_t ApproximateSize(const InternalRouteResult &route)
+{
+    std::size_t size = sizeof(route) + ApproximateSize(route.unpacked_alternative) +
+                       ApproximateSize(route.segment_end_coordinates) +
+                       ApproximateSize(route.source_traversed_in_reverse) +
+                       ApproximateSize(route.target_traversed_in_reverse) +
+                       ApproximateSize(route.alt_source_traversed_in_reverse) +
+                       ApproximateSize(route.alt_target_traversed_in_reverse);
+    for (const auto &segment : route.unpacked_path_segments)
+    {
+        size += ApproximateSize(segment);
+    }
+    return size;
+}
+
+/// Least recently used cache of search results that coalesces concurrent identical searches.
+/// The capacity is a memory budget in bytes, entries are evicted once the approximate size of
+/// all keys and values exceeds it.
+///
+/// All entries are dropped once a search runs on a newer dataset, which happens when
+/// osrm-datastore loaded new data into shared memory. Searches that still run on an older
+/// dataset during the swap bypass the cache.
+template <typename ValueT> class ResultCache
+{
+  public:
+    using ValuePtr = std::shared_ptr<const ValueT>;
+
+    explicit ResultCache(const std::size_t capacity)
+        : capacity(capacity), used_size(0), data_version(0)
+    {
+        BOOST_ASSERT(capacity > 0);
+    }
+
+    /// Bytes an entry is accounted with, including the bookkeeping of the cache
+    static std::size_t EntrySize(const std::string &key, const ValueT &value)
+    {
+        return 2 * key.size() + ApproximateSize(value) + ENTRY_OVERHEAD;
+    }
+
+    /// Returns the cached value of the key or computes it with compute(). Concurrent calls with
+    /// the same key wait for the first one instead of computing the value again.
+    template <typename ComputeT>
+    ValuePtr GetOrCompute(const unsigned version, const std::string &key, ComputeT &&compute)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (version > data_version)
+        {
+            entries.clear();
+            lru.clear();
+            in_flight.clear();
+            used_size = 0;
+            data_version = version;
+        }
+        else if (version < data_version)
+        {
+            lock.unlock();
+            return std::make_shared<const ValueT>(compute());
+        }
+
+        const auto entry = entries.find(key);
+        if (entry != entries.end())
+        {
+            lru.splice(lru.begin(), lru, entry->second);
+            return entry->second->second;
+        }
+
+        const auto pending = in_flight.find(key);
+        if (pending != in_flight.end())
+        {
+            auto result = pending->second;
+            lock.unlock();
+            return result.get();
+        }
+
+        std::promise<ValuePtr> promise;
+        in_flight.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        ValuePtr value;
+        try
+        {
+            value = std::make_shared<const ValueT>(compute());
+        }
+        catch (...)
+        {
+            lock.lock();
+            if (version == data_version)
+            {
+                in_flight.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+
+        lock.lock();
+        // the dataset might have changed in the meantime, then the result is outdated
+        if (version == data_version)
+        {
+            in_flight.erase(key);
+            const auto size = EntrySize(key, *value);
+            // a value larger than the whole budget would only evict everything else
+            if (size <= capacity)
+            {
+                lru.emplace_front(key, value);
+                entries[key] = lru.begin();
+                used_size += size;
+                while (used_size > capacity)
+                {
+                    used_size -= EntrySize(lru.back().first, *lru.back().second);
+                    entries.erase(lru.back().first);
+                    lru.pop_back();
+                }
+            }
+        }
+        promise.set_value(value);
+        return value;
+    }
+
+  private:
+    using LRUList = std::list<std::pair<std::string, ValuePtr>>;
+
+    // list node, hash map node and shared_ptr control block of an entry
+    static const constexpr std::size_t ENTRY_OVERHEAD = 128;
+
+    const std::size_t capacity;
+    std::size_t used_size;
+    std::mutex mutex;
+    unsigned data_version;
+    // most recently used first
+    LRUList lru;
+    std::unordered_map<std::string, typename LRUList::iterator> entries;
+    std::unordered_map<std::string, std::shared_future<ValuePtr>> in_flight;
+};
+}
+}
+
+#endif // ENGINE_RESULT_CACHE_HPP
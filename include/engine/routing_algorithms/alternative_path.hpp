@@ -4,6 +4,7 @@
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/integer_range.hpp"
+#include "util/metrics.hpp"
 
 #include <boost/assert.hpp>
 
@@ -325,6 +326,7 @@ class AlternativeRouting final
         }
 
         // Unpack shortest path and alternative, if they exist
+        util::metrics::ScopedStage unpacking_stage(util::metrics::Stage::Unpacking);
         if (INVALID_EDGE_WEIGHT != upper_bound_to_shortest_path_weight)
         {
             BOOST_ASSERT(!packed_shortest_path.empty());
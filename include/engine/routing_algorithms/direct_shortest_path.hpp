@@ -7,6 +7,7 @@
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/integer_range.hpp"
+#include "util/metrics.hpp"
 #include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 
@@ -140,6 +141,7 @@ class DirectShortestPathRouting final
         raw_route_data.target_traversed_in_reverse.push_back(
             (packed_leg.back() != phantom_node_pair.target_phantom.forward_segment_id.id));
 
+        util::metrics::ScopedStage unpacking_stage(util::metrics::Stage::Unpacking);
         super::UnpackPath(facade,
                           packed_leg.begin(),
                           packed_leg.end(),
@@ -7,9 +7,14 @@
 
 #include <boost/assert.hpp>
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
 #include <limits>
 #include <memory>
-#include <unordered_map>
+#include <tuple>
 #include <vector>
 
 namespace osrm
@@ -26,26 +31,69 @@ class ManyToManyRouting final
     using super = BasicRoutingInterface<DataFacadeT, ManyToManyRouting<DataFacadeT>>;
     using QueryHeap = SearchEngineData::QueryHeap;
     SearchEngineData &engine_working_data;
+    const bool parallel_searches;
 
+    // Settled node of a backward search: reaching `target_id` (a column in the weight matrix)
+    // from `node` costs `weight`.
     struct NodeBucket
     {
-        unsigned target_id; // essentially a row in the weight matrix
+        NodeID node;
+        unsigned target_id; // essentially a column in the weight matrix
         EdgeWeight weight;
-        NodeBucket(const unsigned target_id, const EdgeWeight weight)
-            : target_id(target_id), weight(weight)
+        NodeBucket(const NodeID node, const unsigned target_id, const EdgeWeight weight)
+            : node(node), target_id(target_id), weight(weight)
+        {
+        }
+
+        bool operator<(const NodeBucket &rhs) const
         {
+            return std::tie(node, target_id) < std::tie(rhs.node, rhs.target_id);
+        }
+
+        // heterogeneous comparators for std::equal_range
+        friend bool operator<(const NodeBucket &bucket, const NodeID node)
+        {
+            return bucket.node < node;
+        }
+        friend bool operator<(const NodeID node, const NodeBucket &bucket)
+        {
+            return node < bucket.node;
         }
     };
 
-    // FIXME This should be replaced by an std::unordered_multimap, though this needs benchmarking
-    using SearchSpaceWithBuckets = std::unordered_map<NodeID, std::vector<NodeBucket>>;
+    // All buckets of all backward searches in one flat array, sorted by node. Looking up the
+    // buckets of a node is a binary search and the buckets of one node are contiguous in memory.
+    using SearchSpaceWithBuckets = std::vector<NodeBucket>;
+
+    // Every search is a single task, they are expensive enough to not need any batching
+    static constexpr std::size_t SearchGrainSize = 1;
+
+    // Calls f with ranges that cover [0, size). Without parallel searches f is called once with
+    // the whole range on the calling thread.
+    template <typename F> void ForEachRange(const unsigned size, const F &f) const
+    {
+        if (parallel_searches)
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned>(0, size, SearchGrainSize), f);
+        }
+        else
+        {
+            f(tbb::blocked_range<unsigned>(0, size));
+        }
+    }
 
   public:
-    ManyToManyRouting(SearchEngineData &engine_working_data)
-        : engine_working_data(engine_working_data)
+    // The searches only run in parallel if `parallel_searches` is set. They then use all
+    // threads of the task arena the call runs in, so callers that enable it are expected to
+    // bound the concurrency with an arena of their own.
+    ManyToManyRouting(SearchEngineData &engine_working_data, const bool parallel_searches = false)
+        : engine_working_data(engine_working_data), parallel_searches(parallel_searches)
     {
     }
 
+    // Runs all backward searches and afterwards all forward searches. Every search uses the
+    // heap of the thread it runs on and every forward search only writes its own row of the
+    // result table, so no synchronization is needed besides the barrier between phases.
     std::vector<EdgeWeight> operator()(const DataFacadeT &facade,
                                        const std::vector<PhantomNode> &phantom_nodes,
                                        const std::vector<std::size_t> &source_indices,
@@ -59,17 +107,17 @@ class ManyToManyRouting final
         std::vector<EdgeWeight> result_table(number_of_entries,
                                              std::numeric_limits<EdgeWeight>::max());
 
-        engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+        const auto search_target_phantom = [&](const unsigned column_idx,
+                                               SearchSpaceWithBuckets &search_space_with_buckets) {
+            const auto &phantom =
+                target_indices.empty() ? phantom_nodes[column_idx]
+                                       : phantom_nodes[target_indices[column_idx]];
 
-        QueryHeap &query_heap = *(engine_working_data.forward_heap_1);
+            engine_working_data.InitializeOrClearFirstThreadLocalStorage(
+                facade.GetNumberOfNodes());
+            QueryHeap &query_heap = *(engine_working_data.forward_heap_1);
 
-        SearchSpaceWithBuckets search_space_with_buckets;
-
-        unsigned column_idx = 0;
-        const auto search_target_phantom = [&](const PhantomNode &phantom) {
-            query_heap.Clear();
             // insert target(s) at weight 0
-
             if (phantom.forward_segment_id.enabled)
             {
                 query_heap.Insert(phantom.forward_segment_id.id,
@@ -88,15 +136,19 @@ class ManyToManyRouting final
             {
                 BackwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
             }
-            ++column_idx;
         };
 
         // for each source do forward search
-        unsigned row_idx = 0;
-        const auto search_source_phantom = [&](const PhantomNode &phantom) {
-            query_heap.Clear();
-            // insert target(s) at weight 0
+        const auto search_source_phantom = [&](
+            const unsigned row_idx, const SearchSpaceWithBuckets &search_space_with_buckets) {
+            const auto &phantom = source_indices.empty() ? phantom_nodes[row_idx]
+                                                         : phantom_nodes[source_indices[row_idx]];
+
+            engine_working_data.InitializeOrClearFirstThreadLocalStorage(
+                facade.GetNumberOfNodes());
+            QueryHeap &query_heap = *(engine_working_data.forward_heap_1);
 
+            // insert source(s) at weight 0
             if (phantom.forward_segment_id.enabled)
             {
                 query_heap.Insert(phantom.forward_segment_id.id,
@@ -120,40 +172,48 @@ class ManyToManyRouting final
                                    search_space_with_buckets,
                                    result_table);
             }
-            ++row_idx;
         };
 
-        if (target_indices.empty())
-        {
-            for (const auto &phantom : phantom_nodes)
+        // collect the buckets of all backward searches in thread local arrays
+        tbb::enumerable_thread_specific<SearchSpaceWithBuckets> thread_buckets;
+        ForEachRange(number_of_targets, [&](const tbb::blocked_range<unsigned> &range) {
+            auto &search_space_with_buckets = thread_buckets.local();
+            for (auto column_idx = range.begin(), end = range.end(); column_idx != end;
+                 ++column_idx)
             {
-                search_target_phantom(phantom);
+                search_target_phantom(column_idx, search_space_with_buckets);
             }
+        });
+
+        SearchSpaceWithBuckets search_space_with_buckets;
+        std::size_t number_of_buckets = 0;
+        for (const auto &buckets : thread_buckets)
+        {
+            number_of_buckets += buckets.size();
         }
-        else
+        search_space_with_buckets.reserve(number_of_buckets);
+        for (auto &buckets : thread_buckets)
         {
-            for (const auto index : target_indices)
-            {
-                const auto &phantom = phantom_nodes[index];
-                search_target_phantom(phantom);
-            }
+            search_space_with_buckets.insert(
+                search_space_with_buckets.end(), buckets.begin(), buckets.end());
+            SearchSpaceWithBuckets().swap(buckets);
         }
-
-        if (source_indices.empty())
+        // (node, target) pairs are unique, so the order does not depend on thread scheduling
+        if (parallel_searches)
         {
-            for (const auto &phantom : phantom_nodes)
-            {
-                search_source_phantom(phantom);
-            }
+            tbb::parallel_sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
         }
         else
         {
-            for (const auto index : source_indices)
+            std::sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
+        }
+
+        ForEachRange(number_of_sources, [&](const tbb::blocked_range<unsigned> &range) {
+            for (auto row_idx = range.begin(), end = range.end(); row_idx != end; ++row_idx)
             {
-                const auto &phantom = phantom_nodes[index];
-                search_source_phantom(phantom);
+                search_source_phantom(row_idx, search_space_with_buckets);
             }
-        }
+        });
 
         return result_table;
     }
@@ -168,34 +228,30 @@ class ManyToManyRouting final
         const NodeID node = query_heap.DeleteMin();
         const int source_weight = query_heap.GetKey(node);
 
-        // check if each encountered node has an entry
-        const auto bucket_iterator = search_space_with_buckets.find(node);
-        // iterate bucket if there exists one
-        if (bucket_iterator != search_space_with_buckets.end())
+        // iterate the buckets of the node, if there are any
+        const auto bucket_list = std::equal_range(
+            search_space_with_buckets.begin(), search_space_with_buckets.end(), node);
+        for (auto bucket = bucket_list.first; bucket != bucket_list.second; ++bucket)
         {
-            const std::vector<NodeBucket> &bucket_list = bucket_iterator->second;
-            for (const NodeBucket &current_bucket : bucket_list)
+            // get target id from bucket entry
+            const unsigned column_idx = bucket->target_id;
+            const int target_weight = bucket->weight;
+            auto &current_weight = result_table[row_idx * number_of_targets + column_idx];
+            // check if new weight is better
+            const EdgeWeight new_weight = source_weight + target_weight;
+            if (new_weight < 0)
             {
-                // get target id from bucket entry
-                const unsigned column_idx = current_bucket.target_id;
-                const int target_weight = current_bucket.weight;
-                auto &current_weight = result_table[row_idx * number_of_targets + column_idx];
-                // check if new weight is better
-                const EdgeWeight new_weight = source_weight + target_weight;
-                if (new_weight < 0)
-                {
-                    const EdgeWeight loop_weight = super::GetLoopWeight(facade, node);
-                    const int new_weight_with_loop = new_weight + loop_weight;
-                    if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
-                    {
-                        current_weight = std::min(current_weight, new_weight_with_loop);
-                    }
-                }
-                else if (new_weight < current_weight)
+                const EdgeWeight loop_weight = super::GetLoopWeight(facade, node);
+                const int new_weight_with_loop = new_weight + loop_weight;
+                if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
                 {
-                    result_table[row_idx * number_of_targets + column_idx] = new_weight;
+                    current_weight = std::min(current_weight, new_weight_with_loop);
                 }
             }
+            else if (new_weight < current_weight)
+            {
+                current_weight = new_weight;
+            }
         }
         if (StallAtNode<true>(facade, node, source_weight, query_heap))
         {
@@ -213,7 +269,7 @@ class ManyToManyRouting final
         const int target_weight = query_heap.GetKey(node);
 
         // store settled nodes in search space bucket
-        search_space_with_buckets[node].emplace_back(column_idx, target_weight);
+        search_space_with_buckets.emplace_back(node, column_idx, target_weight);
 
         if (StallAtNode<false>(facade, node, target_weight, query_heap))
         {
@@ -0,0 +1,212 @@
+#ifndef ONE_TO_MANY_SWEEP_HPP
+#define ONE_TO_MANY_SWEEP_HPP
+
+#include "engine/routing_algorithms/routing_base.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// PHAST-style one-to-all search on the contracted graph: an upward search from the source
+// followed by a single linear pass over all nodes in descending level order that relaxes every
+// downward edge. The cost does not depend on the number of targets, which makes it much faster
+// than bucket based many-to-many for very wide tables.
+// Requires the downward sweep computed by the contractor (see DataFacade::HasDownwardSweep).
+template <class DataFacadeT>
+class OneToManySweepRouting final
+    : public BasicRoutingInterface<DataFacadeT, OneToManySweepRouting<DataFacadeT>>
+{
+    using super = BasicRoutingInterface<DataFacadeT, OneToManySweepRouting<DataFacadeT>>;
+    using QueryHeap = SearchEngineData::QueryHeap;
+    using SweepWeights = SearchEngineData::SweepWeights;
+    SearchEngineData &engine_working_data;
+    const bool parallel_sweeps;
+
+  public:
+    // Like ManyToManyRouting the rows are only computed in parallel if `parallel_sweeps` is set,
+    // callers that enable it bound the concurrency with their own task arena.
+    OneToManySweepRouting(SearchEngineData &engine_working_data, const bool parallel_sweeps = false)
+        : engine_working_data(engine_working_data), parallel_sweeps(parallel_sweeps)
+    {
+    }
+
+    // Same interface and semantics as ManyToManyRouting: returns a row major
+    // sources x targets table. Every row is one sweep.
+    std::vector<EdgeWeight> operator()(const DataFacadeT &facade,
+                                       const std::vector<PhantomNode> &phantom_nodes,
+                                       const std::vector<std::size_t> &source_indices,
+                                       const std::vector<std::size_t> &target_indices) const
+    {
+        BOOST_ASSERT(facade.HasDownwardSweep());
+
+        const auto number_of_sources =
+            source_indices.empty() ? phantom_nodes.size() : source_indices.size();
+        const auto number_of_targets =
+            target_indices.empty() ? phantom_nodes.size() : target_indices.size();
+        std::vector<EdgeWeight> result_table(number_of_sources * number_of_targets,
+                                             std::numeric_limits<EdgeWeight>::max());
+
+        const auto compute_rows = [&](const tbb::blocked_range<unsigned> &range) {
+            for (auto row_idx = range.begin(), end = range.end(); row_idx != end; ++row_idx)
+            {
+                const auto &source = source_indices.empty()
+                                         ? phantom_nodes[row_idx]
+                                         : phantom_nodes[source_indices[row_idx]];
+
+                const auto &weights = Sweep(facade, source);
+
+                for (unsigned column_idx = 0; column_idx < number_of_targets; ++column_idx)
+                {
+                    const auto &target = target_indices.empty()
+                                             ? phantom_nodes[column_idx]
+                                             : phantom_nodes[target_indices[column_idx]];
+                    result_table[row_idx * number_of_targets + column_idx] =
+                        GetTargetWeight(facade, weights, target);
+                }
+            }
+        };
+        if (parallel_sweeps)
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned>(0, number_of_sources, 1), compute_rows);
+        }
+        else
+        {
+            compute_rows(tbb::blocked_range<unsigned>(0, number_of_sources));
+        }
+
+        return result_table;
+    }
+
+    // Computes the weight from the source phantom to every node of the graph. The result is
+    // indexed by sweep position (see DataFacade::GetSweepPosition) and is only valid until the
+    // next sweep on the same thread. Weights include the negative source offset like the
+    // forward search of the other routing algorithms.
+    const SweepWeights &Sweep(const DataFacadeT &facade, const PhantomNode &source) const
+    {
+        engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+        engine_working_data.InitializeOrClearSweepThreadLocalStorage(facade.GetNumberOfNodes());
+        QueryHeap &query_heap = *(engine_working_data.forward_heap_1);
+        SweepWeights &weights = *(engine_working_data.sweep_weights);
+
+        if (source.forward_segment_id.enabled)
+        {
+            query_heap.Insert(source.forward_segment_id.id,
+                              -source.GetForwardWeightPlusOffset(),
+                              source.forward_segment_id.id);
+        }
+        if (source.reverse_segment_id.enabled)
+        {
+            query_heap.Insert(source.reverse_segment_id.id,
+                              -source.GetReverseWeightPlusOffset(),
+                              source.reverse_segment_id.id);
+        }
+
+        // upward search, every settled node seeds the sweep
+        while (!query_heap.Empty())
+        {
+            const NodeID node = query_heap.DeleteMin();
+            const EdgeWeight weight = query_heap.GetKey(node);
+            weights[facade.GetSweepPosition(node)] = weight;
+
+            for (const auto edge : facade.GetAdjacentEdgeRange(node))
+            {
+                const auto &data = facade.GetEdgeData(edge);
+                if (!data.forward)
+                {
+                    continue;
+                }
+
+                const NodeID to = facade.GetTarget(edge);
+                BOOST_ASSERT_MSG(data.weight > 0, "edge_weight invalid");
+                const EdgeWeight to_weight = weight + data.weight;
+                if (!query_heap.WasInserted(to))
+                {
+                    query_heap.Insert(to, to_weight, node);
+                }
+                else if (to_weight < query_heap.GetKey(to))
+                {
+                    query_heap.GetData(to).parent = node;
+                    query_heap.DecreaseKey(to, to_weight);
+                }
+            }
+        }
+
+        // downward sweep, all edges ending at a position start at a smaller position
+        for (NodeID position = 0, end = weights.size(); position < end; ++position)
+        {
+            EdgeWeight weight = weights[position];
+            for (const auto edge : facade.GetSweepEdgeRange(position))
+            {
+                const auto &sweep_edge = facade.GetSweepEdge(edge);
+                BOOST_ASSERT(sweep_edge.source < position);
+                const EdgeWeight source_weight = weights[sweep_edge.source];
+                if (source_weight != INVALID_EDGE_WEIGHT)
+                {
+                    weight = std::min(weight, source_weight + sweep_edge.weight);
+                }
+            }
+            weights[position] = weight;
+        }
+
+        return weights;
+    }
+
+    // Weight to reach the target phantom given the weights of a sweep,
+    // INVALID_EDGE_WEIGHT if it is not reachable.
+    EdgeWeight GetTargetWeight(const DataFacadeT &facade,
+                               const SweepWeights &weights,
+                               const PhantomNode &target) const
+    {
+        EdgeWeight result = INVALID_EDGE_WEIGHT;
+        const auto relax_target = [&](const NodeID node, const EdgeWeight offset) {
+            const EdgeWeight node_weight = weights[facade.GetSweepPosition(node)];
+            if (node_weight == INVALID_EDGE_WEIGHT)
+            {
+                return;
+            }
+            const EdgeWeight new_weight = node_weight + offset;
+            // source and target are on the same segment but the target lies behind the source
+            if (new_weight < 0)
+            {
+                const EdgeWeight loop_weight = super::GetLoopWeight(facade, node);
+                const EdgeWeight new_weight_with_loop = new_weight + loop_weight;
+                if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
+                {
+                    result = std::min(result, new_weight_with_loop);
+                }
+            }
+            else
+            {
+                result = std::min(result, new_weight);
+            }
+        };
+
+        if (target.forward_segment_id.enabled)
+        {
+            relax_target(target.forward_segment_id.id, target.GetForwardWeightPlusOffset());
+        }
+        if (target.reverse_segment_id.enabled)
+        {
+            relax_target(target.reverse_segment_id.id, target.GetReverseWeightPlusOffset());
+        }
+        return result;
+    }
+};
+}
+}
+}
+
+#endif // ONE_TO_MANY_SWEEP_HPP
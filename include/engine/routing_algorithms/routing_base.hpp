@@ -2,6 +2,7 @@
 #define ROUTING_BASE_HPP
 
 #include "extractor/guidance/turn_instruction.hpp"
+#include "engine/datafacade/datafacade_base.hpp"
 #include "engine/edge_unpacker.hpp"
 #include "engine/internal_route_result.hpp"
 #include "engine/search_engine_data.hpp"
@@ -243,53 +244,55 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
                         : facade.GetTravelModeForEdgeID(edge_data.id);
 
                 const auto geometry_index = facade.GetGeometryIndexForEdgeID(edge_data.id);
-                std::vector<NodeID> id_vector;
-                std::vector<EdgeWeight> weight_vector;
-                std::vector<DatasourceID> datasource_vector;
+                datafacade::GeometryRange id_range;
+                datafacade::WeightRange weight_range;
+                datafacade::DatasourceRange datasource_range;
                 if (geometry_index.forward)
                 {
-                    id_vector = facade.GetUncompressedForwardGeometry(geometry_index.id);
-                    weight_vector = facade.GetUncompressedForwardWeights(geometry_index.id);
-                    datasource_vector = facade.GetUncompressedForwardDatasources(geometry_index.id);
+                    id_range = facade.GetUncompressedForwardGeometryRange(geometry_index.id);
+                    weight_range = facade.GetUncompressedForwardWeightsRange(geometry_index.id);
+                    datasource_range =
+                        facade.GetUncompressedForwardDatasourcesRange(geometry_index.id);
                 }
                 else
                 {
-                    id_vector = facade.GetUncompressedReverseGeometry(geometry_index.id);
-                    weight_vector = facade.GetUncompressedReverseWeights(geometry_index.id);
-                    datasource_vector = facade.GetUncompressedReverseDatasources(geometry_index.id);
+                    id_range = facade.GetUncompressedReverseGeometryRange(geometry_index.id);
+                    weight_range = facade.GetUncompressedReverseWeightsRange(geometry_index.id);
+                    datasource_range =
+                        facade.GetUncompressedReverseDatasourcesRange(geometry_index.id);
                 }
-                BOOST_ASSERT(id_vector.size() > 0);
-                BOOST_ASSERT(weight_vector.size() > 0);
-                BOOST_ASSERT(datasource_vector.size() > 0);
+                BOOST_ASSERT(id_range.size() > 0);
+                BOOST_ASSERT(weight_range.size() > 0);
+                BOOST_ASSERT(datasource_range.size() > 0);
 
                 const auto total_weight =
-                    std::accumulate(weight_vector.begin(), weight_vector.end(), 0);
+                    std::accumulate(weight_range.begin(), weight_range.end(), 0);
 
-                BOOST_ASSERT(weight_vector.size() == id_vector.size() - 1);
+                BOOST_ASSERT(weight_range.size() == id_range.size() - 1);
                 const bool is_first_segment = unpacked_path.empty();
 
                 const std::size_t start_index =
                     (is_first_segment
                          ? ((start_traversed_in_reverse)
-                                ? weight_vector.size() -
+                                ? weight_range.size() -
                                       phantom_node_pair.source_phantom.fwd_segment_position - 1
                                 : phantom_node_pair.source_phantom.fwd_segment_position)
                          : 0);
-                const std::size_t end_index = weight_vector.size();
+                const std::size_t end_index = weight_range.size();
 
                 BOOST_ASSERT(start_index >= 0);
                 BOOST_ASSERT(start_index < end_index);
                 for (std::size_t segment_idx = start_index; segment_idx < end_index; ++segment_idx)
                 {
                     unpacked_path.push_back(
-                        PathData{id_vector[segment_idx + 1],
+                        PathData{id_range[segment_idx + 1],
                                  name_index,
-                                 weight_vector[segment_idx],
+                                 weight_range[segment_idx],
                                  extractor::guidance::TurnInstruction::NO_TURN(),
                                  {{0, INVALID_LANEID}, INVALID_LANE_DESCRIPTIONID},
                                  travel_mode,
                                  INVALID_ENTRY_CLASSID,
-                                 datasource_vector[segment_idx],
+                                 datasource_range[segment_idx],
                                  util::guidance::TurnBearing(0),
                                  util::guidance::TurnBearing(0)});
                 }
@@ -305,31 +308,31 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
             });
 
         std::size_t start_index = 0, end_index = 0;
-        std::vector<unsigned> id_vector;
-        std::vector<EdgeWeight> weight_vector;
-        std::vector<DatasourceID> datasource_vector;
+        datafacade::GeometryRange id_range;
+        datafacade::WeightRange weight_range;
+        datafacade::DatasourceRange datasource_range;
         const bool is_local_path = (phantom_node_pair.source_phantom.packed_geometry_id ==
                                     phantom_node_pair.target_phantom.packed_geometry_id) &&
                                    unpacked_path.empty();
 
         if (target_traversed_in_reverse)
         {
-            id_vector = facade.GetUncompressedReverseGeometry(
+            id_range = facade.GetUncompressedReverseGeometryRange(
                 phantom_node_pair.target_phantom.packed_geometry_id);
 
-            weight_vector = facade.GetUncompressedReverseWeights(
+            weight_range = facade.GetUncompressedReverseWeightsRange(
                 phantom_node_pair.target_phantom.packed_geometry_id);
 
-            datasource_vector = facade.GetUncompressedReverseDatasources(
+            datasource_range = facade.GetUncompressedReverseDatasourcesRange(
                 phantom_node_pair.target_phantom.packed_geometry_id);
 
             if (is_local_path)
             {
-                start_index = weight_vector.size() -
+                start_index = weight_range.size() -
                               phantom_node_pair.source_phantom.fwd_segment_position - 1;
             }
             end_index =
-                weight_vector.size() - phantom_node_pair.target_phantom.fwd_segment_position - 1;
+                weight_range.size() - phantom_node_pair.target_phantom.fwd_segment_position - 1;
         }
         else
         {
@@ -339,13 +342,13 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
             }
             end_index = phantom_node_pair.target_phantom.fwd_segment_position;
 
-            id_vector = facade.GetUncompressedForwardGeometry(
+            id_range = facade.GetUncompressedForwardGeometryRange(
                 phantom_node_pair.target_phantom.packed_geometry_id);
 
-            weight_vector = facade.GetUncompressedForwardWeights(
+            weight_range = facade.GetUncompressedForwardWeightsRange(
                 phantom_node_pair.target_phantom.packed_geometry_id);
 
-            datasource_vector = facade.GetUncompressedForwardDatasources(
+            datasource_range = facade.GetUncompressedForwardDatasourcesRange(
                 phantom_node_pair.target_phantom.packed_geometry_id);
         }
 
@@ -359,18 +362,18 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         for (std::size_t segment_idx = start_index; segment_idx != end_index;
              (start_index < end_index ? ++segment_idx : --segment_idx))
         {
-            BOOST_ASSERT(segment_idx < id_vector.size() - 1);
+            BOOST_ASSERT(segment_idx < id_range.size() - 1);
             BOOST_ASSERT(phantom_node_pair.target_phantom.forward_travel_mode > 0);
             unpacked_path.push_back(PathData{
-                id_vector[start_index < end_index ? segment_idx + 1 : segment_idx - 1],
+                id_range[start_index < end_index ? segment_idx + 1 : segment_idx - 1],
                 phantom_node_pair.target_phantom.name_id,
-                weight_vector[segment_idx],
+                weight_range[segment_idx],
                 extractor::guidance::TurnInstruction::NO_TURN(),
                 {{0, INVALID_LANEID}, INVALID_LANE_DESCRIPTIONID},
                 target_traversed_in_reverse ? phantom_node_pair.target_phantom.backward_travel_mode
                                             : phantom_node_pair.target_phantom.forward_travel_mode,
                 INVALID_ENTRY_CLASSID,
-                datasource_vector[segment_idx],
+                datasource_range[segment_idx],
                 util::guidance::TurnBearing(0),
                 util::guidance::TurnBearing(0)});
         }
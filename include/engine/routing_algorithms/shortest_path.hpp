@@ -7,6 +7,7 @@
 
 #include "engine/search_engine_data.hpp"
 #include "util/integer_range.hpp"
+#include "util/metrics.hpp"
 
 #include <boost/assert.hpp>
 #include <boost/optional.hpp>
@@ -257,6 +258,7 @@ class ShortestPathRouting final
                     const int shortest_path_length,
                     InternalRouteResult &raw_route_data) const
     {
+        util::metrics::ScopedStage unpacking_stage(util::metrics::Stage::Unpacking);
         raw_route_data.unpacked_path_segments.resize(packed_leg_begin.size() - 1);
 
         raw_route_data.shortest_path_length = shortest_path_length;
@@ -6,6 +6,8 @@
 #include "util/binary_heap.hpp"
 #include "util/typedefs.hpp"
 
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -19,9 +21,11 @@ struct HeapData
 
 struct SearchEngineData
 {
-    using QueryHeap =
-        util::BinaryHeap<NodeID, NodeID, int, HeapData, util::UnorderedMapStorage<NodeID, int>>;
+    using QueryHeap = util::
+        BinaryHeap<NodeID, NodeID, int, HeapData, util::GenerationArrayStorage<NodeID, NodeID>>;
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
+    using SweepWeights = std::vector<EdgeWeight>;
+    using SweepWeightsPtr = boost::thread_specific_ptr<SweepWeights>;
 
     static SearchEngineHeapPtr forward_heap_1;
     static SearchEngineHeapPtr reverse_heap_1;
@@ -29,12 +33,18 @@ struct SearchEngineData
     static SearchEngineHeapPtr reverse_heap_2;
     static SearchEngineHeapPtr forward_heap_3;
     static SearchEngineHeapPtr reverse_heap_3;
+    static SweepWeightsPtr sweep_weights;
 
+    // Heaps are sized for the graph they were created for. If the number of nodes grows
+    // (e.g. after switching to a new dataset) they are re-allocated instead of cleared.
     void InitializeOrClearFirstThreadLocalStorage(const unsigned number_of_nodes);
 
     void InitializeOrClearSecondThreadLocalStorage(const unsigned number_of_nodes);
 
     void InitializeOrClearThirdThreadLocalStorage(const unsigned number_of_nodes);
+
+    // Resets all weights of the downward sweep to INVALID_EDGE_WEIGHT
+    void InitializeOrClearSweepThreadLocalStorage(const unsigned number_of_nodes);
 };
 }
 }
@@ -69,16 +69,22 @@ class TurnLaneHandler
     typedef std::vector<TurnLaneData> LaneDataVector;
 
     TurnLaneHandler(const util::NodeBasedDynamicGraph &node_based_graph,
-                    std::vector<std::uint32_t> &turn_lane_offsets,
-                    std::vector<TurnLaneType::Mask> &turn_lane_masks,
-                    LaneDescriptionMap &lane_description_map,
-                    const TurnAnalysis &turn_analysis,
-                    util::guidance::LaneDataIdMap &id_map);
+                    const std::vector<std::uint32_t> &turn_lane_offsets,
+                    const std::vector<TurnLaneType::Mask> &turn_lane_masks,
+                    const LaneDescriptionMap &lane_description_map,
+                    const TurnAnalysis &turn_analysis);
 
     ~TurnLaneHandler();
 
+    // Safe to call concurrently with different output maps. Lane data gets ids in `id_map`,
+    // combined lane descriptions of sliproads that are not in the lane description map of the
+    // handler are added to `new_lane_descriptions` with ids following the ones of that map.
     OSRM_ATTR_WARN_UNUSED
-    Intersection assignTurnLanes(const NodeID at, const EdgeID via_edge, Intersection intersection);
+    Intersection assignTurnLanes(const NodeID at,
+                                 const EdgeID via_edge,
+                                 Intersection intersection,
+                                 util::guidance::LaneDataIdMap &id_map,
+                                 LaneDescriptionMap &new_lane_descriptions) const;
 
   private:
     mutable std::atomic<std::size_t> count_handled;
@@ -86,11 +92,10 @@ class TurnLaneHandler
     // we need to be able to look at previous intersections to, in some cases, find the correct turn
     // lanes for a turn
     const util::NodeBasedDynamicGraph &node_based_graph;
-    std::vector<std::uint32_t> &turn_lane_offsets;
-    std::vector<TurnLaneType::Mask> &turn_lane_masks;
-    LaneDescriptionMap &lane_description_map;
+    const std::vector<std::uint32_t> &turn_lane_offsets;
+    const std::vector<TurnLaneType::Mask> &turn_lane_masks;
+    const LaneDescriptionMap &lane_description_map;
     const TurnAnalysis &turn_analysis;
-    util::guidance::LaneDataIdMap &id_map;
 
     // Find out which scenario we have to handle
     TurnLaneScenario deduceScenario(const NodeID at,
@@ -103,7 +108,7 @@ class TurnLaneHandler
                                     EdgeID &previous_id,
                                     Intersection &previous_intersection,
                                     LaneDataVector &previous_lane_data,
-                                    LaneDescriptionID &previous_description_id);
+                                    LaneDescriptionID &previous_description_id) const;
 
     // check whether we can handle an intersection
     bool isSimpleIntersection(const LaneDataVector &turn_lane_data,
@@ -113,7 +118,8 @@ class TurnLaneHandler
     OSRM_ATTR_WARN_UNUSED
     Intersection simpleMatchTuplesToTurns(Intersection intersection,
                                           const LaneDataVector &lane_data,
-                                          const LaneDescriptionID lane_string_id);
+                                          const LaneDescriptionID lane_string_id,
+                                          util::guidance::LaneDataIdMap &id_map) const;
 
     // partition lane data into lane data relevant at current turn and at next turn
     OSRM_ATTR_WARN_UNUSED
@@ -127,7 +133,9 @@ class TurnLaneHandler
     Intersection handleSliproadTurn(Intersection intersection,
                                     const LaneDescriptionID lane_description_id,
                                     LaneDataVector lane_data,
-                                    const Intersection &previous_intersection);
+                                    const Intersection &previous_intersection,
+                                    util::guidance::LaneDataIdMap &id_map,
+                                    LaneDescriptionMap &new_lane_descriptions) const;
 
     // get the lane data for an intersection
     void extractLaneData(const EdgeID via_edge,
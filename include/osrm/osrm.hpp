@@ -44,6 +44,9 @@ using engine::api::NearestParameters;
 using engine::api::TripParameters;
 using engine::api::MatchParameters;
 using engine::api::TileParameters;
+using engine::api::IsochroneParameters;
+using engine::api::BatchRouteParameters;
+using engine::api::BatchNearestParameters;
 
 /**
  * Represents a Open Source Routing Machine with access to its services.
@@ -56,6 +59,9 @@ using engine::api::TileParameters;
  *  - Trip: shortest round trip between coordinates
  *  - Match: snaps noisy coordinate traces to the road network
  *  - Tile: vector tiles with internal graph representation
+ *  - Isochrone: road network reachable from a coordinate within a duration
+ *  - BatchRoute: shortest paths of many independent source and destination pairs
+ *  - BatchNearest: nearest street segments of many coordinates
  *
  *  All services take service-specific parameters, fill a JSON object, and return a status code.
  */
@@ -85,6 +91,18 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
 
+    /**
+     * Shortest path queries for coordinates, encoded as protobuf message.
+     *
+     * Steps and annotations are not available, see docs/http.md for the message schema.
+     *
+     * \param parameters route query specific parameters
+     * \param result buffer the protobuf response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status and RouteParameters
+     */
+    Status Route(const RouteParameters &parameters, std::string &result) const;
+
     /**
      * Distance tables for coordinates.
      *
@@ -94,6 +112,31 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
 
+    /**
+     * Distance tables for coordinates, serialized directly as JSON text.
+     *
+     * Same response as above without building a json::Object first, which is considerably
+     * faster for large tables.
+     *
+     * \param parameters table query specific parameters
+     * \param result writer the JSON response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status, TableParameters and json::Writer
+     */
+    Status Table(const TableParameters &parameters, json::Writer &result) const;
+
+    /**
+     * Distance tables for coordinates, encoded as protobuf message.
+     *
+     * The durations are written as one packed array, see docs/http.md for the message schema.
+     *
+     * \param parameters table query specific parameters
+     * \param result buffer the protobuf response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status and TableParameters
+     */
+    Status Table(const TableParameters &parameters, std::string &result) const;
+
     /**
      * Nearest street segment for coordinate.
      *
@@ -121,6 +164,28 @@ class OSRM final
      */
     Status Match(const MatchParameters &parameters, json::Object &result) const;
 
+    /**
+     * Match: snaps noisy coordinate traces to the road network, serialized directly as JSON text
+     *
+     * \param parameters match query specific parameters
+     * \param result writer the JSON response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status, MatchParameters and json::Writer
+     */
+    Status Match(const MatchParameters &parameters, json::Writer &result) const;
+
+    /**
+     * Match: snaps noisy coordinate traces to the road network, encoded as protobuf message.
+     *
+     * Steps and annotations are not available, see docs/http.md for the message schema.
+     *
+     * \param parameters match query specific parameters
+     * \param result buffer the protobuf response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status and MatchParameters
+     */
+    Status Match(const MatchParameters &parameters, std::string &result) const;
+
     /**
      * Tile: vector tiles with internal graph representation
      *
@@ -130,6 +195,59 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * Isochrone: road network reachable from a coordinate within a duration
+     *
+     * \param parameters isochrone query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, IsochroneParameters and json::Object
+     */
+    Status Isochrone(const IsochroneParameters &parameters, json::Object &result) const;
+
+    /**
+     * BatchRoute: shortest paths of many independent source and destination pairs
+     *
+     * The routes are searched in parallel, coordinates used by several pairs are snapped once.
+     *
+     * \param parameters batch route query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, BatchRouteParameters and json::Object
+     */
+    Status BatchRoute(const BatchRouteParameters &parameters, json::Object &result) const;
+
+    /**
+     * BatchRoute: shortest paths of many independent source and destination pairs, serialized
+     * directly as JSON text
+     *
+     * \param parameters batch route query specific parameters
+     * \param result writer the JSON response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status, BatchRouteParameters and json::Writer
+     */
+    Status BatchRoute(const BatchRouteParameters &parameters, json::Writer &result) const;
+
+    /**
+     * BatchNearest: nearest street segments of many coordinates
+     *
+     * The coordinates are snapped in parallel, in the order of their Hilbert values.
+     *
+     * \param parameters batch nearest query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, BatchNearestParameters and json::Object
+     */
+    Status BatchNearest(const BatchNearestParameters &parameters, json::Object &result) const;
+
+    /**
+     * BatchNearest: nearest street segments of many coordinates, serialized directly as JSON
+     * text
+     *
+     * \param parameters batch nearest query specific parameters
+     * \param result writer the JSON response is written to
+     * \return Status indicating success for the query or failure
+     * \see Status, BatchNearestParameters and json::Writer
+     */
+    Status BatchNearest(const BatchNearestParameters &parameters, json::Writer &result) const;
+
   private:
     std::unique_ptr<engine::Engine> engine_;
 };
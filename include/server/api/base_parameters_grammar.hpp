@@ -99,6 +99,9 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
                 base_parameters.bearings.push_back(std::move(bearing));
             };
 
+        format_type.add("json", engine::api::BaseParameters::OutputFormatType::JSON)(
+            "pbf", engine::api::BaseParameters::OutputFormatType::PBF);
+
         polyline_chars = qi::char_("a-zA-Z0-9_.--[]{}@?|\\%~`^");
         base64_char = qi::char_("a-zA-Z0-9--_=");
         unlimited_rule = qi::lit("unlimited")[qi::_val = std::numeric_limits<double>::infinity()];
@@ -149,10 +152,15 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
             qi::lit("bearings=") >
             (-(qi::short_ > ',' > qi::short_))[ph::bind(add_bearing, qi::_r1, qi::_1)] % ';';
 
-        base_rule = radiuses_rule(qi::_r1)   //
-                    | hints_rule(qi::_r1)    //
-                    | bearings_rule(qi::_r1) //
-                    | generate_hints_rule(qi::_r1);
+        format_rule =
+            qi::lit("format=") >
+            format_type[ph::bind(&engine::api::BaseParameters::format, qi::_r1) = qi::_1];
+
+        base_rule = radiuses_rule(qi::_r1)         //
+                    | hints_rule(qi::_r1)          //
+                    | bearings_rule(qi::_r1)       //
+                    | generate_hints_rule(qi::_r1) //
+                    | format_rule(qi::_r1);
     }
 
   protected:
@@ -165,6 +173,7 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, Signature> hints_rule;
 
     qi::rule<Iterator, Signature> generate_hints_rule;
+    qi::rule<Iterator, Signature> format_rule;
 
     qi::rule<Iterator, osrm::engine::Bearing()> bearing_rule;
     qi::rule<Iterator, osrm::util::Coordinate()> location_rule;
@@ -173,6 +182,7 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, unsigned char()> base64_char;
     qi::rule<Iterator, std::string()> polyline_chars;
     qi::rule<Iterator, double()> unlimited_rule;
+    qi::symbols<char, engine::api::BaseParameters::OutputFormatType> format_type;
     qi::real_parser<double, json_policy> double_;
 };
 }
@@ -0,0 +1,24 @@
+#ifndef BATCH_NEAREST_PARAMETERS_GRAMMAR_HPP
+#define BATCH_NEAREST_PARAMETERS_GRAMMAR_HPP
+
+#include "server/api/nearest_parameter_grammar.hpp"
+#include "engine/api/batch_nearest_parameters.hpp"
+
+#include <string>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+// The batch nearest service takes the options of the nearest service
+template <typename Iterator = std::string::iterator>
+using BatchNearestParametersGrammar =
+    NearestParametersGrammar<Iterator, void(engine::api::BatchNearestParameters &)>;
+}
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef COMPRESSION_POOL_HPP
+#define COMPRESSION_POOL_HPP
+
+#include "server/http/compression_type.hpp"
+#include "util/log.hpp"
+
+#include <boost/asio.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+
+/// Compresses replies on dedicated worker threads, so large responses do not block the I/O
+/// threads that serve the other connections.
+class CompressionPool
+{
+  public:
+    /// level: zlib compression level from 1 (fastest) to 9 (smallest)
+    /// min_size: replies smaller than this are sent uncompressed
+    CompressionPool(const unsigned num_threads, const int level, const std::size_t min_size);
+    ~CompressionPool();
+
+    CompressionPool(const CompressionPool &) = delete;
+    CompressionPool &operator=(const CompressionPool &) = delete;
+
+    bool ShouldCompress(const http::compression_type compression_type,
+                        const std::vector<char> &content) const
+    {
+        return compression_type != http::no_compression && content.size() >= min_size;
+    }
+
+    /// Compresses input into output on a worker thread and calls handler afterwards from the
+    /// same thread. Both buffers need to stay valid and untouched until the handler is called.
+    /// The handler gets the compression that was applied, no_compression if it failed and the
+    /// input should be sent as is.
+    template <typename Handler>
+    void Compress(const std::vector<char> &input,
+                  const http::compression_type compression_type,
+                  std::vector<char> &output,
+                  Handler handler)
+    {
+        const auto level = compression_level;
+        service.post([&input, compression_type, &output, handler, level]() mutable {
+            // an exception escaping here would terminate the whole server
+            try
+            {
+                Compress(input, compression_type, level, output);
+            }
+            catch (const std::exception &exception)
+            {
+                util::Log(logWARNING) << "Sending reply uncompressed: " << exception.what();
+                handler(http::no_compression);
+                return;
+            }
+            handler(compression_type);
+        });
+    }
+
+    /// Compresses input in one pass directly into output, reusing its memory.
+    /// Throws if zlib fails.
+    static void Compress(const std::vector<char> &input,
+                         const http::compression_type compression_type,
+                         const int level,
+                         std::vector<char> &output);
+
+  private:
+    boost::asio::io_service service;
+    std::unique_ptr<boost::asio::io_service::work> work;
+    std::vector<std::thread> threads;
+    const int compression_level;
+    const std::size_t min_size;
+};
+}
+}
+
+#endif // COMPRESSION_POOL_HPP
@@ -0,0 +1,58 @@
+#ifndef COMPUTE_POOL_HPP
+#define COMPUTE_POOL_HPP
+
+#include "util/metrics.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+
+/// Runs requests on dedicated threads, separate from the threads doing socket I/O.
+///
+/// Every service has its own bounded queue and idle workers take requests from the queues in
+/// turn, so a burst of slow requests of one service (e.g. match) does not delay the others.
+/// Requests for a service with a full queue are rejected and should be answered with 503.
+/// Queues exist only for the registered services, all requests for unknown services share one
+/// queue so arbitrary request paths can neither bypass the limit nor add queues.
+class ComputePool
+{
+  public:
+    using Task = std::function<void()>;
+
+    ComputePool(const unsigned num_threads, const std::size_t max_queue_size);
+    ~ComputePool();
+
+    ComputePool(const ComputePool &) = delete;
+    ComputePool &operator=(const ComputePool &) = delete;
+
+    /// Queues the task for the given service, returns false if its queue is full.
+    /// INVALID_SERVICE selects the shared queue of unknown services.
+    bool Submit(const util::metrics::ServiceID service, Task task);
+
+  private:
+    void Work();
+
+    std::mutex mutex;
+    std::condition_variable task_available;
+    // one queue per registered service, the last one is shared by all unknown services
+    std::vector<std::deque<Task>> queues;
+    std::size_t num_queued;
+    // index of the queue the last task was taken from
+    std::size_t last_queue;
+    bool stopping;
+    const std::size_t max_queue_size;
+    std::vector<std::thread> threads;
+};
+}
+}
+
+#endif // COMPUTE_POOL_HPP
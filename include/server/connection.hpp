@@ -6,11 +6,14 @@
 #include "server/http/request.hpp"
 #include "server/request_parser.hpp"
 
+#include "util/metrics.hpp"
+
 #include <boost/array.hpp>
 #include <boost/asio.hpp>
 #include <boost/config.hpp>
 #include <boost/version.hpp>
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -31,13 +34,27 @@ namespace osrm
 namespace server
 {
 
+class CompressionPool;
+class ComputePool;
 class RequestHandler;
 
 /// Represents a single connection from a client.
+/// Persistent connections serve requests one after another, pipelined requests that arrive
+/// in the same read are answered in order. Request, reply and output buffers are reused.
+/// Requests are computed on the compute pool, the connection only does the socket I/O.
+/// A request has to arrive completely within a fixed deadline that starts with its first
+/// bytes, between requests the connection is closed after keepalive_timeout idle seconds.
 class Connection : public std::enable_shared_from_this<Connection>
 {
   public:
-    explicit Connection(boost::asio::io_service &io_service, RequestHandler &handler);
+    /// keepalive_timeout: seconds to wait for the next request after a reply before closing
+    /// keepalive_max_requests: number of requests served before closing, 1 disables keep-alive
+    explicit Connection(boost::asio::io_service &io_service,
+                        RequestHandler &handler,
+                        ComputePool &compute_pool,
+                        CompressionPool &compression_pool,
+                        const unsigned keepalive_timeout,
+                        const unsigned keepalive_max_requests);
     Connection(const Connection &) = delete;
     Connection &operator=(const Connection &) = delete;
 
@@ -47,24 +64,58 @@ class Connection : public std::enable_shared_from_this<Connection>
     void start();
 
   private:
+    /// Wait for more data of the current or the next request.
+    void read();
+
     void handle_read(const boost::system::error_code &e, std::size_t bytes_transferred);
 
+    /// Parse the given data and answer the request once it is complete.
+    void process(char *begin, char *end);
+
+    /// Called on the strand once the reply is computed, compresses it if requested.
+    void handle_response(const http::compression_type compression_type);
+
+    /// Send the reply, compressed_output holds the content unless compression_type is
+    /// no_compression.
+    void write(const http::compression_type compression_type);
+
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
-    std::vector<char> compress_buffers(const std::vector<char> &uncompressed_data,
-                                       const http::compression_type compression_type);
+    /// Close connections that did not send a request in time.
+    void handle_timeout(const boost::system::error_code &e);
+
+    /// Close the connection if the timer is not cancelled or re-armed within the given seconds.
+    void arm_timer(const long seconds);
+
+    void cancel_timer();
 
     boost::asio::io_service::strand strand;
     boost::asio::ip::tcp::socket TCP_socket;
+    boost::asio::deadline_timer timer;
     RequestHandler &request_handler;
+    ComputePool &compute_pool;
+    CompressionPool &compression_pool;
     RequestParser request_parser;
     boost::array<char, 8192> incoming_data_buffer;
+    // unparsed part of incoming_data_buffer that belongs to pipelined requests
+    char *pending_begin;
+    char *pending_end;
     http::request current_request;
     http::reply current_reply;
     std::vector<char> compressed_output;
-    // Header compression_header;
     std::vector<boost::asio::const_buffer> output_buffer;
+    // service of the current request and when its compression was queued, for the metrics
+    util::metrics::ServiceID service;
+    std::chrono::steady_clock::time_point compression_start;
+
+    const unsigned keepalive_timeout;
+    const unsigned keepalive_max_requests;
+    unsigned processed_requests;
+    bool keep_alive;
+    // the first bytes of the current request were received and its deadline is running
+    bool reading_request;
+    bool timer_armed;
 };
 }
 }
@@ -18,6 +18,18 @@ struct request
     std::string referrer;
     std::string agent;
     boost::asio::ip::address endpoint;
+    // HTTP/1.1 requests are persistent unless they send 'Connection: close', HTTP/1.0 requests
+    // need to ask for it with 'Connection: keep-alive'
+    bool keep_alive = false;
+
+    // Resets the request for the next one on the same connection, keeps allocated memory
+    void clear()
+    {
+        uri.clear();
+        referrer.clear();
+        agent.clear();
+        keep_alive = false;
+    }
 };
 }
 }
@@ -26,10 +26,14 @@ class RequestHandler
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler);
 
+    /// Only every sample_rate-th request of a thread is written to the access log
+    void SetAccessLogSampleRate(const unsigned sample_rate);
+
     void HandleRequest(const http::request &current_request, http::reply &current_reply);
 
   private:
     std::unique_ptr<ServiceHandlerInterface> service_handler;
+    unsigned access_log_sample_rate = 1;
 };
 }
 }
@@ -28,9 +28,14 @@ class RequestParser
         indeterminate
     };
 
-    std::tuple<RequestStatus, http::compression_type>
+    // Consumes input until a request is complete or invalid. The returned pointer is the first
+    // character that was not consumed, anything up to end belongs to the next (pipelined) request.
+    std::tuple<RequestStatus, http::compression_type, char *>
     parse(http::request &current_request, char *begin, char *end);
 
+    // Prepares the parser for the next request on the same connection
+    void reset();
+
   private:
     RequestStatus consume(http::request &current_request, const char input);
 
@@ -69,6 +74,9 @@ class RequestParser
 
     http::header current_header;
     http::compression_type selected_compression;
+    unsigned http_version_major;
+    unsigned http_version_minor;
+    bool keep_alive;
 };
 }
 }
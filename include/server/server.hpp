@@ -1,6 +1,8 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
 
+#include "server/compression_pool.hpp"
+#include "server/compute_pool.hpp"
 #include "server/connection.hpp"
 #include "server/request_handler.hpp"
 #include "server/service_handler.hpp"
@@ -33,18 +35,46 @@ class Server
 {
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
-    static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    static std::shared_ptr<Server> CreateServer(std::string &ip_address,
+                                                int ip_port,
+                                                unsigned requested_num_threads,
+                                                unsigned io_threads,
+                                                std::size_t max_queue_size,
+                                                unsigned keepalive_timeout,
+                                                unsigned keepalive_max_requests,
+                                                unsigned compression_threads,
+                                                int compression_level,
+                                                std::size_t compression_min_size)
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+        return std::make_shared<Server>(ip_address,
+                                        ip_port,
+                                        real_num_threads,
+                                        io_threads,
+                                        max_queue_size,
+                                        keepalive_timeout,
+                                        keepalive_max_requests,
+                                        compression_threads,
+                                        compression_level,
+                                        compression_min_size);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
-        : thread_pool_size(thread_pool_size), acceptor(io_service),
-          new_connection(std::make_shared<Connection>(io_service, request_handler))
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned compute_threads,
+                    const unsigned io_threads,
+                    const std::size_t max_queue_size,
+                    const unsigned keepalive_timeout,
+                    const unsigned keepalive_max_requests,
+                    const unsigned compression_threads,
+                    const int compression_level,
+                    const std::size_t compression_min_size)
+        : io_threads(io_threads), keepalive_timeout(keepalive_timeout),
+          keepalive_max_requests(keepalive_max_requests),
+          compression_pool(compression_threads, compression_level, compression_min_size),
+          acceptor(io_service), compute_pool(compute_threads, max_queue_size)
     {
         const auto port_string = std::to_string(port);
 
@@ -63,6 +93,12 @@ class Server
 
         util::Log() << "Listening on: " << acceptor.local_endpoint();
 
+        new_connection = std::make_shared<Connection>(io_service,
+                                                      request_handler,
+                                                      compute_pool,
+                                                      compression_pool,
+                                                      keepalive_timeout,
+                                                      keepalive_max_requests);
         acceptor.async_accept(
             new_connection->socket(),
             boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
@@ -71,7 +107,7 @@ class Server
     void Run()
     {
         std::vector<std::shared_ptr<std::thread>> threads;
-        for (unsigned i = 0; i < thread_pool_size; ++i)
+        for (unsigned i = 0; i < io_threads; ++i)
         {
             std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
                 boost::bind(&boost::asio::io_service::run, &io_service));
@@ -90,24 +126,40 @@ class Server
         request_handler.RegisterServiceHandler(std::move(service_handler_));
     }
 
+    void SetAccessLogSampleRate(const unsigned sample_rate)
+    {
+        request_handler.SetAccessLogSampleRate(sample_rate);
+    }
+
   private:
     void HandleAccept(const boost::system::error_code &e)
     {
         if (!e)
         {
             new_connection->start();
-            new_connection = std::make_shared<Connection>(io_service, request_handler);
+            new_connection = std::make_shared<Connection>(io_service,
+                                                          request_handler,
+                                                          compute_pool,
+                                                          compression_pool,
+                                                          keepalive_timeout,
+                                                          keepalive_max_requests);
             acceptor.async_accept(
                 new_connection->socket(),
                 boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
         }
     }
 
-    unsigned thread_pool_size;
+    unsigned io_threads;
+    unsigned keepalive_timeout;
+    unsigned keepalive_max_requests;
     boost::asio::io_service io_service;
+    // destroyed before the io_service, pending compressions post their handlers to it
+    CompressionPool compression_pool;
     boost::asio::ip::tcp::acceptor acceptor;
     std::shared_ptr<Connection> new_connection;
     RequestHandler request_handler;
+    // destroyed first, running requests use the request handler and post to the io_service
+    ComputePool compute_pool;
 };
 }
 }
@@ -20,7 +20,9 @@ namespace service
 class BaseService
 {
   public:
-    using ResultT = mapbox::util::variant<util::json::Object, std::string>;
+    // Either a JSON object, a binary response (a vector tile or a result in the protobuf
+    // format) or JSON text that was already serialized by a util::json::Writer
+    using ResultT = mapbox::util::variant<util::json::Object, std::string, std::vector<char>>;
 
     BaseService(OSRM &routing_machine) : routing_machine(routing_machine) {}
     virtual ~BaseService() = default;
@@ -6,6 +6,7 @@
 #include "osrm/osrm.hpp"
 
 #include <unordered_map>
+#include <vector>
 
 namespace osrm
 {
@@ -29,6 +30,8 @@ class ServiceHandlerInterface
     virtual ~ServiceHandlerInterface() {}
     virtual engine::Status RunQuery(api::ParsedURL parsed_url,
                                     service::BaseService::ResultT &result) = 0;
+    /// Writes the latency histograms of all services in the Prometheus text format
+    virtual void RenderMetrics(std::vector<char> &output) = 0;
 };
 
 class ServiceHandler final : public ServiceHandlerInterface
@@ -38,6 +41,7 @@ class ServiceHandler final : public ServiceHandlerInterface
     using ResultT = service::BaseService::ResultT;
 
     virtual engine::Status RunQuery(api::ParsedURL parsed_url, ResultT &result) override;
+    virtual void RenderMetrics(std::vector<char> &output) override;
 
   private:
     std::unordered_map<std::string, std::unique_ptr<service::BaseService>> service_map;
@@ -154,6 +154,13 @@ class FileReader
         return length;
     }
 
+    /* Number of bytes between the current position and the end of the file */
+    std::size_t RemainingSize()
+    {
+        const std::size_t current_pos = input_stream.tellg();
+        return Size() - current_pos;
+    }
+
     std::vector<std::string> ReadLines()
     {
         std::vector<std::string> result;
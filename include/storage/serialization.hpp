@@ -2,6 +2,7 @@
 #define OSRM_STORAGE_SERIALIZATION_HPP_
 
 #include "contractor/query_edge.hpp"
+#include "contractor/sweep_edge.hpp"
 #include "extractor/extractor.hpp"
 #include "extractor/original_edge_data.hpp"
 #include "extractor/query_node.hpp"
@@ -70,6 +71,71 @@ inline void readHSGR(io::FileReader &input_file,
     input_file.ReadInto(edge_buffer, number_of_edges);
 }
 
+// Marks the downward sweep section after the graph data of a `.hsgr` file ("OSRMSWP1")
+const constexpr std::uint64_t HSGR_SWEEP_MARKER = 0x315057534d52534f;
+
+struct HSGRSweepHeader
+{
+    std::uint64_t number_of_sweep_nodes;
+    std::uint64_t number_of_sweep_edges;
+};
+
+// The sweep node array has a sentinel, the position array has one entry per node
+inline std::uint64_t sweepPositionCount(const HSGRSweepHeader &header)
+{
+    return header.number_of_sweep_nodes > 0 ? header.number_of_sweep_nodes - 1 : 0;
+}
+
+// Reads the number of nodes and edges of the downward sweep stored after the graph data of a
+// `.hsgr` file. Needs to be called after readHSGR() or after skipping the graph data.
+// Files written before the sweep was added end after the graph data and have an empty sweep.
+inline HSGRSweepHeader readHSGRSweepHeader(io::FileReader &input_file)
+{
+    HSGRSweepHeader header{0, 0};
+    if (input_file.RemainingSize() == 0)
+    {
+        return header;
+    }
+
+    std::uint64_t marker = 0;
+    input_file.ReadInto(marker);
+    if (marker != HSGR_SWEEP_MARKER)
+    {
+        throw util::exception("Unknown section after the graph data of the .hsgr file, run "
+                              "osrm-contract of this version" +
+                              SOURCE_REF);
+    }
+    input_file.ReadInto(header.number_of_sweep_nodes);
+    input_file.ReadInto(header.number_of_sweep_edges);
+
+    const auto expected_size = header.number_of_sweep_nodes * sizeof(contractor::SweepNode) +
+                               sweepPositionCount(header) * sizeof(NodeID) +
+                               header.number_of_sweep_edges * sizeof(contractor::SweepEdge);
+    if (input_file.RemainingSize() != expected_size)
+    {
+        throw util::exception("Size of the downward sweep does not match the .hsgr file" +
+                              SOURCE_REF);
+    }
+
+    BOOST_ASSERT_MSG(header.number_of_sweep_edges == 0 || header.number_of_sweep_nodes > 0,
+                     "sweep edges exist, but there are no sweep nodes");
+
+    return header;
+}
+
+// Reads the downward sweep of a `.hsgr` file into memory
+// Needs to be called after readHSGRSweepHeader() to get the correct offset in the stream
+inline void readHSGRSweep(io::FileReader &input_file,
+                          contractor::SweepNode *sweep_node_buffer,
+                          NodeID *sweep_position_buffer,
+                          contractor::SweepEdge *sweep_edge_buffer,
+                          const HSGRSweepHeader &header)
+{
+    input_file.ReadInto(sweep_node_buffer, header.number_of_sweep_nodes);
+    input_file.ReadInto(sweep_position_buffer, sweepPositionCount(header));
+    input_file.ReadInto(sweep_edge_buffer, header.number_of_sweep_edges);
+}
+
 // Loads datasource_indexes from .datasource_indexes into memory
 // Needs to be called after readElementCount() to get the correct offset in the stream
 inline void readDatasourceIndexes(io::FileReader &datasource_indexes_file,
@@ -1,6 +1,9 @@
 #ifndef SHARED_BARRIERS_HPP
 #define SHARED_BARRIERS_HPP
 
+#include "storage/shared_datatype.hpp"
+
+#include <boost/assert.hpp>
 #include <boost/interprocess/sync/named_sharable_mutex.hpp>
 #include <boost/interprocess/sync/named_upgradable_mutex.hpp>
 
@@ -15,7 +18,9 @@ struct SharedBarriers
     SharedBarriers()
         : current_region_mutex(boost::interprocess::open_or_create, "current_region"),
           region_1_mutex(boost::interprocess::open_or_create, "region_1"),
-          region_2_mutex(boost::interprocess::open_or_create, "region_2")
+          region_2_mutex(boost::interprocess::open_or_create, "region_2"),
+          weights_region_1_mutex(boost::interprocess::open_or_create, "weights_region_1"),
+          weights_region_2_mutex(boost::interprocess::open_or_create, "weights_region_2")
     {
     }
 
@@ -25,10 +30,55 @@ struct SharedBarriers
     }
     static void resetRegion1() { boost::interprocess::named_sharable_mutex::remove("region_1"); }
     static void resetRegion2() { boost::interprocess::named_sharable_mutex::remove("region_2"); }
+    static void resetWeightsRegion1()
+    {
+        boost::interprocess::named_sharable_mutex::remove("weights_region_1");
+    }
+    static void resetWeightsRegion2()
+    {
+        boost::interprocess::named_sharable_mutex::remove("weights_region_2");
+    }
+
+    static void resetRegion(const SharedDataType region)
+    {
+        switch (region)
+        {
+        case REGION_1:
+            resetRegion1();
+            break;
+        case REGION_2:
+            resetRegion2();
+            break;
+        case WEIGHTS_REGION_1:
+            resetWeightsRegion1();
+            break;
+        default:
+            BOOST_ASSERT(region == WEIGHTS_REGION_2);
+            resetWeightsRegion2();
+        }
+    }
+
+    boost::interprocess::named_sharable_mutex &GetRegionMutex(const SharedDataType region)
+    {
+        switch (region)
+        {
+        case REGION_1:
+            return region_1_mutex;
+        case REGION_2:
+            return region_2_mutex;
+        case WEIGHTS_REGION_1:
+            return weights_region_1_mutex;
+        default:
+            BOOST_ASSERT(region == WEIGHTS_REGION_2);
+            return weights_region_2_mutex;
+        }
+    }
 
     boost::interprocess::named_upgradable_mutex current_region_mutex;
     boost::interprocess::named_sharable_mutex region_1_mutex;
     boost::interprocess::named_sharable_mutex region_2_mutex;
+    boost::interprocess::named_sharable_mutex weights_region_1_mutex;
+    boost::interprocess::named_sharable_mutex weights_region_2_mutex;
 };
 }
 }
@@ -52,7 +52,11 @@ const constexpr char *block_id_to_name[] = {"NAME_OFFSETS",
                                             "POST_TURN_BEARING",
                                             "TURN_LANE_DATA",
                                             "LANE_DESCRIPTION_OFFSETS",
-                                            "LANE_DESCRIPTION_MASKS"};
+                                            "LANE_DESCRIPTION_MASKS",
+                                            "GRAPH_SWEEP_NODE_LIST",
+                                            "GRAPH_SWEEP_POSITION_LIST",
+                                            "GRAPH_SWEEP_EDGE_LIST",
+                                            "R_SEARCH_LEAVES"};
 
 struct DataLayout
 {
@@ -95,6 +99,10 @@ struct DataLayout
         TURN_LANE_DATA,
         LANE_DESCRIPTION_OFFSETS,
         LANE_DESCRIPTION_MASKS,
+        GRAPH_SWEEP_NODE_LIST,
+        GRAPH_SWEEP_POSITION_LIST,
+        GRAPH_SWEEP_EDGE_LIST,
+        R_SEARCH_LEAVES,
         NUM_BLOCKS
     };
 
@@ -189,6 +197,31 @@ struct DataLayout
 
         return (T *)ptr;
     }
+
+    // Blocks that osrm-contract rewrites when weights change. A weight update only replaces
+    // these and shares all other blocks with the dataset it is applied to.
+    static bool IsWeightBlock(BlockID bid)
+    {
+        switch (bid)
+        {
+        case GRAPH_NODE_LIST:
+        case GRAPH_EDGE_LIST:
+        case HSGR_CHECKSUM:
+        case GRAPH_SWEEP_NODE_LIST:
+        case GRAPH_SWEEP_POSITION_LIST:
+        case GRAPH_SWEEP_EDGE_LIST:
+        case CORE_MARKER:
+        case GEOMETRIES_FWD_WEIGHT_LIST:
+        case GEOMETRIES_REV_WEIGHT_LIST:
+        case DATASOURCES_LIST:
+        case DATASOURCE_NAME_DATA:
+        case DATASOURCE_NAME_OFFSETS:
+        case DATASOURCE_NAME_LENGTHS:
+            return true;
+        default:
+            return false;
+        }
+    }
 };
 
 enum SharedDataType
@@ -196,12 +229,16 @@ enum SharedDataType
     CURRENT_REGION,
     REGION_1,
     REGION_2,
+    WEIGHTS_REGION_1,
+    WEIGHTS_REGION_2,
     REGION_NONE
 };
 
 struct SharedDataTimestamp
 {
     SharedDataType region;
+    // region with the weight blocks replacing the ones in region, REGION_NONE if there is none
+    SharedDataType weights_region;
     unsigned timestamp;
 };
 
@@ -215,6 +252,10 @@ inline std::string regionToString(const SharedDataType region)
         return "REGION_1";
     case REGION_2:
         return "REGION_2";
+    case WEIGHTS_REGION_1:
+        return "WEIGHTS_REGION_1";
+    case WEIGHTS_REGION_2:
+        return "WEIGHTS_REGION_2";
     case REGION_NONE:
         return "REGION_NONE";
     default:
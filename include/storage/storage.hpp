@@ -55,6 +55,8 @@ class Storage
 
     void PopulateLayout(DataLayout &layout);
     void PopulateData(const DataLayout &layout, char *memory_ptr);
+    // Only populates the blocks for which DataLayout::IsWeightBlock is true
+    void PopulateWeightData(const DataLayout &layout, char *memory_ptr);
 
   private:
     StorageConfig config;
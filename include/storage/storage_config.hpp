@@ -36,7 +36,7 @@ namespace storage
 {
 
 /**
- * Configures OSRM's file storage paths.
+ * Configures OSRM's file storage paths and which of them are loaded into memory.
  *
  * \see OSRM, EngineConfig
  */
@@ -67,6 +67,14 @@ struct StorageConfig final
     boost::filesystem::path intersection_class_path;
     boost::filesystem::path turn_lane_data_path;
     boost::filesystem::path turn_lane_description_path;
+
+    // Copies the r-tree leaves into the data region instead of mapping them from
+    // file_index_path on demand
+    bool load_rtree_leaves = false;
+
+    // Only loads the blocks written by osrm-contract and publishes them together with all other
+    // blocks of the current dataset, see DataLayout::IsWeightBlock
+    bool update_weights = false;
 };
 }
 }
@@ -0,0 +1,68 @@
+#ifndef ASYNC_LOG_HPP
+#define ASYNC_LOG_HPP
+
+#include "util/log.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+/// Background writer for util::Log.
+///
+/// While an instance exists, finished log lines are pushed into a lock-free ring buffer of
+/// the logging thread instead of being written under the global log mutex. A writer thread
+/// drains the buffers of all threads. Lines that do not fit into a full buffer are dropped and
+/// counted, the writer reports the number of dropped lines periodically.
+///
+/// Only one instance may exist at a time, its destructor writes all buffered lines. It has to
+/// outlive all threads that log while it exists.
+class AsyncLog
+{
+  public:
+    /// capacity: lines buffered per thread, rounded up to a power of two
+    explicit AsyncLog(const std::size_t capacity);
+    ~AsyncLog();
+
+    AsyncLog(const AsyncLog &) = delete;
+    AsyncLog &operator=(const AsyncLog &) = delete;
+
+    /// The instance log lines are currently handed to, nullptr for synchronous logging
+    static AsyncLog *Current();
+
+    /// Queues the line for the writer thread, returns false if it was dropped
+    bool Push(const LogLevel level, std::string line);
+
+    /// Number of lines dropped so far because a buffer was full
+    std::uint64_t Dropped() const;
+
+  private:
+    class RingBuffer;
+
+    RingBuffer &GetThreadBuffer();
+    void Run();
+    void Drain();
+
+    const std::size_t capacity;
+    const std::uint64_t generation;
+    // guards buffers, taken by the writer and once per thread on its first log line
+    std::mutex mutex;
+    std::vector<std::shared_ptr<RingBuffer>> buffers;
+    std::atomic<std::uint64_t> dropped;
+    std::uint64_t reported_dropped;
+    std::atomic<bool> stopping;
+    std::thread writer;
+};
+}
+}
+
+#endif // ASYNC_LOG_HPP
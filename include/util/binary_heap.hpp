@@ -4,6 +4,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <type_traits>
@@ -84,6 +85,52 @@ template <typename NodeID, typename Key> class UnorderedMapStorage
     std::unordered_map<NodeID, Key> nodes;
 };
 
+// Preallocated position array for all nodes of the graph. Every cell is tagged with the
+// generation in which it was written, so Clear() only bumps the current generation instead
+// of touching the whole array. Stale cells are reported as not present by peek_index.
+template <typename NodeID, typename Key> class GenerationArrayStorage
+{
+  public:
+    explicit GenerationArrayStorage(size_t size)
+        : positions(size, std::numeric_limits<Key>::max()), generations(size, 0),
+          current_generation(1)
+    {
+    }
+
+    Key &operator[](const NodeID node)
+    {
+        BOOST_ASSERT(node < positions.size());
+        generations[node] = current_generation;
+        return positions[node];
+    }
+
+    Key peek_index(const NodeID node) const
+    {
+        BOOST_ASSERT(node < positions.size());
+        if (generations[node] != current_generation)
+        {
+            return std::numeric_limits<Key>::max();
+        }
+        return positions[node];
+    }
+
+    void Clear()
+    {
+        ++current_generation;
+        // on overflow old cells could alias the new generation, reset everything
+        if (0 == current_generation)
+        {
+            std::fill(generations.begin(), generations.end(), 0);
+            current_generation = 1;
+        }
+    }
+
+  private:
+    std::vector<Key> positions;
+    std::vector<std::uint32_t> generations;
+    std::uint32_t current_generation;
+};
+
 template <typename NodeID,
           typename Key,
           typename Weight,
@@ -99,7 +146,7 @@ class BinaryHeap
     using WeightType = Weight;
     using DataType = Data;
 
-    explicit BinaryHeap(size_t maxID) : node_index(maxID) { Clear(); }
+    explicit BinaryHeap(size_t maxID) : max_id(maxID), node_index(maxID) { Clear(); }
 
     void Clear()
     {
@@ -111,6 +158,9 @@ class BinaryHeap
 
     std::size_t Size() const { return (heap.size() - 1); }
 
+    // number of node ids the heap was allocated for
+    std::size_t MaxID() const { return max_id; }
+
     bool Empty() const { return 0 == Size(); }
 
     void Insert(NodeID node, Weight weight, const Data &data)
@@ -231,6 +281,7 @@ class BinaryHeap
         Weight weight;
     };
 
+    std::size_t max_id;
     std::vector<HeapNode> inserted_nodes;
     std::vector<HeapElement> heap;
     IndexStorage node_index;
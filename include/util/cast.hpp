@@ -1,6 +1,8 @@
 #ifndef CAST_HPP
 #define CAST_HPP
 
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -23,23 +25,107 @@ inline auto enum_to_underlying(Enumeration const value) ->
     return static_cast<typename std::underlying_type<Enumeration>::type>(value);
 }
 
-template <typename T, int Precision = 6> inline std::string to_string_with_precision(const T x)
+namespace detail
 {
-    static_assert(std::is_arithmetic<T>::value, "integral or floating point type required");
+template <int Exponent> struct pow10
+{
+    static constexpr std::int64_t value = 10 * pow10<Exponent - 1>::value;
+};
+
+template <> struct pow10<0>
+{
+    static constexpr std::int64_t value = 1;
+};
+}
+
+// Appends x in fixed point notation with at most Precision digits after the decimal point to a
+// container of chars, e.g. std::string or std::vector<char>.
+//
+// Javascript has no separation of float / int, digits without a '.' are integral typed
+// X.Y.0 -> X.Y
+// X.0 -> X
+//
+// Values that fit into 52 bit fixed point are formatted without going through a stream, with
+// the same round-half-to-even result as printf. Unlike printf, negative values that round to
+// zero are written as 0 instead of -0.
+template <int Precision = 6, typename OutputT>
+inline void append_with_precision(OutputT &output, const double x)
+{
+    static_assert(Precision > 0 && Precision < 16, "precision out of range");
+    constexpr std::int64_t scale = detail::pow10<Precision>::value;
+    // keeps the scaled value and the halfway points between integers representable as a double
+    constexpr double max_scaled = 4503599627370496.; // 2^52
 
-    std::ostringstream out;
-    out << std::fixed << std::setprecision(Precision) << x;
-    auto rv = out.str();
+    const double scaled = x * scale;
+    if (!(std::abs(scaled) < max_scaled))
+    {
+        // infinite, NaN or too large
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(Precision) << x;
+        auto rv = out.str();
+        // Note:
+        //  - assumes the locale to use '.' as digit separator
+        //  - this is not identical to:  trim_right_if(rv, is_any_of('0 .'))
+        boost::trim_right_if(rv, boost::is_any_of("0"));
+        boost::trim_right_if(rv, boost::is_any_of("."));
+        output.insert(output.end(), rv.begin(), rv.end());
+        return;
+    }
 
-    // Javascript has no separation of float / int, digits without a '.' are integral typed
-    // X.Y.0 -> X.Y
-    // X.0 -> X
-    boost::trim_right_if(rv, boost::is_any_of("0"));
-    boost::trim_right_if(rv, boost::is_any_of("."));
-    // Note:
-    //  - assumes the locale to use '.' as digit separator
-    //  - this is not identical to:  trim_right_if(rv, is_any_of('0 .'))
+    // Scaling may have rounded the value onto a halfway point, the exact error of the product
+    // decides in which direction to round in that case.
+    const double lower = std::floor(scaled);
+    const double remainder = scaled - lower;
+    bool round_up = remainder > 0.5;
+    if (remainder == 0.5)
+    {
+        const double error = std::fma(x, static_cast<double>(scale), -scaled);
+        round_up = error > 0 || (error == 0 && std::fmod(lower, 2.) != 0);
+    }
+    const std::int64_t fixed = static_cast<std::int64_t>(lower) + (round_up ? 1 : 0);
+    std::uint64_t integral = static_cast<std::uint64_t>(fixed < 0 ? -fixed : fixed);
+    std::uint64_t fraction = integral % scale;
+    integral /= scale;
+
+    // sign, 16 integral digits, '.' and the fraction
+    char buffer[2 + 16 + Precision];
+    char *const end = buffer + sizeof(buffer);
+    char *position = end;
+
+    int fraction_digits = Precision;
+    while (fraction_digits > 0 && fraction % 10 == 0)
+    {
+        fraction /= 10;
+        --fraction_digits;
+    }
+    if (fraction_digits > 0)
+    {
+        for (int digit = 0; digit < fraction_digits; ++digit)
+        {
+            *--position = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        *--position = '.';
+    }
+    do
+    {
+        *--position = static_cast<char>('0' + integral % 10);
+        integral /= 10;
+    } while (integral > 0);
+    if (fixed < 0)
+    {
+        *--position = '-';
+    }
+
+    output.insert(output.end(), position, end);
+}
+
+template <typename T, int Precision = 6> inline std::string to_string_with_precision(const T x)
+{
+    static_assert(std::is_arithmetic<T>::value, "integral or floating point type required");
 
+    std::string rv;
+    append_with_precision<Precision>(rv, static_cast<double>(x));
     return rv;
 }
 }
@@ -3,8 +3,12 @@
 
 #include "osrm/coordinate.hpp"
 
+#include <algorithm>
 #include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <numeric>
+#include <vector>
 
 namespace osrm
 {
@@ -69,6 +73,22 @@ inline std::uint64_t GetHilbertCode(const Coordinate &coordinate)
                             static_cast<std::int32_t>(90 * COORDINATE_PRECISION);
     return HilbertToLinear(x, y);
 }
+
+// Returns the indices of the coordinates in the order of their Hilbert values, so that
+// consecutive indices refer to nearby coordinates. Equal values keep their input order.
+inline std::vector<std::size_t> HilbertOrder(const std::vector<Coordinate> &coordinates)
+{
+    std::vector<std::uint64_t> codes(coordinates.size());
+    std::transform(coordinates.begin(), coordinates.end(), codes.begin(), GetHilbertCode);
+
+    std::vector<std::size_t> order(coordinates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&codes](const std::size_t lhs,
+                                                          const std::size_t rhs) {
+        return codes[lhs] < codes[rhs];
+    });
+    return order;
+}
 }
 }
 
@@ -84,15 +84,13 @@ struct ArrayRenderer
     void operator()(const String &string) const
     {
         out.push_back('\"');
-        const auto string_to_insert = escape_JSON(string.value);
-        out.insert(std::end(out), std::begin(string_to_insert), std::end(string_to_insert));
+        escape_JSON(string.value, out);
         out.push_back('\"');
     }
 
     void operator()(const Number &number) const
     {
-        const std::string number_string = cast::to_string_with_precision(number.value);
-        out.insert(out.end(), number_string.begin(), number_string.end());
+        cast::append_with_precision(out, number.value);
     }
 
     void operator()(const Object &object) const
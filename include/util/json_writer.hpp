@@ -0,0 +1,125 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include "util/cast.hpp"
+#include "util/json_renderer.hpp"
+#include "util/string_util.hpp"
+
+#include "osrm/json_container.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace json
+{
+
+/**
+ * Streaming JSON serializer.
+ *
+ * Writes JSON text directly into a character buffer, without building a json::Object tree
+ * first. Separators between values and members are inserted automatically, the caller is
+ * responsible for balancing Start/End calls and for writing a key before every object member.
+ *
+ * Parts of the response that are only available as json::Value can be embedded with
+ * WriteValue.
+ */
+class Writer
+{
+  public:
+    explicit Writer(std::vector<char> &out_) : out(out_), separator_pending(false) {}
+
+    void StartObject()
+    {
+        BeginValue();
+        out.push_back('{');
+        separator_pending = false;
+    }
+
+    void EndObject()
+    {
+        out.push_back('}');
+        separator_pending = true;
+    }
+
+    void StartArray()
+    {
+        BeginValue();
+        out.push_back('[');
+        separator_pending = false;
+    }
+
+    void EndArray()
+    {
+        out.push_back(']');
+        separator_pending = true;
+    }
+
+    // Keys are written verbatim and need to be valid JSON strings
+    void WriteKey(const char *key)
+    {
+        BeginValue();
+        out.push_back('\"');
+        out.insert(out.end(), key, key + std::strlen(key));
+        out.push_back('\"');
+        out.push_back(':');
+        separator_pending = false;
+    }
+
+    void WriteString(const std::string &value)
+    {
+        BeginValue();
+        out.push_back('\"');
+        escape_JSON(value, out);
+        out.push_back('\"');
+        separator_pending = true;
+    }
+
+    void WriteNumber(const double value)
+    {
+        BeginValue();
+        cast::append_with_precision(out, value);
+        separator_pending = true;
+    }
+
+    void WriteBool(const bool value) { WriteLiteral(value ? "true" : "false"); }
+
+    void WriteNull() { WriteLiteral("null"); }
+
+    void WriteValue(const Value &value)
+    {
+        BeginValue();
+        mapbox::util::apply_visitor(ArrayRenderer(out), value);
+        separator_pending = true;
+    }
+
+  private:
+    void BeginValue()
+    {
+        if (separator_pending)
+        {
+            out.push_back(',');
+        }
+    }
+
+    void WriteLiteral(const char *literal)
+    {
+        BeginValue();
+        out.insert(out.end(), literal, literal + std::strlen(literal));
+        separator_pending = true;
+    }
+
+    std::vector<char> &out;
+    // true if the last thing written was a complete value
+    bool separator_pending;
+};
+
+} // namespace json
+} // namespace util
+} // namespace osrm
+
+#endif // JSON_WRITER_HPP
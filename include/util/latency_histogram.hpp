@@ -0,0 +1,94 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace osrm
+{
+namespace util
+{
+
+/// Histogram of durations in microseconds with logarithmic buckets, each power of two is split
+/// into 8 linear sub-buckets which bounds the relative error to 12.5% (like HdrHistogram).
+///
+/// Only a single thread may record into a histogram, but any thread can read it concurrently:
+/// recording is a relaxed load and store without locks or read-modify-write instructions.
+class LatencyHistogram
+{
+  public:
+    static constexpr std::size_t SUB_BUCKET_BITS = 3;
+    static constexpr std::size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    // durations from 2^32 microseconds (about 71 minutes) on fall into the last bucket
+    static constexpr std::size_t MAX_MAGNITUDE = 32;
+    static constexpr std::size_t NUM_BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram()
+    {
+        for (auto &count : counts)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+        sum.store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    static std::size_t BucketIndex(const std::uint64_t microseconds)
+    {
+        if (microseconds < SUB_BUCKETS)
+        {
+            return static_cast<std::size_t>(microseconds);
+        }
+        if (microseconds >> MAX_MAGNITUDE)
+        {
+            return NUM_BUCKETS - 1;
+        }
+
+        std::size_t magnitude = SUB_BUCKET_BITS;
+        while (microseconds >> (magnitude + 1))
+        {
+            ++magnitude;
+        }
+        const auto sub_bucket = (microseconds >> (magnitude - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub_bucket;
+    }
+
+    /// Exclusive upper bound in microseconds of the values counted in the bucket
+    static std::uint64_t BucketUpperBound(const std::size_t bucket)
+    {
+        if (bucket < SUB_BUCKETS)
+        {
+            return bucket + 1;
+        }
+        const auto magnitude = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        const auto sub_bucket = bucket % SUB_BUCKETS;
+        return static_cast<std::uint64_t>(SUB_BUCKETS + sub_bucket + 1)
+               << (magnitude - SUB_BUCKET_BITS);
+    }
+
+    void Record(const std::uint64_t microseconds)
+    {
+        auto &count = counts[BucketIndex(microseconds)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum.store(sum.load(std::memory_order_relaxed) + microseconds, std::memory_order_relaxed);
+    }
+
+    std::uint64_t Count(const std::size_t bucket) const
+    {
+        return counts[bucket].load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t Sum() const { return sum.load(std::memory_order_relaxed); }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, NUM_BUCKETS> counts;
+    std::atomic<std::uint64_t> sum;
+};
+}
+}
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,116 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace metrics
+{
+
+/// Processing stages of a request that are timed separately
+enum class Stage : std::uint8_t
+{
+    Request,     // whole request in the request handler
+    ParseURL,    // url decoding and parsing
+    Snapping,    // phantom node lookup in the r-tree
+    Search,      // routing search, includes unpacking
+    Unpacking,   // unpacking the shortcuts of the found path
+    Guidance,    // assembling route legs, steps and annotations
+    Render,      // writing the response
+    Compression, // gzip/deflate, includes waiting for a compression thread
+    NUM_STAGES
+};
+
+/// Process wide event counters
+enum class Counter : std::uint8_t
+{
+    SnappingCacheHits,   // phantom node lookups answered from the snapping cache
+    SnappingCacheMisses, // phantom node lookups that had to query the r-tree
+    TableSweeps,         // table requests computed with the downward sweep
+    NUM_COUNTERS
+};
+
+using ServiceID = std::uint8_t;
+const constexpr ServiceID INVALID_SERVICE = 255;
+const constexpr std::size_t MAX_SERVICES = 16;
+
+/// Registers a service name for recording, call once per service before serving requests.
+/// Registering the same name again returns the same id.
+ServiceID RegisterService(const std::string &name);
+
+/// Returns INVALID_SERVICE for names that are not registered
+ServiceID FindService(const std::string &name);
+
+/// Adds the duration to the histogram of the current thread, no-op for INVALID_SERVICE
+void Record(const ServiceID service,
+            const Stage stage,
+            const std::chrono::steady_clock::duration duration);
+
+/// Adds value to the counter, safe to call from any thread
+void Increment(const Counter counter, const std::uint64_t value = 1);
+
+/// Current value of the counter
+std::uint64_t Get(const Counter counter);
+
+/// Service the stages on this thread are recorded for, INVALID_SERVICE if none
+ServiceID CurrentService();
+
+/// Sets the service stages are recorded for on this thread, e.g. while handling a request.
+/// Without a current service ScopedStage does nothing, so library users pay no timing cost.
+class ScopedService
+{
+  public:
+    explicit ScopedService(const ServiceID service);
+    ~ScopedService();
+
+    ScopedService(const ScopedService &) = delete;
+    ScopedService &operator=(const ScopedService &) = delete;
+
+  private:
+    ServiceID previous;
+};
+
+/// Records the time until the end of the scope for the current service of this thread
+class ScopedStage
+{
+  public:
+    explicit ScopedStage(const Stage stage) : service(CurrentService()), stage(stage)
+    {
+        if (service != INVALID_SERVICE)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedStage()
+    {
+        if (service != INVALID_SERVICE)
+        {
+            Record(service, stage, std::chrono::steady_clock::now() - start);
+        }
+    }
+
+    ScopedStage(const ScopedStage &) = delete;
+    ScopedStage &operator=(const ScopedStage &) = delete;
+
+  private:
+    const ServiceID service;
+    const Stage stage;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// Appends all non-empty histograms merged over all threads and all counters in the
+/// Prometheus text format
+void Render(std::vector<char> &output);
+}
+}
+}
+
+#endif // METRICS_HPP
@@ -24,12 +24,17 @@
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <limits>
 #include <memory>
 #include <queue>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // An extended alignment is implementation-defined, so use compiler attributes
@@ -47,14 +52,24 @@ namespace osrm
 namespace util
 {
 
+// Node layout of the trees built and loaded by the tools, set with ENABLE_COMPACT_RTREE
+#ifdef OSRM_COMPACT_RTREE
+const constexpr bool DEFAULT_QUANTIZED_CHILD_BOXES = true;
+#else
+const constexpr bool DEFAULT_QUANTIZED_CHILD_BOXES = false;
+#endif
+
 // Static RTree for serving nearest neighbour queries
 // All coordinates are pojected first to Web Mercator before the bounding boxes
 // are computed, this means the internal distance metric doesn not represent meters!
+// With QUANTIZED_CHILD_BOXES every tree node also stores the bounding boxes of its children,
+// so exploring a node does not touch the children themselves.
 template <class EdgeDataT,
           class CoordinateListT = std::vector<Coordinate>,
           bool UseSharedMemory = false,
           std::uint32_t BRANCHING_FACTOR = 128,
-          std::uint32_t LEAF_PAGE_SIZE = 4096>
+          std::uint32_t LEAF_PAGE_SIZE = 4096,
+          bool QUANTIZED_CHILD_BOXES = DEFAULT_QUANTIZED_CHILD_BOXES>
 class StaticRTree
 {
   public:
@@ -81,14 +96,30 @@ class StaticRTree
         std::uint32_t is_leaf : 1;
     };
 
-    struct TreeNode
+    struct PlainTreeNode
     {
-        TreeNode() : child_count(0) {}
+        PlainTreeNode() : child_count(0) {}
         std::uint32_t child_count;
         Rectangle minimum_bounding_rectangle;
         TreeIndex children[BRANCHING_FACTOR];
     };
 
+    // The child boxes are stored per component in steps of 1/65535 of the parent box, rounded
+    // outwards so that they always contain the actual boxes of the children. Unused slots are
+    // zero, which keeps the loops over all BRANCHING_FACTOR children branch free.
+    struct QuantizedTreeNode : PlainTreeNode
+    {
+        std::int32_t lon_step = 1;
+        std::int32_t lat_step = 1;
+        std::array<std::uint16_t, BRANCHING_FACTOR> child_min_lon{};
+        std::array<std::uint16_t, BRANCHING_FACTOR> child_max_lon{};
+        std::array<std::uint16_t, BRANCHING_FACTOR> child_min_lat{};
+        std::array<std::uint16_t, BRANCHING_FACTOR> child_max_lat{};
+    };
+
+    using TreeNode =
+        typename std::conditional<QUANTIZED_CHILD_BOXES, QuantizedTreeNode, PlainTreeNode>::type;
+
     struct ALIGNED(LEAF_PAGE_SIZE) LeafNode
     {
         LeafNode() : object_count(0), objects() {}
@@ -214,6 +245,7 @@ class StaticRTree
         for (std::uint32_t node_index = 0; wrapped_element_index < element_count; ++node_index)
         {
             TreeNode current_node;
+            std::array<Rectangle, BRANCHING_FACTOR> child_rectangles;
             for (std::uint32_t leaf_index = 0;
                  leaf_index < BRANCHING_FACTOR && wrapped_element_index < element_count;
                  ++leaf_index)
@@ -260,11 +292,13 @@ class StaticRTree
                     TreeIndex{node_index * BRANCHING_FACTOR + leaf_index, true};
                 current_node.minimum_bounding_rectangle.MergeBoundingBoxes(
                     current_leaf.minimum_bounding_rectangle);
+                child_rectangles[leaf_index] = current_leaf.minimum_bounding_rectangle;
 
                 // write leaf_node to leaf node file
                 leaf_node_file.write((char *)&current_leaf, sizeof(current_leaf));
             }
 
+            StoreChildBoxes(current_node, child_rectangles, ChildBoxesTag{});
             tree_nodes_in_level.emplace_back(current_node);
         }
         leaf_node_file.flush();
@@ -278,6 +312,7 @@ class StaticRTree
             while (processed_tree_nodes_in_level < tree_nodes_in_level.size())
             {
                 TreeNode parent_node;
+                std::array<Rectangle, BRANCHING_FACTOR> child_rectangles;
                 // pack BRANCHING_FACTOR elements into tree_nodes each
                 for (std::uint32_t current_child_node_index = 0;
                      current_child_node_index < BRANCHING_FACTOR;
@@ -294,11 +329,14 @@ class StaticRTree
                         // merge MBRs
                         parent_node.minimum_bounding_rectangle.MergeBoundingBoxes(
                             current_child_node.minimum_bounding_rectangle);
+                        child_rectangles[current_child_node_index] =
+                            current_child_node.minimum_bounding_rectangle;
                         // increase counters
                         ++parent_node.child_count;
                         ++processed_tree_nodes_in_level;
                     }
                 }
+                StoreChildBoxes(parent_node, child_rectangles, ChildBoxesTag{});
                 tree_nodes_in_next_level.emplace_back(parent_node);
             }
             tree_nodes_in_level.swap(tree_nodes_in_next_level);
@@ -333,6 +371,10 @@ class StaticRTree
         // open tree file
         boost::filesystem::ofstream tree_node_file(tree_node_filename, std::ios::binary);
 
+        const std::uint32_t node_layout = QUANTIZED_CHILD_BOXES ? 1 : 0;
+        const std::uint32_t node_size = sizeof(TreeNode);
+        tree_node_file.write((char *)&node_layout, sizeof(node_layout));
+        tree_node_file.write((char *)&node_size, sizeof(node_size));
         std::uint64_t size_of_tree = m_search_tree.size();
         BOOST_ASSERT_MSG(0 < size_of_tree, "tree empty");
         tree_node_file.write((char *)&size_of_tree, sizeof(size_of_tree));
@@ -341,6 +383,24 @@ class StaticRTree
         MapLeafNodesFile(leaf_node_filename);
     }
 
+    /// Reads the header of a .ramIndex file and returns the number of tree nodes. The header
+    /// records the node layout, so trees built with a different ENABLE_COMPACT_RTREE setting
+    /// are rejected instead of being read as garbage.
+    static std::uint64_t ReadTreeHeader(storage::io::FileReader &tree_node_file)
+    {
+        std::uint32_t node_layout = 0;
+        std::uint32_t node_size = 0;
+        tree_node_file.ReadInto(node_layout);
+        tree_node_file.ReadInto(node_size);
+        if (node_layout != (QUANTIZED_CHILD_BOXES ? 1u : 0u) || node_size != sizeof(TreeNode))
+        {
+            throw util::exception("The .ramIndex has a different r-tree node layout, all tools "
+                                  "need to be built with the same ENABLE_COMPACT_RTREE setting" +
+                                  SOURCE_REF);
+        }
+        return tree_node_file.ReadElementCount64();
+    }
+
     explicit StaticRTree(const boost::filesystem::path &node_file,
                          const boost::filesystem::path &leaf_file,
                          const CoordinateListT &coordinate_list)
@@ -349,7 +409,7 @@ class StaticRTree
         storage::io::FileReader tree_node_file(node_file,
                                                storage::io::FileReader::HasNoFingerprint);
 
-        const auto tree_size = tree_node_file.ReadElementCount64();
+        const auto tree_size = ReadTreeHeader(tree_node_file);
 
         m_search_tree.resize(tree_size);
         tree_node_file.ReadInto(&m_search_tree[0], tree_size);
@@ -366,6 +426,17 @@ class StaticRTree
         MapLeafNodesFile(leaf_file);
     }
 
+    // Uses leaves that were already loaded into memory instead of mapping the leaf file
+    explicit StaticRTree(TreeNode *tree_node_ptr,
+                         const uint64_t number_of_nodes,
+                         const LeafNode *leaf_node_ptr,
+                         const uint64_t number_of_leaves,
+                         const CoordinateListT &coordinate_list)
+        : m_search_tree(tree_node_ptr, number_of_nodes), m_coordinate_list(coordinate_list),
+          m_leaves(leaf_node_ptr, number_of_leaves)
+    {
+    }
+
     void MapLeafNodesFile(const boost::filesystem::path &leaf_file)
     {
         // open leaf node file and return a pointer to the mapped leaves data
@@ -385,6 +456,31 @@ class StaticRTree
         }
     }
 
+    // Faults in every leaf page so that the first queries do not stall on cold pages of the
+    // leaf file. Returns the number of segments stored in the leaves.
+    std::uint64_t WarmUp() const
+    {
+        if (m_leaves.empty())
+        {
+            return 0;
+        }
+
+#ifdef __linux__
+        // Only a hint to start the read-ahead, touching the pages below is what faults them in
+        ::madvise(const_cast<LeafNode *>(&m_leaves[0]),
+                  m_leaves.size() * sizeof(LeafNode),
+                  MADV_WILLNEED);
+#endif
+
+        // every leaf fills exactly one page, so reading its header touches each page once
+        std::uint64_t number_of_segments = 0;
+        for (const auto &leaf : m_leaves)
+        {
+            number_of_segments += leaf.object_count;
+        }
+        return number_of_segments;
+    }
+
     /* Returns all features inside the bounding box.
        Rectangle needs to be projected!*/
     std::vector<EdgeDataT> SearchInBox(const Rectangle &search_rectangle) const
@@ -441,9 +537,8 @@ class StaticRTree
                 for (std::uint32_t i = 0; i < current_tree_node.child_count; ++i)
                 {
                     const TreeIndex child_id = current_tree_node.children[i];
-                    const auto &child_rectangle =
-                        child_id.is_leaf ? m_leaves[child_id.index].minimum_bounding_rectangle
-                                         : m_search_tree[child_id.index].minimum_bounding_rectangle;
+                    const auto child_rectangle =
+                        GetChildRectangle(current_tree_node, i, ChildBoxesTag{});
 
                     if (child_rectangle.Intersects(projected_rectangle))
                     {
@@ -533,6 +628,89 @@ class StaticRTree
     }
 
   private:
+    // Projections of an input coordinate onto all segments of a leaf, kept as separate arrays
+    // per component so the loops of ProjectOnLeafNode can be vectorized
+    struct LeafProjections
+    {
+        std::array<double, LEAF_NODE_SIZE> u_lon;
+        std::array<double, LEAF_NODE_SIZE> u_lat;
+        std::array<double, LEAF_NODE_SIZE> v_lon;
+        std::array<double, LEAF_NODE_SIZE> v_lat;
+        std::array<double, LEAF_NODE_SIZE> ratio;
+        std::array<std::int32_t, LEAF_NODE_SIZE> nearest_lon;
+        std::array<std::int32_t, LEAF_NODE_SIZE> nearest_lat;
+        std::array<std::uint64_t, LEAF_NODE_SIZE> squared_distance;
+    };
+
+    // Computes the same values as coordinate_calculation::projectPointOnSegment followed by
+    // squaredEuclideanDistance for all segments of the leaf at once. Only gathering the segment
+    // coordinates is sequential. The loops after it have no branches and no calls, the clamped
+    // ratio is computed in a loop of its own since a select followed by further floating point
+    // math keeps the compiler from vectorizing. The second loop needs 64 bit integer vector
+    // multiplications, which are only available when building for SSE4.1 or newer.
+    void ProjectOnLeafNode(const LeafNode &leaf,
+                           const Coordinate &projected_input_coordinate_fixed,
+                           const FloatCoordinate &projected_input_coordinate,
+                           LeafProjections &projections) const
+    {
+        const auto count = leaf.object_count;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const auto &current_edge = leaf.objects[i];
+            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
+            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
+            projections.u_lon[i] = static_cast<double>(projected_u.lon);
+            projections.u_lat[i] = static_cast<double>(projected_u.lat);
+            projections.v_lon[i] = static_cast<double>(projected_v.lon);
+            projections.v_lat[i] = static_cast<double>(projected_v.lat);
+        }
+
+        const double *const u_lon = projections.u_lon.data();
+        const double *const u_lat = projections.u_lat.data();
+        const double *const v_lon = projections.v_lon.data();
+        const double *const v_lat = projections.v_lat.data();
+        double *const ratio = projections.ratio.data();
+
+        const double input_lon = static_cast<double>(projected_input_coordinate.lon);
+        const double input_lat = static_cast<double>(projected_input_coordinate.lat);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const double slope_lon = v_lon[i] - u_lon[i];
+            const double slope_lat = v_lat[i] - u_lat[i];
+            const double unnormed_ratio =
+                slope_lon * (input_lon - u_lon[i]) + slope_lat * (input_lat - u_lat[i]);
+            const double squared_length = slope_lon * slope_lon + slope_lat * slope_lat;
+            const double normed_ratio =
+                unnormed_ratio / std::max(squared_length, std::numeric_limits<double>::epsilon());
+            const double clamped_ratio = std::min(1., std::max(0., normed_ratio));
+            // degenerated segments project onto their source
+            ratio[i] =
+                squared_length < std::numeric_limits<double>::epsilon() ? 0. : clamped_ratio;
+        }
+
+        std::int32_t *const nearest_lon = projections.nearest_lon.data();
+        std::int32_t *const nearest_lat = projections.nearest_lat.data();
+        std::uint64_t *const squared_distance = projections.squared_distance.data();
+
+        const std::int32_t input_fixed_lon =
+            static_cast<std::int32_t>(projected_input_coordinate_fixed.lon);
+        const std::int32_t input_fixed_lat =
+            static_cast<std::int32_t>(projected_input_coordinate_fixed.lat);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const double lon = (1. - ratio[i]) * u_lon[i] + v_lon[i] * ratio[i];
+            const double lat = (1. - ratio[i]) * u_lat[i] + v_lat[i] * ratio[i];
+            const auto fixed_lon = static_cast<std::int32_t>(lon * COORDINATE_PRECISION);
+            const auto fixed_lat = static_cast<std::int32_t>(lat * COORDINATE_PRECISION);
+            nearest_lon[i] = fixed_lon;
+            nearest_lat[i] = fixed_lat;
+
+            const std::int64_t d_lon = input_fixed_lon - fixed_lon;
+            const std::int64_t d_lat = input_fixed_lat - fixed_lat;
+            squared_distance[i] = static_cast<std::uint64_t>(d_lon * d_lon + d_lat * d_lat);
+        }
+    }
+
     template <typename QueueT>
     void ExploreLeafNode(const TreeIndex &leaf_id,
                          const Coordinate &projected_input_coordinate_fixed,
@@ -542,23 +720,20 @@ class StaticRTree
         const LeafNode &current_leaf_node = m_leaves[leaf_id.index];
 
         // current object represents a block on disk
+        LeafProjections projections;
+        ProjectOnLeafNode(current_leaf_node,
+                          projected_input_coordinate_fixed,
+                          projected_input_coordinate,
+                          projections);
+
         for (const auto i : irange(0u, current_leaf_node.object_count))
         {
-            const auto &current_edge = current_leaf_node.objects[i];
-            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
-            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
-
-            FloatCoordinate projected_nearest;
-            std::tie(std::ignore, projected_nearest) =
-                coordinate_calculation::projectPointOnSegment(
-                    projected_u, projected_v, projected_input_coordinate);
-
-            const auto squared_distance = coordinate_calculation::squaredEuclideanDistance(
-                projected_input_coordinate_fixed, projected_nearest);
-            // distance must be non-negative
-            BOOST_ASSERT(0. <= squared_distance);
             traversal_queue.push(
-                QueryCandidate{squared_distance, leaf_id, i, Coordinate{projected_nearest}});
+                QueryCandidate{projections.squared_distance[i],
+                               leaf_id,
+                               i,
+                               Coordinate{FixedLongitude{projections.nearest_lon[i]},
+                                          FixedLatitude{projections.nearest_lat[i]}}});
         }
     }
 
@@ -566,19 +741,147 @@ class StaticRTree
     void ExploreTreeNode(const TreeIndex &parent_id,
                          const Coordinate &fixed_projected_input_coordinate,
                          QueueT &traversal_queue) const
+    {
+        ExploreTreeNode(
+            parent_id, fixed_projected_input_coordinate, traversal_queue, ChildBoxesTag{});
+    }
+
+    template <class QueueT>
+    void ExploreTreeNode(const TreeIndex &parent_id,
+                         const Coordinate &fixed_projected_input_coordinate,
+                         QueueT &traversal_queue,
+                         std::false_type) const
     {
         const TreeNode &parent = m_search_tree[parent_id.index];
         for (std::uint32_t i = 0; i < parent.child_count; ++i)
         {
             const TreeIndex child_id = parent.children[i];
-            const auto &child_rectangle =
-                child_id.is_leaf ? m_leaves[child_id.index].minimum_bounding_rectangle
-                                 : m_search_tree[child_id.index].minimum_bounding_rectangle;
+            const auto &child_rectangle = GetChildRectangle(parent, i, std::false_type{});
             const auto squared_lower_bound_to_element =
                 child_rectangle.GetMinSquaredDist(fixed_projected_input_coordinate);
             traversal_queue.push(QueryCandidate{squared_lower_bound_to_element, child_id});
         }
     }
+
+    template <class QueueT>
+    void ExploreTreeNode(const TreeIndex &parent_id,
+                         const Coordinate &fixed_projected_input_coordinate,
+                         QueueT &traversal_queue,
+                         std::true_type) const
+    {
+        const TreeNode &parent = m_search_tree[parent_id.index];
+        const auto &parent_rectangle = parent.minimum_bounding_rectangle;
+        const auto parent_min_lon = static_cast<std::int32_t>(parent_rectangle.min_lon);
+        const auto parent_min_lat = static_cast<std::int32_t>(parent_rectangle.min_lat);
+        const auto lon = static_cast<std::int32_t>(fixed_projected_input_coordinate.lon);
+        const auto lat = static_cast<std::int32_t>(fixed_projected_input_coordinate.lat);
+
+        // Same lower bound as Rectangle::GetMinSquaredDist for all children at once. The loops
+        // have a fixed trip count and no branches, so they are compiled to a few SIMD compares.
+        // Squaring is a separate loop, the widening multiply would keep the first one scalar.
+        std::array<std::uint32_t, BRANCHING_FACTOR> delta_lon;
+        std::array<std::uint32_t, BRANCHING_FACTOR> delta_lat;
+        for (std::uint32_t i = 0; i < BRANCHING_FACTOR; ++i)
+        {
+            const std::int32_t min_lon = parent_min_lon + parent.child_min_lon[i] * parent.lon_step;
+            const std::int32_t max_lon = parent_min_lon + parent.child_max_lon[i] * parent.lon_step;
+            const std::int32_t min_lat = parent_min_lat + parent.child_min_lat[i] * parent.lat_step;
+            const std::int32_t max_lat = parent_min_lat + parent.child_max_lat[i] * parent.lat_step;
+            delta_lon[i] = std::max(std::max(min_lon - lon, lon - max_lon), 0);
+            delta_lat[i] = std::max(std::max(min_lat - lat, lat - max_lat), 0);
+        }
+
+        std::array<std::uint64_t, BRANCHING_FACTOR> squared_lower_bounds;
+        for (std::uint32_t i = 0; i < BRANCHING_FACTOR; ++i)
+        {
+            squared_lower_bounds[i] = std::uint64_t{delta_lon[i]} * delta_lon[i] +
+                                      std::uint64_t{delta_lat[i]} * delta_lat[i];
+        }
+
+        for (std::uint32_t i = 0; i < parent.child_count; ++i)
+        {
+            traversal_queue.push(QueryCandidate{squared_lower_bounds[i], parent.children[i]});
+        }
+    }
+
+    using ChildBoxesTag = std::integral_constant<bool, QUANTIZED_CHILD_BOXES>;
+
+    // Without child boxes the bounding box is read from the child itself
+    const Rectangle &
+    GetChildRectangle(const TreeNode &node, const std::uint32_t child, std::false_type) const
+    {
+        const TreeIndex child_id = node.children[child];
+        return child_id.is_leaf ? m_leaves[child_id.index].minimum_bounding_rectangle
+                                : m_search_tree[child_id.index].minimum_bounding_rectangle;
+    }
+
+    // Decodes the stored box, which can be slightly larger than the box of the child
+    Rectangle
+    GetChildRectangle(const TreeNode &node, const std::uint32_t child, std::true_type) const
+    {
+        const auto &parent_rectangle = node.minimum_bounding_rectangle;
+        return Rectangle{parent_rectangle.min_lon + FixedLongitude{node.child_min_lon[child] *
+                                                                   node.lon_step},
+                         parent_rectangle.min_lon + FixedLongitude{node.child_max_lon[child] *
+                                                                   node.lon_step},
+                         parent_rectangle.min_lat + FixedLatitude{node.child_min_lat[child] *
+                                                                  node.lat_step},
+                         parent_rectangle.min_lat + FixedLatitude{node.child_max_lat[child] *
+                                                                  node.lat_step}};
+    }
+
+    static void StoreChildBoxes(TreeNode &,
+                                const std::array<Rectangle, BRANCHING_FACTOR> &,
+                                std::false_type)
+    {
+    }
+
+    static void StoreChildBoxes(TreeNode &node,
+                                const std::array<Rectangle, BRANCHING_FACTOR> &child_rectangles,
+                                std::true_type)
+    {
+        const auto &parent_rectangle = node.minimum_bounding_rectangle;
+        node.lon_step = GetQuantizationStep(static_cast<std::int32_t>(parent_rectangle.min_lon),
+                                            static_cast<std::int32_t>(parent_rectangle.max_lon));
+        node.lat_step = GetQuantizationStep(static_cast<std::int32_t>(parent_rectangle.min_lat),
+                                            static_cast<std::int32_t>(parent_rectangle.max_lat));
+
+        for (std::uint32_t i = 0; i < node.child_count; ++i)
+        {
+            const auto &child_rectangle = child_rectangles[i];
+            node.child_min_lon[i] = QuantizeDown(child_rectangle.min_lon - parent_rectangle.min_lon,
+                                                 node.lon_step);
+            node.child_max_lon[i] = QuantizeUp(child_rectangle.max_lon - parent_rectangle.min_lon,
+                                               node.lon_step);
+            node.child_min_lat[i] = QuantizeDown(child_rectangle.min_lat - parent_rectangle.min_lat,
+                                                 node.lat_step);
+            node.child_max_lat[i] = QuantizeUp(child_rectangle.max_lat - parent_rectangle.min_lat,
+                                               node.lat_step);
+        }
+    }
+
+    static std::int32_t GetQuantizationStep(const std::int32_t min, const std::int32_t max)
+    {
+        const auto max_quantized = std::numeric_limits<std::uint16_t>::max();
+        const auto width = static_cast<std::int64_t>(max) - min;
+        return std::max<std::int32_t>(1, (width + max_quantized - 1) / max_quantized);
+    }
+
+    template <typename OffsetT>
+    static std::uint16_t QuantizeDown(const OffsetT offset, const std::int32_t step)
+    {
+        BOOST_ASSERT(static_cast<std::int32_t>(offset) >= 0);
+        return static_cast<std::int32_t>(offset) / step;
+    }
+
+    template <typename OffsetT>
+    static std::uint16_t QuantizeUp(const OffsetT offset, const std::int32_t step)
+    {
+        BOOST_ASSERT(static_cast<std::int32_t>(offset) >= 0);
+        BOOST_ASSERT((static_cast<std::int32_t>(offset) + step - 1) / step <=
+                     std::numeric_limits<std::uint16_t>::max());
+        return (static_cast<std::int32_t>(offset) + step - 1) / step;
+    }
 };
 
 //[1] "On Packing R-Trees"; I. Kamel, C. Faloutsos; 1993; DOI: 10.1145/170088.170403
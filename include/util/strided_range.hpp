@@ -0,0 +1,111 @@
+#ifndef STRIDED_RANGE_HPP
+#define STRIDED_RANGE_HPP
+
+#include <boost/assert.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+template <typename T>
+class StridedIterator : public boost::iterator_facade<StridedIterator<T>,
+                                                      const T,
+                                                      boost::random_access_traversal_tag>
+{
+    typedef boost::iterator_facade<StridedIterator<T>, const T, boost::random_access_traversal_tag>
+        base_t;
+
+  public:
+    typedef typename base_t::difference_type difference_type;
+    typedef typename base_t::reference reference;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    StridedIterator() : m_first(nullptr), m_stride(1), m_index(0) {}
+    StridedIterator(const T *first, const std::ptrdiff_t stride, const difference_type index)
+        : m_first(first), m_stride(stride), m_index(index)
+    {
+    }
+
+  private:
+    void increment() { ++m_index; }
+    void decrement() { --m_index; }
+    void advance(difference_type offset) { m_index += offset; }
+    bool equal(const StridedIterator &other) const { return m_index == other.m_index; }
+    reference dereference() const { return m_first[m_index * m_stride]; }
+    difference_type distance_to(const StridedIterator &other) const
+    {
+        return other.m_index - m_index;
+    }
+
+    friend class ::boost::iterator_core_access;
+    const T *m_first;
+    std::ptrdiff_t m_stride;
+    difference_type m_index;
+};
+
+// Non-owning view of `size` elements of a contiguous array, starting at `first` and moving
+// `stride` elements per step. A stride of -1 reads the array backwards, a stride of 0 repeats
+// the first element which is used for default values that are not stored explicitly.
+// The view is only valid as long as the underlying memory is.
+template <typename T> class StridedRange
+{
+  public:
+    typedef StridedIterator<T> const_iterator;
+    typedef StridedIterator<T> iterator;
+    typedef T value_type;
+
+    StridedRange() : m_first(nullptr), m_size(0), m_stride(1) {}
+    StridedRange(const T *first, const std::size_t size, const std::ptrdiff_t stride = 1)
+        : m_first(first), m_size(size), m_stride(stride)
+    {
+    }
+
+    iterator begin() const noexcept { return iterator(m_first, m_stride, 0); }
+    iterator end() const noexcept { return iterator(m_first, m_stride, m_size); }
+
+    std::size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    const T &operator[](const std::size_t index) const
+    {
+        BOOST_ASSERT(index < m_size);
+        return m_first[static_cast<std::ptrdiff_t>(index) * m_stride];
+    }
+
+    const T &front() const { return (*this)[0]; }
+    const T &back() const { return (*this)[m_size - 1]; }
+
+  private:
+    const T *m_first;
+    std::size_t m_size;
+    std::ptrdiff_t m_stride;
+};
+
+// View of [first, last) in order
+template <typename T> StridedRange<T> makeForwardRange(const T *first, const T *last)
+{
+    BOOST_ASSERT(first <= last);
+    return StridedRange<T>(first, last - first, 1);
+}
+
+// View of [first, last) in reverse order, starting at last - 1
+template <typename T> StridedRange<T> makeReverseRange(const T *first, const T *last)
+{
+    BOOST_ASSERT(first <= last);
+    return StridedRange<T>(last - 1, last - first, -1);
+}
+
+template <typename T> std::vector<T> toVector(const StridedRange<T> &range)
+{
+    return std::vector<T>(range.begin(), range.end());
+}
+}
+}
+
+#endif // STRIDED_RANGE_HPP
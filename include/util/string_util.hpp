@@ -58,44 +58,53 @@ template <int length, int precision> char *printInt(char *buffer, int value)
     return buffer;
 }
 
-inline std::string escape_JSON(const std::string &input)
+// Appends the escaped input to a container of chars, e.g. std::string or std::vector<char>
+template <typename OutputT> void escape_JSON(const std::string &input, OutputT &output)
 {
-    // escape and skip reallocations if possible
-    std::string output;
-    output.reserve(input.size() + 4); // +4 assumes two backslashes on avg
+    const auto append = [&output](const char(&escaped)[3]) {
+        output.insert(output.end(), escaped, escaped + 2);
+    };
     for (const char letter : input)
     {
         switch (letter)
         {
         case '\\':
-            output += "\\\\";
+            append("\\\\");
             break;
         case '"':
-            output += "\\\"";
+            append("\\\"");
             break;
         case '/':
-            output += "\\/";
+            append("\\/");
             break;
         case '\b':
-            output += "\\b";
+            append("\\b");
             break;
         case '\f':
-            output += "\\f";
+            append("\\f");
             break;
         case '\n':
-            output += "\\n";
+            append("\\n");
             break;
         case '\r':
-            output += "\\r";
+            append("\\r");
             break;
         case '\t':
-            output += "\\t";
+            append("\\t");
             break;
         default:
-            output.append(1, letter);
+            output.push_back(letter);
             break;
         }
     }
+}
+
+inline std::string escape_JSON(const std::string &input)
+{
+    // escape and skip reallocations if possible
+    std::string output;
+    output.reserve(input.size() + 4); // +4 assumes two backslashes on avg
+    escape_JSON(input, output);
     return output;
 }
 
@@ -0,0 +1,135 @@
+#include "contractor/query_edge.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/io.hpp"
+#include "storage/serialization.hpp"
+#include "util/binary_heap.hpp"
+#include "util/static_graph.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+using QueryGraph = util::StaticGraph<contractor::QueryEdge::EdgeData>;
+
+QueryGraph loadGraph(const std::string &hsgr_path)
+{
+    storage::io::FileReader hsgr_file(hsgr_path, storage::io::FileReader::VerifyFingerprint);
+    const auto header = storage::serialization::readHSGRHeader(hsgr_file);
+
+    std::vector<QueryGraph::NodeArrayEntry> nodes(header.number_of_nodes);
+    std::vector<QueryGraph::EdgeArrayEntry> edges(header.number_of_edges);
+    storage::serialization::readHSGR(
+        hsgr_file, nodes.data(), header.number_of_nodes, edges.data(), header.number_of_edges);
+
+    return QueryGraph(nodes, edges);
+}
+
+// Runs the same upward (forward) CH search space exploration as the query algorithms do,
+// reusing one heap across all queries exactly like the per-thread engine heaps.
+template <typename HeapT>
+void benchmarkHeap(const QueryGraph &graph,
+                   const std::vector<NodeID> &sources,
+                   const std::string &name)
+{
+    std::cout << "Running " << name << " with " << sources.size() << " searches: " << std::flush;
+
+    HeapT heap(graph.GetNumberOfNodes());
+    std::size_t settled_nodes = 0;
+
+    TIMER_START(query);
+    for (const auto source : sources)
+    {
+        heap.Clear();
+        heap.Insert(source, 0, engine::HeapData{source});
+
+        while (!heap.Empty())
+        {
+            const NodeID node = heap.DeleteMin();
+            const int weight = heap.GetKey(node);
+            ++settled_nodes;
+
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto &data = graph.GetEdgeData(edge);
+                if (!data.forward)
+                {
+                    continue;
+                }
+
+                const NodeID to = graph.GetTarget(edge);
+                const int to_weight = weight + data.weight;
+                if (!heap.WasInserted(to))
+                {
+                    heap.Insert(to, to_weight, engine::HeapData{node});
+                }
+                else if (to_weight < heap.GetKey(to))
+                {
+                    heap.GetData(to).parent = node;
+                    heap.DecreaseKey(to, to_weight);
+                }
+            }
+        }
+    }
+    TIMER_STOP(query);
+
+    std::cout << "Took " << TIMER_MSEC(query) << "ms  ->  "
+              << TIMER_MSEC(query) / sources.size() << " ms/search, "
+              << (TIMER_MSEC(query) * 1000000.) / settled_nodes << " ns/settled node" << std::endl;
+}
+
+void benchmark(const QueryGraph &graph, unsigned num_queries)
+{
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<NodeID> node_udist(0, graph.GetNumberOfNodes() - 1);
+    std::vector<NodeID> sources;
+    for (unsigned i = 0; i < num_queries; i++)
+    {
+        sources.push_back(node_udist(mt_rand));
+    }
+
+    using UnorderedMapHeap = util::BinaryHeap<NodeID,
+                                              NodeID,
+                                              int,
+                                              engine::HeapData,
+                                              util::UnorderedMapStorage<NodeID, int>>;
+    using GenerationArrayHeap = engine::SearchEngineData::QueryHeap;
+
+    benchmarkHeap<UnorderedMapHeap>(graph, sources, "UnorderedMapStorage heap");
+    benchmarkHeap<GenerationArrayHeap>(graph, sources, "GenerationArrayStorage heap");
+}
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm.hsgr [number of searches]\n";
+        return EXIT_FAILURE;
+    }
+
+    const unsigned num_queries = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+    const auto graph = osrm::benchmarks::loadGraph(argv[1]);
+    osrm::benchmarks::benchmark(graph, num_queries);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+#include "engine/datafacade/contiguous_internalmem_datafacade_base.hpp"
+#include "engine/datafacade/datafacade_base.hpp"
+#include "engine/datafacade/process_memory_datafacade.hpp"
+#include "engine/internal_route_result.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/shortest_path.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/storage_config.hpp"
+#include "util/coordinate.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+using BaseFacade = engine::datafacade::BaseDataFacade;
+using ContiguousFacade = engine::datafacade::ContiguousInternalMemoryDataFacadeBase;
+
+// Snaps random road locations of the dataset, the whole dataset is expected to be small
+// (e.g. monaco) since all edges are loaded to pick the locations.
+std::vector<engine::PhantomNode> snapLocations(const BaseFacade &facade, unsigned num_locations)
+{
+    const util::Coordinate south_west{util::FloatLongitude{-180.}, util::FloatLatitude{-85.}};
+    const util::Coordinate north_east{util::FloatLongitude{180.}, util::FloatLatitude{85.}};
+    const auto edges = facade.GetEdgesInBox(south_west, north_east);
+    if (edges.empty())
+    {
+        throw std::runtime_error("Dataset does not contain any edges");
+    }
+
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<std::size_t> edge_udist(0, edges.size() - 1);
+    std::vector<engine::PhantomNode> phantoms;
+    for (unsigned i = 0; i < num_locations; ++i)
+    {
+        const auto &edge = edges[edge_udist(mt_rand)];
+        const auto location = facade.GetCoordinateOfNode(edge.u);
+        phantoms.push_back(
+            facade.NearestPhantomNodeWithAlternativeFromBigComponent(location).first);
+    }
+    return phantoms;
+}
+
+// Runs the same queries with the routing algorithms instantiated on the given facade type.
+// Instantiated with BaseDataFacade every graph access is a virtual call, instantiated with the
+// contiguous facade the final overrides are bound statically and can be inlined.
+template <typename FacadeT>
+void benchmarkFacade(const FacadeT &facade,
+                     const std::vector<engine::PhantomNode> &phantoms,
+                     const std::string &name)
+{
+    engine::SearchEngineData heaps;
+    engine::routing_algorithms::ShortestPathRouting<FacadeT> shortest_path(heaps);
+    engine::routing_algorithms::ManyToManyRouting<FacadeT> many_to_many(heaps);
+
+    std::cout << name << ":" << std::endl;
+
+    TIMER_START(route);
+    for (std::size_t i = 0; i + 1 < phantoms.size(); ++i)
+    {
+        engine::InternalRouteResult raw_route;
+        raw_route.segment_end_coordinates.push_back(
+            engine::PhantomNodes{phantoms[i], phantoms[i + 1]});
+        shortest_path(facade, raw_route.segment_end_coordinates, boost::none, raw_route);
+    }
+    TIMER_STOP(route);
+    const auto num_routes = phantoms.size() - 1;
+    std::cout << "  route: " << TIMER_MSEC(route) << "ms  ->  "
+              << (TIMER_MSEC(route) * 1000000.) / num_routes << " ns/query" << std::endl;
+
+    TIMER_START(table);
+    const auto table = many_to_many(facade, phantoms, {}, {});
+    TIMER_STOP(table);
+    std::cout << "  table " << phantoms.size() << "x" << phantoms.size() << ": "
+              << TIMER_MSEC(table) << "ms  ->  "
+              << (TIMER_MSEC(table) * 1000000.) / table.size() << " ns/entry" << std::endl;
+}
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [number of locations]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    const unsigned num_locations = argc > 2 ? std::stoul(argv[2]) : 1000;
+
+    const engine::datafacade::ProcessMemoryDataFacade facade{storage::StorageConfig{argv[1]}};
+    const auto phantoms = benchmarks::snapLocations(facade, num_locations);
+
+    benchmarks::benchmarkFacade<benchmarks::BaseFacade>(facade, phantoms, "Virtual facade");
+    benchmarks::benchmarkFacade<benchmarks::ContiguousFacade>(
+        facade, phantoms, "Devirtualized facade");
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
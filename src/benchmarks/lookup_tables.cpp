@@ -0,0 +1,136 @@
+#include "contractor/lookup_tables.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <tbb/task_scheduler_init.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+// Removes the synthetic files again when going out of scope
+struct SyntheticFiles
+{
+    ~SyntheticFiles()
+    {
+        for (const auto &filename : filenames)
+        {
+            boost::filesystem::remove(filename);
+        }
+    }
+
+    std::vector<std::string> filenames;
+};
+
+// Writes lines with random node ids, roughly shaped like a traffic export
+template <typename WriteLine>
+void writeSyntheticFiles(SyntheticFiles &files,
+                         const unsigned num_files,
+                         const std::size_t num_lines,
+                         const WriteLine &write_line)
+{
+    std::mt19937 mt_rand(RANDOM_SEED);
+    for (unsigned file = 0; file < num_files; ++file)
+    {
+        files.filenames.push_back(
+            (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+                .string());
+        std::ofstream out(files.filenames.back());
+        for (std::size_t line = 0; line < num_lines / num_files; ++line)
+        {
+            write_line(out, mt_rand);
+        }
+    }
+}
+
+template <typename Parse>
+void benchmarkParse(const std::vector<std::string> &filenames,
+                    const std::string &name,
+                    const Parse &parse)
+{
+    std::vector<int> thread_counts = {1};
+    if (tbb::task_scheduler_init::default_num_threads() > 1)
+        thread_counts.push_back(tbb::task_scheduler_init::default_num_threads());
+
+    for (const auto num_threads : thread_counts)
+    {
+        tbb::task_scheduler_init init(num_threads);
+
+        TIMER_START(parse);
+        const auto lookup = parse(filenames);
+        TIMER_STOP(parse);
+
+        std::cout << "Parsing " << name << " with " << num_threads << " thread(s) took "
+                  << TIMER_MSEC(parse) << "ms  ->  " << lookup.size() << " unique entries, "
+                  << (TIMER_MSEC(parse) * 1000000.) / std::max<std::size_t>(lookup.size(), 1)
+                  << " ns/entry" << std::endl;
+    }
+}
+
+void benchmark(const std::size_t num_lines, const unsigned num_files)
+{
+    std::uniform_int_distribution<std::uint64_t> node_udist(1, 5000000000);
+    std::uniform_int_distribution<unsigned> speed_udist(0, 130);
+    std::uniform_real_distribution<double> penalty_udist(-10., 100.);
+
+    {
+        SyntheticFiles files;
+        writeSyntheticFiles(files, num_files, num_lines, [&](std::ofstream &out, std::mt19937 &r) {
+            out << node_udist(r) << ',' << node_udist(r) << ',' << speed_udist(r) << '\n';
+        });
+        benchmarkParse(files.filenames,
+                       "segment speeds",
+                       contractor::parse_segment_lookup_from_csv_files);
+    }
+
+    {
+        SyntheticFiles files;
+        writeSyntheticFiles(files, num_files, num_lines, [&](std::ofstream &out, std::mt19937 &r) {
+            out << node_udist(r) << ',' << node_udist(r) << ',' << node_udist(r) << ','
+                << penalty_udist(r) << '\n';
+        });
+        benchmarkParse(files.filenames,
+                       "turn penalties",
+                       contractor::parse_turn_penalty_lookup_from_csv_files);
+    }
+}
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    const std::size_t num_lines = argc > 1 ? std::stoull(argv[1]) : 10000000;
+    const unsigned num_files = argc > 2 ? std::stoul(argv[2]) : 1;
+
+    if (num_files == 0 || num_lines < num_files)
+    {
+        std::cerr << "Usage: " << argv[0] << " [number of lines] [number of files]\n";
+        return EXIT_FAILURE;
+    }
+
+    // Keep the per file messages out of the timings
+    osrm::util::LogPolicy::GetInstance().Mute();
+
+    osrm::benchmarks::benchmark(num_lines, num_files);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
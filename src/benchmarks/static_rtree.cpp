@@ -5,10 +5,13 @@
 #include "storage/io.hpp"
 #include "engine/geospatial_query.hpp"
 #include "util/coordinate.hpp"
+#include "util/hilbert_value.hpp"
 #include "util/timing_util.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
+#include <vector>
 
 #include <boost/filesystem/fstream.hpp>
 
@@ -86,6 +89,24 @@ void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
     benchmarkQuery(queries, "raw RTree queries (10 results)", [&rtree](const util::Coordinate &q) {
         return rtree.Nearest(q, 10);
     });
+
+    // batch snapping processes its coordinates in the order of their Hilbert values
+    std::cout << "Sorting " << queries.size() << " coordinates by Hilbert value: " << std::flush;
+    TIMER_START(sort);
+    const auto order = util::HilbertOrder(queries);
+    std::vector<util::Coordinate> sorted_queries(queries.size());
+    std::transform(order.begin(), order.end(), sorted_queries.begin(), [&queries](std::size_t i) {
+        return queries[i];
+    });
+    TIMER_STOP(sort);
+    std::cout << "Took " << TIMER_MSEC(sort) << "ms" << std::endl;
+
+    benchmarkQuery(sorted_queries,
+                   "raw RTree queries in Hilbert order (1 result)",
+                   [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 1); });
+    benchmarkQuery(sorted_queries,
+                   "raw RTree queries in Hilbert order (10 results)",
+                   [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 10); });
 }
 }
 }
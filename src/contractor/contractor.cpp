@@ -1,12 +1,16 @@
 #include "contractor/contractor.hpp"
 #include "contractor/crc32_processor.hpp"
 #include "contractor/graph_contractor.hpp"
+#include "contractor/graph_customizer.hpp"
+#include "contractor/lookup_tables.hpp"
+#include "contractor/sweep_edge.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/edge_based_graph_factory.hpp"
 #include "extractor/node_based_edge.hpp"
 
 #include "storage/io.hpp"
+#include "storage/serialization.hpp"
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/graph_loader.hpp"
@@ -21,10 +25,10 @@
 
 #include <boost/assert.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/interprocess/file_mapping.hpp>
 #include <boost/interprocess/mapped_region.hpp>
-#include <boost/spirit/include/qi.hpp>
 
 #include <tbb/blocked_range.h>
 #include <tbb/concurrent_unordered_map.h>
@@ -33,7 +37,6 @@
 #include <tbb/parallel_for_each.h>
 #include <tbb/parallel_invoke.h>
 #include <tbb/parallel_sort.h>
-#include <tbb/spin_mutex.h>
 
 #include <algorithm>
 #include <bitset>
@@ -41,6 +44,7 @@
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -93,16 +97,16 @@ inline EdgeWeight distanceAndSpeedToWeight(double distance_in_meters, double spe
 }
 
 // Returns updated edge weight
-template <class IterType>
-EdgeWeight getNewWeight(IterType speed_iter,
+EdgeWeight getNewWeight(const Segment &segment,
+                        const SpeedSource &speed_source,
                         const double &segment_length,
                         const std::vector<std::string> &segment_speed_filenames,
                         const EdgeWeight old_weight,
                         const double log_edge_updates_factor)
 {
     const auto new_segment_weight =
-        (speed_iter->speed_source.speed > 0)
-            ? distanceAndSpeedToWeight(segment_length, speed_iter->speed_source.speed)
+        (speed_source.speed > 0)
+            ? distanceAndSpeedToWeight(segment_length, speed_source.speed)
             : INVALID_EDGE_WEIGHT;
     // the check here is enabled by the `--edge-weight-updates-over-factor` flag
     // it logs a warning if the new weight exceeds a heuristic of what a reasonable weight update is
@@ -113,14 +117,14 @@ EdgeWeight getNewWeight(IterType speed_iter,
         auto approx_original_speed = (segment_length / old_secs) * 3.6;
         if (old_weight >= (new_segment_weight * log_edge_updates_factor))
         {
-            auto speed_file = segment_speed_filenames.at(speed_iter->speed_source.source - 1);
+            auto speed_file = segment_speed_filenames.at(speed_source.source - 1);
             util::Log(logWARNING) << "[weight updates] Edge weight update from " << old_secs
                                   << "s to " << new_secs
-                                  << "s  New speed: " << speed_iter->speed_source.speed << " kph"
+                                  << "s  New speed: " << speed_source.speed << " kph"
                                   << ". Old speed: " << approx_original_speed << " kph"
                                   << ". Segment length: " << segment_length << " m"
-                                  << ". Segment: " << speed_iter->segment.from << ","
-                                  << speed_iter->segment.to << " based on " << speed_file;
+                                  << ". Segment: " << segment.from << "," << segment.to
+                                  << " based on " << speed_file;
         }
     }
 
@@ -174,6 +178,17 @@ int Contractor::Run()
                                                config.rtree_leaf_path,
                                                config.log_edge_updates_factor);
 
+    if (config.customize_only)
+    {
+        CustomizeGraph(max_edge_id, edge_based_edge_list);
+
+        TIMER_STOP(preparing);
+        util::Log() << "Preprocessing : " << TIMER_SEC(preparing) << " seconds";
+        util::Log() << "finished preprocessing";
+
+        return 0;
+    }
+
     // Contracting the edge-expanded graph
 
     TIMER_START(contraction);
@@ -195,7 +210,10 @@ int Contractor::Run()
 
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
-    std::size_t number_of_used_edges = WriteContractedGraph(max_edge_id, contracted_edge_list);
+    // a core is not part of the hierarchy, so it can not be swept
+    const bool has_core = !is_core_node.empty();
+    std::size_t number_of_used_edges = WriteContractedGraph(
+        max_edge_id, contracted_edge_list, has_core ? std::vector<float>() : node_levels);
     WriteCoreNodeMarker(std::move(is_core_node));
     if (!config.use_cached_priority)
     {
@@ -218,294 +236,6 @@ int Contractor::Run()
     return 0;
 }
 
-// Utilities for LoadEdgeExpandedGraph to restore my sanity
-namespace
-{
-
-struct Segment final
-{
-    OSMNodeID from, to;
-    bool operator==(const Segment &other) const
-    {
-        return std::tie(from, to) == std::tie(other.from, other.to);
-    }
-};
-
-struct SpeedSource final
-{
-    unsigned speed;
-    std::uint8_t source;
-};
-
-struct SegmentSpeedSource final
-{
-    Segment segment;
-    SpeedSource speed_source;
-    // < operator is overloaded here to return a > comparison to be used by the
-    // std::lower_bound() call in the find() function
-    bool operator<(const SegmentSpeedSource &other) const
-    {
-        return std::tie(segment.from, segment.to) > std::tie(other.segment.from, other.segment.to);
-    }
-};
-
-struct Turn final
-{
-    OSMNodeID from, via, to;
-    bool operator==(const Turn &other) const
-    {
-        return std::tie(from, via, to) == std::tie(other.from, other.via, other.to);
-    }
-};
-
-struct PenaltySource final
-{
-    double penalty;
-    std::uint8_t source;
-};
-struct TurnPenaltySource final
-{
-    Turn segment;
-    PenaltySource penalty_source;
-    // < operator is overloaded here to return a > comparison to be used by the
-    // std::lower_bound() call in the find() function
-    bool operator<(const TurnPenaltySource &other) const
-    {
-        return std::tie(segment.from, segment.via, segment.to) >
-               std::tie(other.segment.from, other.segment.via, other.segment.to);
-    }
-};
-using TurnPenaltySourceFlatMap = std::vector<TurnPenaltySource>;
-using SegmentSpeedSourceFlatMap = std::vector<SegmentSpeedSource>;
-
-// Find is a binary Search over a flattened key,val Segment storage
-// It takes the flat map and a Segment/PenaltySource object that has an overloaded
-// `==` operator, to make the std::lower_bound call work generically
-template <typename FlatMap, typename SegmentKey>
-auto find(const FlatMap &map, const SegmentKey &key)
-{
-    const auto last = end(map);
-    auto it = std::lower_bound(begin(map), last, key);
-
-    if (it != last && (it->segment == key.segment))
-        return it;
-
-    return last;
-}
-
-// Functions for parsing files and creating lookup tables
-
-SegmentSpeedSourceFlatMap
-parse_segment_lookup_from_csv_files(const std::vector<std::string> &segment_speed_filenames)
-{
-    // TODO: shares code with turn penalty lookup parse function
-
-    using Mutex = tbb::spin_mutex;
-
-    // Loaded and parsed in parallel, at the end we combine results in a flattened map-ish view
-    SegmentSpeedSourceFlatMap flatten;
-    Mutex flatten_mutex;
-
-    const auto parse_segment_speed_file = [&](const std::size_t idx) {
-        const auto file_id = idx + 1; // starts at one, zero means we assigned the weight
-        const auto filename = segment_speed_filenames[idx];
-
-        storage::io::FileReader segment_speed_file_reader(
-            filename, storage::io::FileReader::HasNoFingerprint);
-
-        SegmentSpeedSourceFlatMap local;
-
-        std::uint64_t from_node_id{};
-        std::uint64_t to_node_id{};
-        unsigned speed{};
-
-        std::size_t line_number = 0;
-
-        std::for_each(
-            segment_speed_file_reader.GetLineIteratorBegin(),
-            segment_speed_file_reader.GetLineIteratorEnd(),
-            [&](const std::string &line) {
-                ++line_number;
-
-                using namespace boost::spirit::qi;
-
-                auto it = begin(line);
-                const auto last = end(line);
-
-                // The ulong_long -> uint64_t will likely break on 32bit platforms
-                const auto ok =
-                    parse(it,
-                          last,                                                                  //
-                          (ulong_long >> ',' >> ulong_long >> ',' >> uint_ >> *(',' >> *char_)), //
-                          from_node_id,
-                          to_node_id,
-                          speed); //
-
-                if (!ok || it != last)
-                {
-                    const std::string message{"Segment speed file " + filename +
-                                              " malformed on line " + std::to_string(line_number)};
-                    throw util::exception(message + SOURCE_REF);
-                }
-
-                SegmentSpeedSource val{{OSMNodeID{from_node_id}, OSMNodeID{to_node_id}},
-                                       {speed, static_cast<std::uint8_t>(file_id)}};
-
-                local.push_back(std::move(val));
-            });
-
-        util::Log() << "Loaded speed file " << filename << " with " << local.size() << " speeds";
-
-        {
-            Mutex::scoped_lock _{flatten_mutex};
-
-            flatten.insert(end(flatten),
-                           std::make_move_iterator(begin(local)),
-                           std::make_move_iterator(end(local)));
-        }
-    };
-
-    try
-    {
-        tbb::parallel_for(std::size_t{0}, segment_speed_filenames.size(), parse_segment_speed_file);
-    }
-    catch (const tbb::captured_exception &e)
-    {
-        throw util::exception(e.what() + SOURCE_REF);
-    }
-
-    // With flattened map-ish view of all the files, sort and unique them on from,to,source
-    // The greater '>' is used here since we want to give files later on higher precedence
-    const auto sort_by = [](const SegmentSpeedSource &lhs, const SegmentSpeedSource &rhs) {
-        return std::tie(lhs.segment.from, lhs.segment.to, lhs.speed_source.source) >
-               std::tie(rhs.segment.from, rhs.segment.to, rhs.speed_source.source);
-    };
-
-    std::stable_sort(begin(flatten), end(flatten), sort_by);
-
-    // Unique only on from,to to take the source precedence into account and remove duplicates
-    const auto unique_by = [](const SegmentSpeedSource &lhs, const SegmentSpeedSource &rhs) {
-        return std::tie(lhs.segment.from, lhs.segment.to) ==
-               std::tie(rhs.segment.from, rhs.segment.to);
-    };
-
-    const auto it = std::unique(begin(flatten), end(flatten), unique_by);
-
-    flatten.erase(it, end(flatten));
-
-    util::Log() << "In total loaded " << segment_speed_filenames.size()
-                << " speed file(s) with a total of " << flatten.size() << " unique values";
-
-    return flatten;
-}
-
-TurnPenaltySourceFlatMap
-parse_turn_penalty_lookup_from_csv_files(const std::vector<std::string> &turn_penalty_filenames)
-{
-    using Mutex = tbb::spin_mutex;
-
-    // TODO: shares code with turn penalty lookup parse function
-    TurnPenaltySourceFlatMap map;
-    Mutex flatten_mutex;
-
-    const auto parse_turn_penalty_file = [&](const std::size_t idx) {
-        const auto file_id = idx + 1; // starts at one, zero means we assigned the weight
-        const auto filename = turn_penalty_filenames[idx];
-
-        storage::io::FileReader turn_penalty_file_reader(filename,
-                                                         storage::io::FileReader::HasNoFingerprint);
-        TurnPenaltySourceFlatMap local;
-
-        std::uint64_t from_node_id{};
-        std::uint64_t via_node_id{};
-        std::uint64_t to_node_id{};
-        double penalty{};
-
-        std::size_t line_number = 0;
-
-        std::for_each(
-            turn_penalty_file_reader.GetLineIteratorBegin(),
-            turn_penalty_file_reader.GetLineIteratorEnd(),
-            [&](const std::string &line) {
-                ++line_number;
-
-                using namespace boost::spirit::qi;
-
-                auto it = begin(line);
-                const auto last = end(line);
-
-                // The ulong_long -> uint64_t will likely break on 32bit platforms
-                const auto ok = parse(it,
-                                      last, //
-                                      (ulong_long >> ',' >> ulong_long >> ',' >> ulong_long >>
-                                       ',' >> double_ >> *(',' >> *char_)), //
-                                      from_node_id,
-                                      via_node_id,
-                                      to_node_id,
-                                      penalty); //
-
-                if (!ok || it != last)
-                {
-                    const std::string message{"Turn penalty file " + filename +
-                                              " malformed on line " + std::to_string(line_number)};
-                    throw util::exception(message + SOURCE_REF);
-                }
-
-                TurnPenaltySource val{
-                    {OSMNodeID{from_node_id}, OSMNodeID{via_node_id}, OSMNodeID{to_node_id}},
-                    {penalty, static_cast<std::uint8_t>(file_id)}};
-                local.push_back(std::move(val));
-            });
-
-        util::Log() << "Loaded penalty file " << filename << " with " << local.size()
-                    << " turn penalties";
-
-        {
-            Mutex::scoped_lock _{flatten_mutex};
-
-            map.insert(end(map),
-                       std::make_move_iterator(begin(local)),
-                       std::make_move_iterator(end(local)));
-        }
-    };
-
-    try
-    {
-        tbb::parallel_for(std::size_t{0}, turn_penalty_filenames.size(), parse_turn_penalty_file);
-    }
-    catch (const tbb::captured_exception &e)
-    {
-        throw util::exception(e.what() + SOURCE_REF);
-    }
-
-    // With flattened map-ish view of all the files, sort and unique them on from,to,source
-    // The greater '>' is used here since we want to give files later on higher precedence
-    const auto sort_by = [](const TurnPenaltySource &lhs, const TurnPenaltySource &rhs) {
-        return std::tie(
-                   lhs.segment.from, lhs.segment.via, lhs.segment.to, lhs.penalty_source.source) >
-               std::tie(
-                   rhs.segment.from, rhs.segment.via, rhs.segment.to, rhs.penalty_source.source);
-    };
-
-    std::stable_sort(begin(map), end(map), sort_by);
-
-    // Unique only on from,to to take the source precedence into account and remove duplicates
-    const auto unique_by = [](const TurnPenaltySource &lhs, const TurnPenaltySource &rhs) {
-        return std::tie(lhs.segment.from, lhs.segment.via, lhs.segment.to) ==
-               std::tie(rhs.segment.from, rhs.segment.via, rhs.segment.to);
-    };
-
-    const auto it = std::unique(begin(map), end(map), unique_by);
-
-    map.erase(it, end(map));
-
-    util::Log() << "In total loaded " << turn_penalty_filenames.size()
-                << " turn penalty file(s) with a total of " << map.size() << " unique values";
-
-    return map;
-}
-} // anon ns
-
 EdgeID Contractor::LoadEdgeExpandedGraph(
     std::string const &edge_based_graph_filename,
     util::DeallocatingVector<extractor::EdgeBasedEdge> &edge_based_edge_list,
@@ -607,17 +337,17 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
     edge_based_edge_list.resize(graph_header.number_of_edges);
     util::Log() << "Reading " << graph_header.number_of_edges << " edges from the edge based graph";
 
-    SegmentSpeedSourceFlatMap segment_speed_lookup;
-    TurnPenaltySourceFlatMap turn_penalty_lookup;
+    SegmentSpeedLookup segment_speed_lookup;
+    TurnPenaltyLookup turn_penalty_lookup;
 
     const auto parse_segment_speeds = [&] {
         if (update_edge_weights)
-            segment_speed_lookup = parse_segment_lookup_from_csv_files(segment_speed_filenames);
+            segment_speed_lookup = SegmentSpeedLookup(segment_speed_filenames);
     };
 
     const auto parse_turn_penalties = [&] {
         if (update_turn_penalties)
-            turn_penalty_lookup = parse_turn_penalty_lookup_from_csv_files(turn_penalty_filenames);
+            turn_penalty_lookup = TurnPenaltyLookup(turn_penalty_filenames);
     };
 
     // If we update the edge weights, this file will hold the datasource information for each
@@ -732,11 +462,11 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
                 const double segment_length = util::coordinate_calculation::greatCircleDistance(
                     util::Coordinate{u->lon, u->lat}, util::Coordinate{v->lon, v->lat});
 
-                auto forward_speed_iter = find(
-                    segment_speed_lookup, SegmentSpeedSource{{u->node_id, v->node_id}, {0, 0}});
-                if (forward_speed_iter != segment_speed_lookup.end())
+                const auto forward_speed = segment_speed_lookup.Find(u->node_id, v->node_id);
+                if (forward_speed)
                 {
-                    const auto new_segment_weight = getNewWeight(forward_speed_iter,
+                    const auto new_segment_weight = getNewWeight({u->node_id, v->node_id},
+                                                                 *forward_speed,
                                                                  segment_length,
                                                                  segment_speed_filenames,
                                                                  current_fwd_weight,
@@ -746,10 +476,10 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
                                                leaf_object.fwd_segment_position] =
                         new_segment_weight;
                     m_geometry_datasource[forward_begin + 1 + leaf_object.fwd_segment_position] =
-                        forward_speed_iter->speed_source.source;
+                        forward_speed->source;
 
                     // count statistics for logging
-                    counters[forward_speed_iter->speed_source.source] += 1;
+                    counters[forward_speed->source] += 1;
                 }
                 else
                 {
@@ -760,12 +490,12 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
                 const auto current_rev_weight =
                     m_geometry_rev_weight_list[forward_begin + leaf_object.fwd_segment_position];
 
-                const auto reverse_speed_iter = find(
-                    segment_speed_lookup, SegmentSpeedSource{{v->node_id, u->node_id}, {0, 0}});
+                const auto reverse_speed = segment_speed_lookup.Find(v->node_id, u->node_id);
 
-                if (reverse_speed_iter != segment_speed_lookup.end())
+                if (reverse_speed)
                 {
-                    const auto new_segment_weight = getNewWeight(reverse_speed_iter,
+                    const auto new_segment_weight = getNewWeight({v->node_id, u->node_id},
+                                                                 *reverse_speed,
                                                                  segment_length,
                                                                  segment_speed_filenames,
                                                                  current_rev_weight,
@@ -773,10 +503,10 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
                     m_geometry_rev_weight_list[forward_begin + leaf_object.fwd_segment_position] =
                         new_segment_weight;
                     m_geometry_datasource[forward_begin + leaf_object.fwd_segment_position] =
-                        reverse_speed_iter->speed_source.source;
+                        reverse_speed->source;
 
                     // count statistics for logging
-                    counters[reverse_speed_iter->speed_source.source] += 1;
+                    counters[reverse_speed->source] += 1;
                 }
                 else
                 {
@@ -920,16 +650,14 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
             const auto num_segments = header->num_osm_nodes - 1;
             for (auto i : util::irange<std::size_t>(0, num_segments))
             {
-                auto speed_iter =
-                    find(segment_speed_lookup,
-                         SegmentSpeedSource{
-                             {previous_osm_node_id, segmentblocks[i].this_osm_node_id}, {0, 0}});
-                if (speed_iter != segment_speed_lookup.end())
+                const auto speed = segment_speed_lookup.Find(previous_osm_node_id,
+                                                             segmentblocks[i].this_osm_node_id);
+                if (speed)
                 {
-                    if (speed_iter->speed_source.speed > 0)
+                    if (speed->speed > 0)
                     {
-                        const auto new_segment_weight = distanceAndSpeedToWeight(
-                            segmentblocks[i].segment_length, speed_iter->speed_source.speed);
+                        const auto new_segment_weight =
+                            distanceAndSpeedToWeight(segmentblocks[i].segment_length, speed->speed);
                         new_weight += new_segment_weight;
                     }
                     else
@@ -964,17 +692,15 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
                 continue;
             }
 
-            auto turn_iter = find(
-                turn_penalty_lookup,
-                TurnPenaltySource{
-                    {penaltyblock->from_id, penaltyblock->via_id, penaltyblock->to_id}, {0, 0}});
-            if (turn_iter != turn_penalty_lookup.end())
+            const auto turn_penalty = turn_penalty_lookup.Find(
+                penaltyblock->from_id, penaltyblock->via_id, penaltyblock->to_id);
+            if (turn_penalty)
             {
-                int new_turn_weight = static_cast<int>(turn_iter->penalty_source.penalty * 10);
+                int new_turn_weight = static_cast<int>(turn_penalty->penalty * 10);
 
                 if (new_turn_weight + new_weight < compressed_edge_nodes)
                 {
-                    util::Log(logWARNING) << "turn penalty " << turn_iter->penalty_source.penalty
+                    util::Log(logWARNING) << "turn penalty " << turn_penalty->penalty
                                           << " for turn " << penaltyblock->from_id << ", "
                                           << penaltyblock->via_id << ", " << penaltyblock->to_id
                                           << " is too negative: clamping turn weight to "
@@ -1037,9 +763,143 @@ void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
                                     sizeof(char) * unpacked_bool_flags.size());
 }
 
+void Contractor::CustomizeGraph(
+    const EdgeID max_edge_id,
+    util::DeallocatingVector<extractor::EdgeBasedEdge> &edge_based_edge_list)
+{
+    // a core is not part of the hierarchy, so it can not be customized
+    if (boost::filesystem::exists(config.core_output_path))
+    {
+        storage::io::FileReader core_marker_file(config.core_output_path,
+                                                 storage::io::FileReader::HasNoFingerprint);
+        const auto number_of_core_markers = core_marker_file.ReadElementCount32();
+        std::vector<char> core_markers(number_of_core_markers);
+        core_marker_file.ReadInto(core_markers.data(), number_of_core_markers);
+        if (std::any_of(core_markers.begin(), core_markers.end(), [](const char marker) {
+                return marker != 0;
+            }))
+        {
+            throw util::exception("Can not customize a graph with a core, run a full contraction" +
+                                  SOURCE_REF);
+        }
+    }
+
+    util::Log() << "Loading contracted graph " << config.graph_output_path;
+    util::DeallocatingVector<QueryEdge> contracted_edge_list;
+    {
+        storage::io::FileReader hsgr_file(config.graph_output_path,
+                                          storage::io::FileReader::VerifyFingerprint);
+        const auto header = storage::serialization::readHSGRHeader(hsgr_file);
+        if (header.number_of_nodes != static_cast<std::uint64_t>(max_edge_id) + 2)
+        {
+            throw util::exception(config.graph_output_path +
+                                  " does not match the edge-expanded graph, run a full "
+                                  "contraction" +
+                                  SOURCE_REF);
+        }
+
+        std::vector<storage::serialization::NodeT> node_array(header.number_of_nodes);
+        std::vector<storage::serialization::EdgeT> edge_array(header.number_of_edges);
+        storage::serialization::readHSGR(hsgr_file,
+                                         node_array.data(),
+                                         header.number_of_nodes,
+                                         edge_array.data(),
+                                         header.number_of_edges);
+
+        for (const auto node : util::irange<NodeID>(0, max_edge_id + 1))
+        {
+            for (auto edge = node_array[node].first_edge; edge < node_array[node + 1].first_edge;
+                 ++edge)
+            {
+                contracted_edge_list.push_back(
+                    QueryEdge{node, edge_array[edge].target, edge_array[edge].data});
+            }
+        }
+    }
+
+    TIMER_START(customization);
+    GraphCustomizer graph_customizer(max_edge_id + 1, contracted_edge_list);
+    graph_customizer.Run(edge_based_edge_list);
+    graph_customizer.GetEdges(contracted_edge_list);
+    TIMER_STOP(customization);
+
+    util::Log() << "Customization took " << TIMER_SEC(customization) << " sec";
+
+    // the levels of the last contraction still order the hierarchy for the downward sweep
+    std::vector<float> node_levels;
+    if (boost::filesystem::exists(config.level_output_path))
+    {
+        ReadNodeLevels(node_levels);
+    }
+    WriteContractedGraph(max_edge_id, contracted_edge_list, node_levels);
+}
+
+namespace
+{
+// Orders all nodes by descending contraction level and collects the downward edges ending in
+// every node. Returns false if the levels do not induce a valid sweep order, e.g. if they
+// were read from a stale level cache.
+bool buildDownwardSweep(
+    const std::vector<float> &node_levels,
+    const std::vector<util::StaticGraph<QueryEdge::EdgeData>::NodeArrayEntry> &node_array,
+    const util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+    std::vector<SweepNode> &sweep_nodes,
+    std::vector<NodeID> &sweep_positions,
+    std::vector<SweepEdge> &sweep_edges)
+{
+    const NodeID number_of_nodes = node_array.size() - 1;
+    if (node_levels.size() != number_of_nodes)
+    {
+        return false;
+    }
+
+    std::vector<NodeID> order(number_of_nodes);
+    std::iota(order.begin(), order.end(), 0);
+    tbb::parallel_sort(
+        order.begin(), order.end(), [&node_levels](const NodeID lhs, const NodeID rhs) {
+            return std::tie(node_levels[rhs], lhs) < std::tie(node_levels[lhs], rhs);
+        });
+
+    sweep_positions.resize(number_of_nodes);
+    for (NodeID position = 0; position < number_of_nodes; ++position)
+    {
+        sweep_positions[order[position]] = position;
+    }
+
+    sweep_nodes.resize(number_of_nodes + 1);
+    for (NodeID position = 0; position < number_of_nodes; ++position)
+    {
+        const NodeID node = order[position];
+        sweep_nodes[position].first_edge = sweep_edges.size();
+        for (auto edge = node_array[node].first_edge; edge < node_array[node + 1].first_edge;
+             ++edge)
+        {
+            // edges are stored at the lower node, so a backward edge is a downward edge
+            // from its target into this node
+            const auto &current_edge = contracted_edge_list[edge];
+            if (!current_edge.data.backward || current_edge.target == node)
+            {
+                continue;
+            }
+
+            const NodeID source_position = sweep_positions[current_edge.target];
+            if (source_position >= position)
+            {
+                return false;
+            }
+            sweep_edges.push_back({source_position, current_edge.data.weight});
+        }
+    }
+    sweep_nodes.back().first_edge = sweep_edges.size();
+
+    return true;
+}
+}
+
 std::size_t
 Contractor::WriteContractedGraph(unsigned max_node_id,
-                                 const util::DeallocatingVector<QueryEdge> &contracted_edge_list)
+                                 const util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                                 const std::vector<float> &node_levels)
 {
     // Sorting contracted edges in a way that the static query graph can read some in in-place.
     tbb::parallel_sort(contracted_edge_list.begin(), contracted_edge_list.end());
@@ -1150,6 +1010,38 @@ Contractor::WriteContractedGraph(unsigned max_node_id,
         ++number_of_used_edges;
     }
 
+    // serialize the downward sweep, it stays empty if the levels can't be used for it
+    std::vector<SweepNode> sweep_nodes;
+    std::vector<NodeID> sweep_positions;
+    std::vector<SweepEdge> sweep_edges;
+    if (!node_levels.empty())
+    {
+        util::Log() << "Building downward sweep";
+        if (!buildDownwardSweep(node_levels,
+                                node_array,
+                                contracted_edge_list,
+                                sweep_nodes,
+                                sweep_positions,
+                                sweep_edges))
+        {
+            util::Log(logWARNING) << "Node levels do not form a hierarchy, skipping downward sweep";
+            sweep_nodes.clear();
+            sweep_positions.clear();
+            sweep_edges.clear();
+        }
+    }
+
+    const std::uint64_t sweep_node_count = sweep_nodes.size();
+    const std::uint64_t sweep_edge_count = sweep_edges.size();
+    const std::uint64_t sweep_marker = storage::serialization::HSGR_SWEEP_MARKER;
+    hsgr_output_stream.write((char *)&sweep_marker, sizeof(std::uint64_t));
+    hsgr_output_stream.write((char *)&sweep_node_count, sizeof(std::uint64_t));
+    hsgr_output_stream.write((char *)&sweep_edge_count, sizeof(std::uint64_t));
+    hsgr_output_stream.write((char *)sweep_nodes.data(), sizeof(SweepNode) * sweep_nodes.size());
+    hsgr_output_stream.write((char *)sweep_positions.data(),
+                             sizeof(NodeID) * sweep_positions.size());
+    hsgr_output_stream.write((char *)sweep_edges.data(), sizeof(SweepEdge) * sweep_edges.size());
+
     return number_of_used_edges;
 }
 
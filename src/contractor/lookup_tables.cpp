@@ -0,0 +1,574 @@
+#include "contractor/lookup_tables.hpp"
+
+#include "storage/io.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/fingerprint.hpp"
+#include "util/log.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace osrm
+{
+namespace contractor
+{
+
+namespace
+{
+
+// Files are split into chunks of roughly this size which are parsed in parallel
+const constexpr std::size_t PARSE_CHUNK_SIZE = 4 * 1024 * 1024;
+// Number of entries of the left range a single merge task is responsible for
+const constexpr std::size_t MERGE_GRAIN_SIZE = 64 * 1024;
+
+struct Chunk final
+{
+    std::size_t file_index;
+    const char *first;
+    const char *last;
+};
+
+boost::interprocess::mapped_region mmap_file(const std::string &filename)
+{
+    using boost::interprocess::file_mapping;
+    using boost::interprocess::mapped_region;
+    using boost::interprocess::read_only;
+
+    try
+    {
+        const file_mapping mapping{filename.c_str(), read_only};
+        mapped_region region{mapping, read_only};
+        region.advise(mapped_region::advice_sequential);
+        return region;
+    }
+    catch (const std::exception &e)
+    {
+        throw util::exception("Error opening " + filename + ": " + e.what() + SOURCE_REF);
+    }
+}
+
+// Splits [first, last) into chunks that end right after a newline or at the end of the file
+void splitAtLineBoundaries(const std::size_t file_index,
+                           const char *first,
+                           const char *last,
+                           std::vector<Chunk> &chunks)
+{
+    while (first != last)
+    {
+        auto chunk_last = last;
+        if (static_cast<std::size_t>(last - first) > PARSE_CHUNK_SIZE)
+        {
+            chunk_last = std::find(first + PARSE_CHUNK_SIZE, last, '\n');
+            if (chunk_last != last)
+                ++chunk_last;
+        }
+        chunks.push_back({file_index, first, chunk_last});
+        first = chunk_last;
+    }
+}
+
+// Stable merge of two sorted ranges: the left range is cut into blocks and the matching
+// part of the right range is found by binary search, so all blocks can be merged in parallel.
+template <typename Value, typename Compare>
+void parallelMerge(const std::vector<Value> &lhs,
+                   const std::vector<Value> &rhs,
+                   std::vector<Value> &output,
+                   const Compare &compare)
+{
+    output.resize(lhs.size() + rhs.size());
+    if (lhs.empty())
+    {
+        std::copy(rhs.begin(), rhs.end(), output.begin());
+        return;
+    }
+
+    const auto number_of_blocks = (lhs.size() + MERGE_GRAIN_SIZE - 1) / MERGE_GRAIN_SIZE;
+
+    // Entries of the right range equal to the first entry of a block go behind that block's
+    // equal entries, which is what std::merge does as well
+    const auto split = [&](const std::size_t block) -> std::size_t {
+        if (block == 0)
+            return 0;
+        if (block == number_of_blocks)
+            return rhs.size();
+        return std::lower_bound(rhs.begin(), rhs.end(), lhs[block * MERGE_GRAIN_SIZE], compare) -
+               rhs.begin();
+    };
+
+    tbb::parallel_for(std::size_t{0}, number_of_blocks, [&](const std::size_t block) {
+        const auto lhs_first = block * MERGE_GRAIN_SIZE;
+        const auto lhs_last = std::min(lhs_first + MERGE_GRAIN_SIZE, lhs.size());
+        const auto rhs_first = split(block);
+        const auto rhs_last = split(block + 1);
+
+        std::merge(lhs.begin() + lhs_first,
+                   lhs.begin() + lhs_last,
+                   rhs.begin() + rhs_first,
+                   rhs.begin() + rhs_last,
+                   output.begin() + lhs_first + rhs_first,
+                   compare);
+    });
+}
+
+// Parses all files chunk by chunk, sorts every chunk by `compare` and merges the chunks pairwise
+// in file order. Since merging is stable, the first line of a file wins over later lines with
+// the same key after deduplication with `equal`.
+template <typename Value, typename ParseLine, typename LogFile, typename Compare, typename Equal>
+std::vector<Value> parseLookupFiles(const std::vector<std::string> &filenames,
+                                    const std::string &file_description,
+                                    const ParseLine &parse_line,
+                                    const LogFile &log_file,
+                                    const Compare &compare,
+                                    const Equal &equal)
+{
+    std::vector<boost::interprocess::mapped_region> regions(filenames.size());
+    std::vector<Chunk> chunks;
+
+    for (std::size_t idx = 0; idx < filenames.size(); ++idx)
+    {
+        if (!boost::filesystem::exists(filenames[idx]))
+            throw util::exception("Error opening " + filenames[idx] + SOURCE_REF);
+
+        // Empty files can not be mapped
+        if (boost::filesystem::file_size(filenames[idx]) == 0)
+            continue;
+
+        regions[idx] = mmap_file(filenames[idx]);
+        const auto first = static_cast<const char *>(regions[idx].get_address());
+        splitAtLineBoundaries(idx, first, first + regions[idx].get_size(), chunks);
+    }
+
+    std::vector<std::vector<Value>> runs(chunks.size());
+
+    const auto parse_chunk = [&](const std::size_t chunk_index) {
+        const auto &chunk = chunks[chunk_index];
+        // starts at one, zero means we assigned the weight
+        const auto file_id = static_cast<std::uint8_t>(chunk.file_index + 1);
+        auto &run = runs[chunk_index];
+
+        auto line = chunk.first;
+        while (line != chunk.last)
+        {
+            const auto line_end = std::find(line, chunk.last, '\n');
+
+            Value value;
+            auto it = line;
+            const auto ok = parse_line(it, line_end, file_id, value);
+
+            if (!ok || it != line_end)
+            {
+                // Only count lines when reporting an error, chunks do not know their offset
+                const auto file_first =
+                    static_cast<const char *>(regions[chunk.file_index].get_address());
+                const auto line_number = std::count(file_first, line, '\n') + 1;
+                const std::string message{file_description + " " + filenames[chunk.file_index] +
+                                          " malformed on line " + std::to_string(line_number)};
+                throw util::exception(message + SOURCE_REF);
+            }
+
+            run.push_back(value);
+            line = line_end == chunk.last ? line_end : line_end + 1;
+        }
+
+        std::stable_sort(run.begin(), run.end(), compare);
+    };
+
+    try
+    {
+        tbb::parallel_for(std::size_t{0}, chunks.size(), parse_chunk);
+    }
+    catch (const tbb::captured_exception &e)
+    {
+        throw util::exception(e.what() + SOURCE_REF);
+    }
+
+    std::vector<std::size_t> file_sizes(filenames.size(), 0);
+    for (std::size_t chunk_index = 0; chunk_index < chunks.size(); ++chunk_index)
+    {
+        file_sizes[chunks[chunk_index].file_index] += runs[chunk_index].size();
+    }
+    for (std::size_t idx = 0; idx < filenames.size(); ++idx)
+    {
+        log_file(filenames[idx], file_sizes[idx]);
+    }
+
+    regions.clear();
+
+    // Runs are ordered by file and position in the file, merging neighbours keeps that order
+    // for equal entries
+    while (runs.size() > 1)
+    {
+        std::vector<std::vector<Value>> merged((runs.size() + 1) / 2);
+
+        tbb::parallel_for(std::size_t{0}, merged.size(), [&](const std::size_t idx) {
+            auto &lhs = runs[2 * idx];
+            if (2 * idx + 1 == runs.size())
+            {
+                merged[idx] = std::move(lhs);
+                return;
+            }
+            auto &rhs = runs[2 * idx + 1];
+
+            parallelMerge(lhs, rhs, merged[idx], compare);
+
+            std::vector<Value>().swap(lhs);
+            std::vector<Value>().swap(rhs);
+        });
+
+        runs = std::move(merged);
+    }
+
+    if (runs.empty())
+        return {};
+
+    auto flatten = std::move(runs.front());
+    const auto it = std::unique(flatten.begin(), flatten.end(), equal);
+    flatten.erase(it, flatten.end());
+
+    return flatten;
+}
+
+template <typename Record>
+void writeUpdateFile(const std::string &filename, std::vector<Record> &records)
+{
+    BOOST_ASSERT(std::is_sorted(records.begin(), records.end()));
+
+    storage::io::FileWriter writer(filename, storage::io::FileWriter::GenerateFingerprint);
+
+    UpdateFileHeader header{Record::RECORD_TYPE, sizeof(Record), records.size()};
+    writer.WriteOne(header);
+    writer.WriteFrom(records.data(), records.size());
+}
+
+// Parses the CSV files among `filenames` and maps the binary ones. Sources of the parsed entries
+// are remapped to the position of their file in `filenames`.
+template <typename FlatMap, typename Record, typename ParseCSV, typename SourceOf>
+void loadUpdateFiles(const std::vector<std::string> &filenames,
+                     const ParseCSV &parse_csv,
+                     const SourceOf &source_of,
+                     FlatMap &csv_lookup,
+                     std::vector<MappedUpdateFile<Record>> &binary_files)
+{
+    std::vector<std::string> csv_filenames;
+    std::vector<std::uint8_t> csv_sources;
+
+    for (std::size_t idx = filenames.size(); idx > 0; --idx)
+    {
+        // starts at one, zero means we assigned the weight
+        const auto source = static_cast<std::uint8_t>(idx);
+        if (isBinaryUpdateFile(filenames[idx - 1]))
+        {
+            binary_files.emplace_back(filenames[idx - 1], source);
+        }
+        else
+        {
+            csv_filenames.push_back(filenames[idx - 1]);
+            csv_sources.push_back(source);
+        }
+    }
+
+    if (csv_filenames.empty())
+        return;
+
+    std::reverse(csv_filenames.begin(), csv_filenames.end());
+    std::reverse(csv_sources.begin(), csv_sources.end());
+
+    csv_lookup = parse_csv(csv_filenames);
+    for (auto &entry : csv_lookup)
+    {
+        auto &source = source_of(entry);
+        source = csv_sources[source - 1];
+    }
+}
+
+// Binary search in the files that can still beat the source of `found`, newest file first
+template <typename Source, typename Record, typename MakeSource>
+void findInUpdateFiles(const std::vector<MappedUpdateFile<Record>> &binary_files,
+                       const Record &key,
+                       boost::optional<Source> &found,
+                       const MakeSource &make_source)
+{
+    for (const auto &file : binary_files)
+    {
+        if (found && found->source > file.GetSource())
+            return;
+
+        const auto it = std::lower_bound(file.begin(), file.end(), key);
+        if (it != file.end() && !(key < *it))
+        {
+            found = make_source(*it, file.GetSource());
+            return;
+        }
+    }
+}
+
+}
+
+SegmentSpeedSourceFlatMap
+parse_segment_lookup_from_csv_files(const std::vector<std::string> &segment_speed_filenames)
+{
+    const auto parse_line = [](const char *&it,
+                               const char *last,
+                               const std::uint8_t file_id,
+                               SegmentSpeedSource &value) {
+        using namespace boost::spirit::qi;
+
+        std::uint64_t from_node_id{};
+        std::uint64_t to_node_id{};
+        unsigned speed{};
+
+        // The ulong_long -> uint64_t will likely break on 32bit platforms
+        const auto ok = parse(it,
+                              last, //
+                              (ulong_long >> ',' >> ulong_long >> ',' >> uint_ >>
+                               *(',' >> *char_)), //
+                              from_node_id,
+                              to_node_id,
+                              speed); //
+
+        value = {{OSMNodeID{from_node_id}, OSMNodeID{to_node_id}}, {speed, file_id}};
+        return ok;
+    };
+
+    const auto log_file = [](const std::string &filename, const std::size_t number_of_speeds) {
+        util::Log() << "Loaded speed file " << filename << " with " << number_of_speeds
+                    << " speeds";
+    };
+
+    // With flattened map-ish view of all the files, sort and unique them on from,to,source
+    // The greater '>' is used here since we want to give files later on higher precedence
+    const auto sort_by = [](const SegmentSpeedSource &lhs, const SegmentSpeedSource &rhs) {
+        return std::tie(lhs.segment.from, lhs.segment.to, lhs.speed_source.source) >
+               std::tie(rhs.segment.from, rhs.segment.to, rhs.speed_source.source);
+    };
+
+    // Unique only on from,to to take the source precedence into account and remove duplicates
+    const auto unique_by = [](const SegmentSpeedSource &lhs, const SegmentSpeedSource &rhs) {
+        return std::tie(lhs.segment.from, lhs.segment.to) ==
+               std::tie(rhs.segment.from, rhs.segment.to);
+    };
+
+    auto flatten = parseLookupFiles<SegmentSpeedSource>(
+        segment_speed_filenames, "Segment speed file", parse_line, log_file, sort_by, unique_by);
+
+    util::Log() << "In total loaded " << segment_speed_filenames.size()
+                << " speed file(s) with a total of " << flatten.size() << " unique values";
+
+    return flatten;
+}
+
+TurnPenaltySourceFlatMap
+parse_turn_penalty_lookup_from_csv_files(const std::vector<std::string> &turn_penalty_filenames)
+{
+    const auto parse_line = [](const char *&it,
+                               const char *last,
+                               const std::uint8_t file_id,
+                               TurnPenaltySource &value) {
+        using namespace boost::spirit::qi;
+
+        std::uint64_t from_node_id{};
+        std::uint64_t via_node_id{};
+        std::uint64_t to_node_id{};
+        double penalty{};
+
+        // The ulong_long -> uint64_t will likely break on 32bit platforms
+        const auto ok = parse(it,
+                              last, //
+                              (ulong_long >> ',' >> ulong_long >> ',' >> ulong_long >> ',' >>
+                               double_ >> *(',' >> *char_)), //
+                              from_node_id,
+                              via_node_id,
+                              to_node_id,
+                              penalty); //
+
+        value = {{OSMNodeID{from_node_id}, OSMNodeID{via_node_id}, OSMNodeID{to_node_id}},
+                 {penalty, file_id}};
+        return ok;
+    };
+
+    const auto log_file = [](const std::string &filename, const std::size_t number_of_penalties) {
+        util::Log() << "Loaded penalty file " << filename << " with " << number_of_penalties
+                    << " turn penalties";
+    };
+
+    // With flattened map-ish view of all the files, sort and unique them on from,to,source
+    // The greater '>' is used here since we want to give files later on higher precedence
+    const auto sort_by = [](const TurnPenaltySource &lhs, const TurnPenaltySource &rhs) {
+        return std::tie(
+                   lhs.segment.from, lhs.segment.via, lhs.segment.to, lhs.penalty_source.source) >
+               std::tie(
+                   rhs.segment.from, rhs.segment.via, rhs.segment.to, rhs.penalty_source.source);
+    };
+
+    // Unique only on from,to to take the source precedence into account and remove duplicates
+    const auto unique_by = [](const TurnPenaltySource &lhs, const TurnPenaltySource &rhs) {
+        return std::tie(lhs.segment.from, lhs.segment.via, lhs.segment.to) ==
+               std::tie(rhs.segment.from, rhs.segment.via, rhs.segment.to);
+    };
+
+    auto map = parseLookupFiles<TurnPenaltySource>(
+        turn_penalty_filenames, "Turn penalty file", parse_line, log_file, sort_by, unique_by);
+
+    util::Log() << "In total loaded " << turn_penalty_filenames.size()
+                << " turn penalty file(s) with a total of " << map.size() << " unique values";
+
+    return map;
+}
+bool isBinaryUpdateFile(const std::string &filename)
+{
+    if (!boost::filesystem::exists(filename) ||
+        boost::filesystem::file_size(filename) < sizeof(util::FingerPrint))
+        return false;
+
+    storage::io::FileReader reader(filename, storage::io::FileReader::HasNoFingerprint);
+    return reader.ReadOne<util::FingerPrint>().IsValid();
+}
+
+void writeSegmentSpeedFile(const std::string &filename, const SegmentSpeedSourceFlatMap &lookup)
+{
+    // The flat map is sorted descending
+    std::vector<SegmentSpeedRecord> records;
+    records.reserve(lookup.size());
+    std::transform(
+        lookup.rbegin(), lookup.rend(), std::back_inserter(records), [](const auto &entry) {
+            return SegmentSpeedRecord{
+                entry.segment.from, entry.segment.to, entry.speed_source.speed, 0};
+        });
+
+    writeUpdateFile(filename, records);
+}
+
+void writeTurnPenaltyFile(const std::string &filename, const TurnPenaltySourceFlatMap &lookup)
+{
+    // The flat map is sorted descending
+    std::vector<TurnPenaltyRecord> records;
+    records.reserve(lookup.size());
+    std::transform(
+        lookup.rbegin(), lookup.rend(), std::back_inserter(records), [](const auto &entry) {
+            return TurnPenaltyRecord{entry.segment.from,
+                                     entry.segment.via,
+                                     entry.segment.to,
+                                     entry.penalty_source.penalty};
+        });
+
+    writeUpdateFile(filename, records);
+}
+
+template <typename Record>
+MappedUpdateFile<Record>::MappedUpdateFile(const std::string &filename, const std::uint8_t source)
+    : source(source)
+{
+    storage::io::FileReader reader(filename, storage::io::FileReader::VerifyFingerprint);
+    const auto header = reader.ReadOne<UpdateFileHeader>();
+
+    if (header.record_type != Record::RECORD_TYPE || header.record_size != sizeof(Record))
+    {
+        throw util::exception("Update file " + filename + " holds the wrong kind of records" +
+                              SOURCE_REF);
+    }
+
+    const auto offset = sizeof(util::FingerPrint) + sizeof(UpdateFileHeader);
+    const auto expected_size = offset + header.number_of_records * sizeof(Record);
+    if (boost::filesystem::file_size(filename) != expected_size)
+    {
+        throw util::exception("Update file " + filename + " is truncated" + SOURCE_REF);
+    }
+
+    region = mmap_file(filename);
+    first = reinterpret_cast<const Record *>(static_cast<const char *>(region.get_address()) +
+                                             offset);
+    last = first + header.number_of_records;
+
+    // Lookups rely on the order, so a corrupt file must not be used silently
+    if (!std::is_sorted(first, last))
+    {
+        throw util::exception("Update file " + filename + " is not sorted" + SOURCE_REF);
+    }
+}
+
+template class MappedUpdateFile<SegmentSpeedRecord>;
+template class MappedUpdateFile<TurnPenaltyRecord>;
+
+SegmentSpeedLookup::SegmentSpeedLookup(const std::vector<std::string> &segment_speed_filenames)
+{
+    loadUpdateFiles(
+        segment_speed_filenames,
+        parse_segment_lookup_from_csv_files,
+        [](SegmentSpeedSource &entry) -> std::uint8_t & { return entry.speed_source.source; },
+        csv_lookup,
+        binary_files);
+
+    for (const auto &file : binary_files)
+    {
+        util::Log() << "Mapped speed file " << segment_speed_filenames[file.GetSource() - 1]
+                    << " with " << file.size() << " speeds";
+    }
+}
+
+boost::optional<SpeedSource> SegmentSpeedLookup::Find(const OSMNodeID from,
+                                                       const OSMNodeID to) const
+{
+    boost::optional<SpeedSource> found;
+
+    const auto it = find(csv_lookup, SegmentSpeedSource{{from, to}, {0, 0}});
+    if (it != csv_lookup.end())
+        found = it->speed_source;
+
+    findInUpdateFiles(
+        binary_files,
+        SegmentSpeedRecord{from, to, 0, 0},
+        found,
+        [](const SegmentSpeedRecord &record, const std::uint8_t source) {
+            return SpeedSource{record.speed, source};
+        });
+
+    return found;
+}
+
+TurnPenaltyLookup::TurnPenaltyLookup(const std::vector<std::string> &turn_penalty_filenames)
+{
+    loadUpdateFiles(
+        turn_penalty_filenames,
+        parse_turn_penalty_lookup_from_csv_files,
+        [](TurnPenaltySource &entry) -> std::uint8_t & { return entry.penalty_source.source; },
+        csv_lookup,
+        binary_files);
+
+    for (const auto &file : binary_files)
+    {
+        util::Log() << "Mapped penalty file " << turn_penalty_filenames[file.GetSource() - 1]
+                    << " with " << file.size() << " turn penalties";
+    }
+}
+
+boost::optional<PenaltySource>
+TurnPenaltyLookup::Find(const OSMNodeID from, const OSMNodeID via, const OSMNodeID to) const
+{
+    boost::optional<PenaltySource> found;
+
+    const auto it = find(csv_lookup, TurnPenaltySource{{from, via, to}, {0., 0}});
+    if (it != csv_lookup.end())
+        found = it->penalty_source;
+
+    findInUpdateFiles(
+        binary_files,
+        TurnPenaltyRecord{from, via, to, 0.},
+        found,
+        [](const TurnPenaltyRecord &record, const std::uint8_t source) {
+            return PenaltySource{record.penalty, source};
+        });
+
+    return found;
+}
+}
+}
@@ -15,6 +15,7 @@
 #include <boost/interprocess/sync/sharable_lock.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <memory>
 #include <utility>
@@ -55,14 +56,28 @@ namespace engine
 Engine::Engine(const EngineConfig &config)
     : lock(config.use_shared_memory ? std::make_unique<storage::SharedBarriers>()
                                     : std::unique_ptr<storage::SharedBarriers>()),
-      route_plugin(config.max_locations_viaroute),       //
-      table_plugin(config.max_locations_distance_table), //
-      nearest_plugin(config.max_results_nearest),        //
-      trip_plugin(config.max_locations_trip),            //
-      match_plugin(config.max_locations_map_matching),   //
-      tile_plugin()                                      //
+      batch_arena(std::make_shared<tbb::task_arena>(
+          config.max_batch_threads > 0 ? config.max_batch_threads
+                                       : static_cast<int>(tbb::task_arena::automatic))),
+      route_plugin(config.max_locations_viaroute,
+                   static_cast<std::size_t>(config.result_cache_size) * 1024 * 1024), //
+      table_plugin(config.max_locations_distance_table,
+                   config.max_table_threads,
+                   static_cast<std::size_t>(config.result_cache_size) * 1024 * 1024), //
+      nearest_plugin(config.max_results_nearest),                                     //
+      trip_plugin(config.max_locations_trip),                                         //
+      match_plugin(config.max_locations_map_matching),                                //
+      tile_plugin(),                                                                  //
+      isochrone_plugin(config.max_duration_isochrone),                                //
+      batch_route_plugin(config.max_pairs_batch_route, batch_arena),                  //
+      batch_nearest_plugin(config.max_locations_batch_nearest,
+                           config.max_results_nearest,
+                           batch_arena)                                               //
 
 {
+    const auto snapping_cache_size =
+        static_cast<std::size_t>(config.snapping_cache_size) * 1024 * 1024;
+
     if (config.use_shared_memory)
     {
         if (!DataWatchdog::TryConnect())
@@ -73,7 +88,7 @@ Engine::Engine(const EngineConfig &config)
                 SOURCE_REF);
         }
 
-        watchdog = std::make_unique<DataWatchdog>();
+        watchdog = std::make_unique<DataWatchdog>(snapping_cache_size, config.warm_up);
         BOOST_ASSERT(watchdog);
     }
     else
@@ -82,8 +97,13 @@ Engine::Engine(const EngineConfig &config)
         {
             throw util::exception("Invalid file paths given!" + SOURCE_REF);
         }
-        immutable_data_facade =
-            std::make_shared<datafacade::ProcessMemoryDataFacade>(config.storage_config);
+        auto facade = std::make_shared<datafacade::ProcessMemoryDataFacade>(config.storage_config);
+        facade->InitializeSnappingCache(snapping_cache_size);
+        if (config.warm_up)
+        {
+            facade->WarmUp();
+        }
+        immutable_data_facade = std::move(facade);
     }
 }
 
@@ -92,11 +112,26 @@ Status Engine::Route(const api::RouteParameters &params, util::json::Object &res
     return RunQuery(watchdog, immutable_data_facade, params, route_plugin, result);
 }
 
+Status Engine::Route(const api::RouteParameters &params, std::string &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, route_plugin, result);
+}
+
 Status Engine::Table(const api::TableParameters &params, util::json::Object &result) const
 {
     return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
 }
 
+Status Engine::Table(const api::TableParameters &params, util::json::Writer &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
+}
+
+Status Engine::Table(const api::TableParameters &params, std::string &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
+}
+
 Status Engine::Nearest(const api::NearestParameters &params, util::json::Object &result) const
 {
     return RunQuery(watchdog, immutable_data_facade, params, nearest_plugin, result);
@@ -112,10 +147,50 @@ Status Engine::Match(const api::MatchParameters &params, util::json::Object &res
     return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result);
 }
 
+Status Engine::Match(const api::MatchParameters &params, util::json::Writer &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result);
+}
+
+Status Engine::Match(const api::MatchParameters &params, std::string &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result);
+}
+
 Status Engine::Tile(const api::TileParameters &params, std::string &result) const
 {
     return RunQuery(watchdog, immutable_data_facade, params, tile_plugin, result);
 }
 
+Status Engine::Isochrone(const api::IsochroneParameters &params,
+                         util::json::Object &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, isochrone_plugin, result);
+}
+
+Status Engine::BatchRoute(const api::BatchRouteParameters &params,
+                          util::json::Object &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, batch_route_plugin, result);
+}
+
+Status Engine::BatchRoute(const api::BatchRouteParameters &params,
+                          util::json::Writer &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, batch_route_plugin, result);
+}
+
+Status Engine::BatchNearest(const api::BatchNearestParameters &params,
+                            util::json::Object &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, batch_nearest_plugin, result);
+}
+
+Status Engine::BatchNearest(const api::BatchNearestParameters &params,
+                            util::json::Writer &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, batch_nearest_plugin, result);
+}
+
 } // engine ns
 } // osrm ns
@@ -23,7 +23,13 @@ bool EngineConfig::IsValid() const
                               unlimited_or_more_than(max_locations_map_matching, 2) &&
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
-                              unlimited_or_more_than(max_results_nearest, 0);
+                              unlimited_or_more_than(max_results_nearest, 0) &&
+                              max_table_threads >= -1 &&
+                              unlimited_or_more_than(max_duration_isochrone, 0) &&
+                              unlimited_or_more_than(max_pairs_batch_route, 0) &&
+                              unlimited_or_more_than(max_locations_batch_nearest, 0) &&
+                              max_batch_threads >= -1 &&
+                              result_cache_size >= 0 && snapping_cache_size >= 0;
 
     return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) && limits_valid;
 }
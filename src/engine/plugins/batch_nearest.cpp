@@ -0,0 +1,115 @@
+#include "engine/plugins/batch_nearest.hpp"
+
+#include "engine/api/batch_nearest_api.hpp"
+#include "engine/api/batch_nearest_parameters.hpp"
+#include "engine/phantom_node.hpp"
+#include "util/hilbert_value.hpp"
+#include "util/metrics.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+namespace
+{
+// Coordinates snapped by one task, a task covers a stretch of the Hilbert curve
+const constexpr std::size_t COORDINATES_GRAIN_SIZE = 64;
+}
+
+BatchNearestPlugin::BatchNearestPlugin(const int max_locations_batch_nearest,
+                                       const int max_results,
+                                       std::shared_ptr<tbb::task_arena> batch_arena)
+    : max_locations_batch_nearest(max_locations_batch_nearest), max_results(max_results),
+      batch_arena(std::move(batch_arena))
+{
+    BOOST_ASSERT(this->batch_arena);
+}
+
+Status BatchNearestPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                         const api::BatchNearestParameters &params,
+                                         util::json::Object &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+Status BatchNearestPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                         const api::BatchNearestParameters &params,
+                                         util::json::Writer &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+template <typename ResultT>
+Status
+BatchNearestPlugin::HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                      const api::BatchNearestParameters &params,
+                                      ResultT &result) const
+{
+    BOOST_ASSERT(params.IsValid());
+
+    if (max_locations_batch_nearest > 0 &&
+        params.coordinates.size() > static_cast<std::size_t>(max_locations_batch_nearest))
+    {
+        return Error("TooBig",
+                     "Number of entries " + std::to_string(params.coordinates.size()) +
+                         " is higher than current maximum (" +
+                         std::to_string(max_locations_batch_nearest) + ")",
+                     result);
+    }
+
+    if (max_results > 0 && params.number_of_results > static_cast<unsigned>(max_results))
+    {
+        return Error("TooBig",
+                     "Number of results " + std::to_string(params.number_of_results) +
+                         " is higher than current maximum (" + std::to_string(max_results) + ")",
+                     result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+    {
+        return Error("InvalidValue", "Invalid coordinate value.", result);
+    }
+
+    std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(params.coordinates.size());
+    {
+        util::metrics::ScopedStage snapping_stage(util::metrics::Stage::Snapping);
+
+        // The k nearest lookups always query the r-tree, the snapping cache only holds the
+        // results of NearestPhantomNodeWithAlternativeFromBigComponent.
+        const auto order = util::HilbertOrder(params.coordinates);
+        batch_arena->execute([&] {
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(0, order.size(), COORDINATES_GRAIN_SIZE),
+                [&](const tbb::blocked_range<std::size_t> &range) {
+                    for (auto position = range.begin(); position != range.end(); ++position)
+                    {
+                        const auto index = order[position];
+                        phantom_nodes[index] =
+                            GetPhantomNodes(*facade, params, index, params.number_of_results);
+                    }
+                });
+        });
+    }
+
+    util::metrics::ScopedStage render_stage(util::metrics::Stage::Render);
+    api::BatchNearestAPI batch_nearest_api(*facade, params);
+    batch_nearest_api.MakeResponse(phantom_nodes, result);
+
+    return Status::Ok;
+}
+}
+}
+}
@@ -0,0 +1,122 @@
+#include "engine/plugins/batch_route.hpp"
+
+#include "engine/api/batch_route_api.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/internal_route_result.hpp"
+#include "engine/phantom_node.hpp"
+#include "util/metrics.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+namespace
+{
+// Pairs searched by one task, a single search is short so tasks take a few of them
+const constexpr std::size_t PAIRS_GRAIN_SIZE = 8;
+}
+
+BatchRoutePlugin::BatchRoutePlugin(const int max_pairs_batch_route,
+                                   std::shared_ptr<tbb::task_arena> batch_arena)
+    : direct_shortest_path(heaps), max_pairs_batch_route(max_pairs_batch_route),
+      batch_arena(std::move(batch_arena))
+{
+    BOOST_ASSERT(this->batch_arena);
+}
+
+Status BatchRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                       const api::BatchRouteParameters &params,
+                                       util::json::Object &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+Status BatchRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                       const api::BatchRouteParameters &params,
+                                       util::json::Writer &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+template <typename ResultT>
+Status
+BatchRoutePlugin::HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                    const api::BatchRouteParameters &params,
+                                    ResultT &result) const
+{
+    BOOST_ASSERT(params.IsValid());
+
+    if (max_pairs_batch_route > 0 &&
+        (params.pairs.size() > static_cast<std::size_t>(max_pairs_batch_route) ||
+         params.coordinates.size() > static_cast<std::size_t>(max_pairs_batch_route)))
+    {
+        return Error("TooBig",
+                     "Number of pairs " + std::to_string(params.pairs.size()) +
+                         " or coordinates " + std::to_string(params.coordinates.size()) +
+                         " is higher than current maximum (" +
+                         std::to_string(max_pairs_batch_route) + ")",
+                     result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+    {
+        return Error("InvalidValue", "Invalid coordinate value.", result);
+    }
+
+    // coordinates used by several pairs are only snapped once
+    const auto phantom_node_pairs = GetPhantomNodes(*facade, params);
+    if (phantom_node_pairs.size() != params.coordinates.size())
+    {
+        return Error("NoSegment",
+                     std::string("Could not find a matching segment for coordinate ") +
+                         std::to_string(phantom_node_pairs.size()),
+                     result);
+    }
+    const auto snapped_phantoms = SnapPhantomNodes(phantom_node_pairs);
+
+    const auto &routing_facade = GetRoutingFacade(*facade);
+    const api::BatchRouteAPI batch_route_api{*facade, params};
+
+    // Every pair is searched and assembled on its own, so the route objects are built in
+    // parallel as well. Only the final response is written sequentially.
+    std::vector<util::json::Value> routes(params.pairs.size());
+    {
+        util::metrics::ScopedStage search_stage(util::metrics::Stage::Search);
+        batch_arena->execute([&] {
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(0, params.pairs.size(), PAIRS_GRAIN_SIZE),
+                [&](const tbb::blocked_range<std::size_t> &range) {
+                    for (auto index = range.begin(); index != range.end(); ++index)
+                    {
+                        const auto &pair = params.pairs[index];
+                        InternalRouteResult route;
+                        route.segment_end_coordinates.push_back(PhantomNodes{
+                            snapped_phantoms[pair.first], snapped_phantoms[pair.second]});
+                        direct_shortest_path(routing_facade, route.segment_end_coordinates, route);
+                        routes[index] = batch_route_api.MakeBatchRoute(route);
+                    }
+                });
+        });
+    }
+
+    util::metrics::ScopedStage render_stage(util::metrics::Stage::Render);
+    batch_route_api.MakeResponse(snapped_phantoms, std::move(routes), result);
+
+    return Status::Ok;
+}
+}
+}
+}
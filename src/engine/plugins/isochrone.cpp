@@ -0,0 +1,248 @@
+#include "engine/plugins/isochrone.hpp"
+#include "engine/api/isochrone_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/phantom_node.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/integer_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+namespace
+{
+// The polygon has at most one vertex per sector around the source
+const constexpr std::size_t NUMBER_OF_POLYGON_SECTORS = 72;
+// Longest duration in seconds that still fits into an EdgeWeight (deci-seconds)
+const constexpr double MAX_DURATION = INVALID_EDGE_WEIGHT / 10;
+// Segments are only collected in this distance around the source, so a huge duration does not
+// turn into a lookup of every segment on the planet
+const constexpr double MAX_SEARCH_RADIUS = 1000 * 1000.;
+// Half size of the square returned if the reached locations do not enclose an area
+const constexpr double MIN_POLYGON_RADIUS = 1.;
+
+// Bounding box around `center` that contains every location in `radius` meters
+std::pair<util::Coordinate, util::Coordinate> boundingBox(const util::Coordinate center,
+                                                          const double radius)
+{
+    namespace detail = util::coordinate_calculation::detail;
+
+    const double lat = static_cast<double>(util::toFloating(center.lat));
+    const double lon = static_cast<double>(util::toFloating(center.lon));
+    const double lat_delta = detail::radToDeg(radius / detail::EARTH_RADIUS);
+    // close to the poles the longitude delta grows without bounds
+    const double lon_delta =
+        std::min(180., lat_delta / std::max(std::cos(detail::degToRad(lat)), 1e-6));
+
+    const util::Coordinate south_west{util::FloatLongitude{std::max(lon - lon_delta, -180.)},
+                                      util::FloatLatitude{std::max(lat - lat_delta, -90.)}};
+    const util::Coordinate north_east{util::FloatLongitude{std::min(lon + lon_delta, 180.)},
+                                      util::FloatLatitude{std::min(lat + lat_delta, 90.)}};
+    return std::make_pair(south_west, north_east);
+}
+
+// Star shaped concave hull: the farthest reachable location of every sector around the center,
+// in counter-clockwise order as required by GeoJSON.
+std::vector<util::Coordinate> makePolygon(const util::Coordinate center,
+                                          const std::vector<util::Coordinate> &locations)
+{
+    std::vector<double> sector_distances(NUMBER_OF_POLYGON_SECTORS, -1.);
+    std::vector<util::Coordinate> sector_locations(NUMBER_OF_POLYGON_SECTORS);
+    for (const auto location : locations)
+    {
+        if (location == center)
+        {
+            continue;
+        }
+
+        const auto bearing = util::coordinate_calculation::bearing(center, location);
+        const auto sector = std::min(
+            static_cast<std::size_t>(bearing * NUMBER_OF_POLYGON_SECTORS / 360.),
+            NUMBER_OF_POLYGON_SECTORS - 1);
+        const auto distance = util::coordinate_calculation::haversineDistance(center, location);
+        if (distance > sector_distances[sector])
+        {
+            sector_distances[sector] = distance;
+            sector_locations[sector] = location;
+        }
+    }
+
+    std::vector<util::Coordinate> polygon;
+    // bearings go clockwise, so walk the sectors backwards
+    for (auto sector = NUMBER_OF_POLYGON_SECTORS; sector > 0; --sector)
+    {
+        if (sector_distances[sector - 1] >= 0)
+        {
+            polygon.push_back(sector_locations[sector - 1]);
+        }
+    }
+
+    // too few sectors to form a ring, return the square around the source that contains all
+    // reached locations instead
+    if (polygon.size() < 3)
+    {
+        const auto radius = std::max(
+            MIN_POLYGON_RADIUS, *std::max_element(sector_distances.begin(), sector_distances.end()));
+        const auto box = boundingBox(center, radius);
+        polygon = {box.first,
+                   util::Coordinate{box.second.lon, box.first.lat},
+                   box.second,
+                   util::Coordinate{box.first.lon, box.second.lat}};
+    }
+
+    return polygon;
+}
+}
+
+IsochronePlugin::IsochronePlugin(const int max_duration_)
+    : sweep(heaps), max_duration{max_duration_}
+{
+}
+
+Status IsochronePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                      const api::IsochroneParameters &params,
+                                      util::json::Object &json_result) const
+{
+    BOOST_ASSERT(params.IsValid());
+
+    if (max_duration > 0 && params.duration > max_duration)
+    {
+        return Error("TooBig",
+                     "Duration " + std::to_string(params.duration) +
+                         " is higher than current maximum (" + std::to_string(max_duration) + ")",
+                     json_result);
+    }
+
+    if (params.duration > MAX_DURATION)
+    {
+        return Error("InvalidValue",
+                     "Duration " + std::to_string(params.duration) + " is out of range",
+                     json_result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+    {
+        return Error("InvalidOptions", "Coordinates are invalid", json_result);
+    }
+
+    if (!facade->HasDownwardSweep())
+    {
+        return Error("NotImplemented",
+                     "Isochrones need a dataset that was fully contracted (no core)",
+                     json_result);
+    }
+
+    const auto phantom_node_pairs = GetPhantomNodes(*facade, params);
+    if (phantom_node_pairs.size() != params.coordinates.size())
+    {
+        return Error("NoSegment", "Could not find a matching segment for coordinate", json_result);
+    }
+    const auto source = SnapPhantomNodes(phantom_node_pairs).front();
+
+    const EdgeWeight max_weight = static_cast<EdgeWeight>(std::ceil(params.duration * 10));
+    const auto &routing_facade = GetRoutingFacade(*facade);
+    const auto &weights = sweep.Sweep(routing_facade, source);
+
+    // Nothing outside of this box can be reached in time, even at the highest speed
+    const auto bounding_box =
+        boundingBox(source.location,
+                    std::min(MAX_SEARCH_RADIUS, params.duration * facade->GetMapMatchingMaxSpeed()));
+    const auto edges = facade->GetEdgesInBox(bounding_box.first, bounding_box.second);
+
+    std::vector<api::IsochroneSegment> segments;
+    std::vector<util::Coordinate> reached_locations;
+    reached_locations.push_back(source.location);
+
+    const auto add_segment = [&](const NodeID node,
+                                 const datafacade::WeightRange &segment_weights,
+                                 const std::size_t segment_index,
+                                 const util::Coordinate from,
+                                 const util::Coordinate to) {
+        const EdgeWeight node_weight = weights[routing_facade.GetSweepPosition(node)];
+        if (node_weight == INVALID_EDGE_WEIGHT)
+        {
+            return;
+        }
+
+        BOOST_ASSERT(segment_index < segment_weights.size());
+        const EdgeWeight from_weight =
+            node_weight + std::accumulate(segment_weights.begin(),
+                                          segment_weights.begin() + segment_index,
+                                          EdgeWeight{0});
+        const EdgeWeight to_weight = from_weight + segment_weights[segment_index];
+        // only the part of the source segment behind the source has a negative weight
+        if (from_weight > max_weight || to_weight < 0)
+        {
+            return;
+        }
+
+        segments.push_back({from, to, from_weight, to_weight});
+        if (from_weight >= 0)
+        {
+            reached_locations.push_back(from);
+        }
+        if (to_weight <= max_weight)
+        {
+            reached_locations.push_back(to);
+        }
+        else
+        {
+            // the budget runs out on this segment
+            const double factor =
+                static_cast<double>(max_weight - from_weight) / (to_weight - from_weight);
+            reached_locations.push_back(
+                util::coordinate_calculation::interpolateLinear(factor, from, to));
+        }
+    };
+
+    for (const auto &edge : edges)
+    {
+        const auto from = facade->GetCoordinateOfNode(edge.u);
+        const auto to = facade->GetCoordinateOfNode(edge.v);
+
+        if (edge.forward_segment_id.enabled)
+        {
+            const auto forward_weights =
+                routing_facade.GetUncompressedForwardWeightsRange(edge.packed_geometry_id);
+            add_segment(
+                edge.forward_segment_id.id, forward_weights, edge.fwd_segment_position, from, to);
+        }
+        if (edge.reverse_segment_id.enabled)
+        {
+            const auto reverse_weights =
+                routing_facade.GetUncompressedReverseWeightsRange(edge.packed_geometry_id);
+            add_segment(edge.reverse_segment_id.id,
+                        reverse_weights,
+                        reverse_weights.size() - edge.fwd_segment_position - 1,
+                        to,
+                        from);
+        }
+    }
+
+    std::vector<util::Coordinate> polygon;
+    if (params.output == api::IsochroneParameters::OutputType::Polygon)
+    {
+        polygon = makePolygon(source.location, reached_locations);
+    }
+
+    api::IsochroneAPI isochrone_api(*facade, params);
+    isochrone_api.MakeResponse(source, segments, polygon, json_result);
+
+    return Status::Ok;
+}
+}
+}
+}
@@ -8,6 +8,7 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_util.hpp"
+#include "util/metrics.hpp"
 #include "util/string_util.hpp"
 
 #include <cstdlib>
@@ -111,6 +112,34 @@ void filterCandidates(const std::vector<util::Coordinate> &coordinates,
 Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                                   const api::MatchParameters &parameters,
                                   util::json::Object &json_result) const
+{
+    return HandleRequestImpl(facade, parameters, json_result);
+}
+
+Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::MatchParameters &parameters,
+                                  util::json::Writer &json_result) const
+{
+    return HandleRequestImpl(facade, parameters, json_result);
+}
+
+Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::MatchParameters &parameters,
+                                  std::string &pbf_result) const
+{
+    if (parameters.steps || parameters.annotations)
+    {
+        return Error("InvalidOptions",
+                     "Steps and annotations are not supported by the pbf format",
+                     pbf_result);
+    }
+    return HandleRequestImpl(facade, parameters, pbf_result);
+}
+
+template <typename ResultT>
+Status MatchPlugin::HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                      const api::MatchParameters &parameters,
+                                      ResultT &json_result) const
 {
     BOOST_ASSERT(parameters.IsValid());
 
@@ -179,42 +208,53 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFaca
                      json_result);
     }
 
-    // call the actual map matching
-    SubMatchingList sub_matchings = map_matching(*facade,
-                                                 candidates_lists,
-                                                 parameters.coordinates,
-                                                 parameters.timestamps,
-                                                 parameters.radiuses);
+    const auto &routing_facade = GetRoutingFacade(*facade);
 
-    if (sub_matchings.size() == 0)
+    SubMatchingList sub_matchings;
+    std::vector<InternalRouteResult> sub_routes;
     {
-        return Error("NoMatch", "Could not match the trace.", json_result);
-    }
+        util::metrics::ScopedStage search_stage(util::metrics::Stage::Search);
 
-    std::vector<InternalRouteResult> sub_routes(sub_matchings.size());
-    for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
-    {
-        BOOST_ASSERT(sub_matchings[index].nodes.size() > 1);
+        // call the actual map matching
+        sub_matchings = map_matching(routing_facade,
+                                     candidates_lists,
+                                     parameters.coordinates,
+                                     parameters.timestamps,
+                                     parameters.radiuses);
 
-        // FIXME we only run this to obtain the geometry
-        // The clean way would be to get this directly from the map matching plugin
-        PhantomNodes current_phantom_node_pair;
-        for (unsigned i = 0; i < sub_matchings[index].nodes.size() - 1; ++i)
+        if (sub_matchings.size() == 0)
         {
-            current_phantom_node_pair.source_phantom = sub_matchings[index].nodes[i];
-            current_phantom_node_pair.target_phantom = sub_matchings[index].nodes[i + 1];
-            BOOST_ASSERT(current_phantom_node_pair.source_phantom.IsValid());
-            BOOST_ASSERT(current_phantom_node_pair.target_phantom.IsValid());
-            sub_routes[index].segment_end_coordinates.emplace_back(current_phantom_node_pair);
+            return Error("NoMatch", "Could not match the trace.", json_result);
+        }
+
+        sub_routes.resize(sub_matchings.size());
+        for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            BOOST_ASSERT(sub_matchings[index].nodes.size() > 1);
+
+            // FIXME we only run this to obtain the geometry
+            // The clean way would be to get this directly from the map matching plugin
+            PhantomNodes current_phantom_node_pair;
+            for (unsigned i = 0; i < sub_matchings[index].nodes.size() - 1; ++i)
+            {
+                current_phantom_node_pair.source_phantom = sub_matchings[index].nodes[i];
+                current_phantom_node_pair.target_phantom = sub_matchings[index].nodes[i + 1];
+                BOOST_ASSERT(current_phantom_node_pair.source_phantom.IsValid());
+                BOOST_ASSERT(current_phantom_node_pair.target_phantom.IsValid());
+                sub_routes[index].segment_end_coordinates.emplace_back(current_phantom_node_pair);
+            }
+            // force uturns to be on, since we split the phantom nodes anyway and only have
+            // bi-directional
+            // phantom nodes for possible uturns
+            shortest_path(routing_facade,
+                          sub_routes[index].segment_end_coordinates,
+                          {false},
+                          sub_routes[index]);
+            BOOST_ASSERT(sub_routes[index].shortest_path_length != INVALID_EDGE_WEIGHT);
         }
-        // force uturns to be on, since we split the phantom nodes anyway and only have
-        // bi-directional
-        // phantom nodes for possible uturns
-        shortest_path(
-            *facade, sub_routes[index].segment_end_coordinates, {false}, sub_routes[index]);
-        BOOST_ASSERT(sub_routes[index].shortest_path_length != INVALID_EDGE_WEIGHT);
     }
 
+    util::metrics::ScopedStage guidance_stage(util::metrics::Stage::Guidance);
     api::MatchAPI match_api{*facade, parameters};
     match_api.MakeResponse(sub_matchings, sub_routes, json_result);
 
@@ -3,8 +3,10 @@
 #include "engine/api/table_api.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/one_to_many_sweep.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/json_container.hpp"
+#include "util/metrics.hpp"
 #include "util/string_util.hpp"
 
 #include <cstdlib>
@@ -23,14 +25,52 @@ namespace engine
 namespace plugins
 {
 
-TablePlugin::TablePlugin(const int max_locations_distance_table)
-    : distance_table(heaps), max_locations_distance_table(max_locations_distance_table)
+namespace
 {
+// Above this number of targets a single sweep per source is cheaper
+// than running one backward search per target.
+const constexpr std::size_t MIN_TARGETS_FOR_SWEEP = 1000;
+}
+
+TablePlugin::TablePlugin(const int max_locations_distance_table,
+                         const int max_table_threads,
+                         const std::size_t result_cache_size)
+    : distance_table(heaps, true), sweep_table(heaps, true),
+      max_locations_distance_table(max_locations_distance_table),
+      table_arena(max_table_threads > 0 ? max_table_threads
+                                        : static_cast<int>(tbb::task_arena::automatic))
+{
+    if (result_cache_size > 0)
+    {
+        table_cache = std::make_unique<ResultCache<std::vector<EdgeWeight>>>(result_cache_size);
+    }
 }
 
 Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                                   const api::TableParameters &params,
                                   util::json::Object &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::TableParameters &params,
+                                  util::json::Writer &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::TableParameters &params,
+                                  std::string &result) const
+{
+    return HandleRequestImpl(facade, params, result);
+}
+
+template <typename ResultT>
+Status TablePlugin::HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                      const api::TableParameters &params,
+                                      ResultT &result) const
 {
     BOOST_ASSERT(params.IsValid());
 
@@ -60,14 +100,55 @@ Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFaca
     }
 
     auto snapped_phantoms = SnapPhantomNodes(GetPhantomNodes(*facade, params));
-    auto result_table =
-        distance_table(*facade, snapped_phantoms, params.sources, params.destinations);
+    // The many-to-many search splits the matrix into per row and per column tasks that run
+    // in parallel on the worker threads of the table arena. Very wide tables use one downward
+    // sweep per row instead if the dataset provides it.
+    const bool use_sweep =
+        num_destinations > MIN_TARGETS_FOR_SWEEP && facade->HasDownwardSweep();
+    const auto &routing_facade = GetRoutingFacade(*facade);
+    const auto compute_table = [&] {
+        util::metrics::ScopedStage search_stage(util::metrics::Stage::Search);
+        std::vector<EdgeWeight> table;
+        const auto search = [&] {
+            if (use_sweep)
+            {
+                util::metrics::Increment(util::metrics::Counter::TableSweeps);
+                table = sweep_table(
+                    routing_facade, snapped_phantoms, params.sources, params.destinations);
+            }
+            else
+            {
+                table = distance_table(
+                    routing_facade, snapped_phantoms, params.sources, params.destinations);
+            }
+        };
+        table_arena.execute(search);
+        return table;
+    };
+
+    // identical searches are answered from the cache, the response is still built per request
+    std::shared_ptr<const std::vector<EdgeWeight>> cached_table;
+    std::vector<EdgeWeight> computed_table;
+    if (table_cache)
+    {
+        ResultCacheKey key;
+        key.Add(snapped_phantoms).Add(params.sources).Add(params.destinations);
+        cached_table =
+            table_cache->GetOrCompute(facade->GetDataVersion(), key.key, compute_table);
+    }
+    else
+    {
+        computed_table = compute_table();
+    }
+    const auto &result_table = cached_table ? *cached_table : computed_table;
 
     if (result_table.empty())
     {
         return Error("NoTable", "No table found", result);
     }
 
+    // the table response is rendered directly, there is no separate render step
+    util::metrics::ScopedStage render_stage(util::metrics::Stage::Render);
     api::TableAPI table_api{*facade, params};
     table_api.MakeResponse(result_table, snapped_phantoms, result);
 
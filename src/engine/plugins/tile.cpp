@@ -455,7 +455,7 @@ Status TilePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
         //  uv is the "approach"
         //  vw is the "exit"
         std::vector<contractor::QueryEdge::EdgeData> unpacked_shortcut;
-        std::vector<EdgeWeight> approach_weight_vector;
+        datafacade::WeightRange approach_weight_range;
 
         // Make sure we traverse the startnodes in a consistent order
         // to ensure identical PBF encoding on all platforms.
@@ -535,18 +535,18 @@ Status TilePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
                         if (edge_based_node_info[approachedge.edge_based_node_id]
                                 .is_geometry_forward)
                         {
-                            approach_weight_vector = facade->GetUncompressedForwardWeights(
+                            approach_weight_range = facade->GetUncompressedForwardWeightsRange(
                                 edge_based_node_info[approachedge.edge_based_node_id]
                                     .packed_geometry_id);
                         }
                         else
                         {
-                            approach_weight_vector = facade->GetUncompressedReverseWeights(
+                            approach_weight_range = facade->GetUncompressedReverseWeightsRange(
                                 edge_based_node_info[approachedge.edge_based_node_id]
                                     .packed_geometry_id);
                         }
-                        const auto sum_node_weight = std::accumulate(approach_weight_vector.begin(),
-                                                                     approach_weight_vector.end(),
+                        const auto sum_node_weight = std::accumulate(approach_weight_range.begin(),
+                                                                     approach_weight_range.end(),
                                                                      EdgeWeight{0});
 
                         // The edge.weight is the whole edge weight, which includes the turn
@@ -619,16 +619,16 @@ Status TilePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
     {
         const auto &edge = edges[edge_index];
 
-        const auto forward_datasource_vector =
-            facade->GetUncompressedForwardDatasources(edge.packed_geometry_id);
-        const auto reverse_datasource_vector =
-            facade->GetUncompressedReverseDatasources(edge.packed_geometry_id);
+        const auto forward_datasource_range =
+            facade->GetUncompressedForwardDatasourcesRange(edge.packed_geometry_id);
+        const auto reverse_datasource_range =
+            facade->GetUncompressedReverseDatasourcesRange(edge.packed_geometry_id);
 
-        BOOST_ASSERT(edge.fwd_segment_position < forward_datasource_vector.size());
-        const auto forward_datasource = forward_datasource_vector[edge.fwd_segment_position];
-        BOOST_ASSERT(edge.fwd_segment_position < reverse_datasource_vector.size());
-        const auto reverse_datasource = reverse_datasource_vector[reverse_datasource_vector.size() -
-                                                                  edge.fwd_segment_position - 1];
+        BOOST_ASSERT(edge.fwd_segment_position < forward_datasource_range.size());
+        const auto forward_datasource = forward_datasource_range[edge.fwd_segment_position];
+        BOOST_ASSERT(edge.fwd_segment_position < reverse_datasource_range.size());
+        const auto reverse_datasource = reverse_datasource_range[reverse_datasource_range.size() -
+                                                                 edge.fwd_segment_position - 1];
 
         // Keep track of the highest datasource seen so that we don't write unnecessary
         // data to the layer attribute values
@@ -671,13 +671,13 @@ Status TilePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
             for (const auto &edge_index : sorted_edge_indexes)
             {
                 const auto &edge = edges[edge_index];
-                const auto forward_weight_vector =
-                    facade->GetUncompressedForwardWeights(edge.packed_geometry_id);
-                const auto reverse_weight_vector =
-                    facade->GetUncompressedReverseWeights(edge.packed_geometry_id);
-                const auto forward_weight = forward_weight_vector[edge.fwd_segment_position];
-                const auto reverse_weight = reverse_weight_vector[reverse_weight_vector.size() -
-                                                                  edge.fwd_segment_position - 1];
+                const auto forward_weight_range =
+                    facade->GetUncompressedForwardWeightsRange(edge.packed_geometry_id);
+                const auto reverse_weight_range =
+                    facade->GetUncompressedReverseWeightsRange(edge.packed_geometry_id);
+                const auto forward_weight = forward_weight_range[edge.fwd_segment_position];
+                const auto reverse_weight = reverse_weight_range[reverse_weight_range.size() -
+                                                                 edge.fwd_segment_position - 1];
                 use_line_value(reverse_weight);
                 use_line_value(forward_weight);
             }
@@ -696,23 +696,23 @@ Status TilePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
                     const double length =
                         osrm::util::coordinate_calculation::haversineDistance(a, b);
 
-                    const auto forward_weight_vector =
-                        facade->GetUncompressedForwardWeights(edge.packed_geometry_id);
-                    const auto reverse_weight_vector =
-                        facade->GetUncompressedReverseWeights(edge.packed_geometry_id);
-                    const auto forward_datasource_vector =
-                        facade->GetUncompressedForwardDatasources(edge.packed_geometry_id);
-                    const auto reverse_datasource_vector =
-                        facade->GetUncompressedReverseDatasources(edge.packed_geometry_id);
-                    const auto forward_weight = forward_weight_vector[edge.fwd_segment_position];
+                    const auto forward_weight_range =
+                        facade->GetUncompressedForwardWeightsRange(edge.packed_geometry_id);
+                    const auto reverse_weight_range =
+                        facade->GetUncompressedReverseWeightsRange(edge.packed_geometry_id);
+                    const auto forward_datasource_range =
+                        facade->GetUncompressedForwardDatasourcesRange(edge.packed_geometry_id);
+                    const auto reverse_datasource_range =
+                        facade->GetUncompressedReverseDatasourcesRange(edge.packed_geometry_id);
+                    const auto forward_weight = forward_weight_range[edge.fwd_segment_position];
                     const auto reverse_weight =
-                        reverse_weight_vector[reverse_weight_vector.size() -
-                                              edge.fwd_segment_position - 1];
+                        reverse_weight_range[reverse_weight_range.size() -
+                                             edge.fwd_segment_position - 1];
                     const auto forward_datasource =
-                        forward_datasource_vector[edge.fwd_segment_position];
+                        forward_datasource_range[edge.fwd_segment_position];
                     const auto reverse_datasource =
-                        reverse_datasource_vector[reverse_datasource_vector.size() -
-                                                  edge.fwd_segment_position - 1];
+                        reverse_datasource_range[reverse_datasource_range.size() -
+                                                 edge.fwd_segment_position - 1];
 
                     std::string name = facade->GetNameForID(edge.name_id);
                     const auto name_offset = [&name, &names, &name_offsets]() {
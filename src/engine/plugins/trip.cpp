@@ -10,6 +10,7 @@
 #include "util/dist_table_wrapper.hpp" // to access the dist table more easily
 #include "util/json_container.hpp"
 #include "util/matrix_graph_wrapper.hpp" // wrapper to use tarjan scc on dist table
+#include "util/metrics.hpp"
 
 #include <boost/assert.hpp>
 
@@ -114,7 +115,7 @@ SCC_Component SplitUnaccessibleLocations(const std::size_t number_of_locations,
     return SCC_Component(std::move(components), std::move(range));
 }
 
-InternalRouteResult TripPlugin::ComputeRoute(const datafacade::BaseDataFacade &facade,
+InternalRouteResult TripPlugin::ComputeRoute(const RoutingDataFacade &facade,
                                              const std::vector<PhantomNode> &snapped_phantoms,
                                              const std::vector<NodeID> &trip) const
 {
@@ -172,10 +173,11 @@ Status TripPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
     auto snapped_phantoms = SnapPhantomNodes(phantom_node_pairs);
 
     const auto number_of_locations = snapped_phantoms.size();
+    const auto &routing_facade = GetRoutingFacade(*facade);
 
     // compute the duration table of all phantom nodes
     const auto result_table = util::DistTableWrapper<EdgeWeight>(
-        duration_table(*facade, snapped_phantoms, {}, {}), number_of_locations);
+        duration_table(routing_facade, snapped_phantoms, {}, {}), number_of_locations);
 
     if (result_table.size() == 0)
     {
@@ -233,9 +235,10 @@ Status TripPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
     routes.reserve(trips.size());
     for (const auto &trip : trips)
     {
-        routes.push_back(ComputeRoute(*facade, snapped_phantoms, trip));
+        routes.push_back(ComputeRoute(routing_facade, snapped_phantoms, trip));
     }
 
+    util::metrics::ScopedStage guidance_stage(util::metrics::Stage::Guidance);
     api::TripAPI trip_api{*facade, parameters};
     trip_api.MakeResponse(trips, routes, snapped_phantoms, json_result);
 
@@ -6,6 +6,7 @@
 #include "util/for_each_pair.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/metrics.hpp"
 
 #include <cstdlib>
 
@@ -21,15 +22,40 @@ namespace engine
 namespace plugins
 {
 
-ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute)
+ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute, const std::size_t result_cache_size)
     : shortest_path(heaps), alternative_path(heaps), direct_shortest_path(heaps),
       max_locations_viaroute(max_locations_viaroute)
 {
+    if (result_cache_size > 0)
+    {
+        route_cache = std::make_unique<ResultCache<InternalRouteResult>>(result_cache_size);
+    }
 }
 
 Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                                      const api::RouteParameters &route_parameters,
                                      util::json::Object &json_result) const
+{
+    return HandleRequestImpl(facade, route_parameters, json_result);
+}
+
+Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                     const api::RouteParameters &route_parameters,
+                                     std::string &pbf_result) const
+{
+    if (route_parameters.steps || route_parameters.annotations)
+    {
+        return Error("InvalidOptions",
+                     "Steps and annotations are not supported by the pbf format",
+                     pbf_result);
+    }
+    return HandleRequestImpl(facade, route_parameters, pbf_result);
+}
+
+template <typename ResultT>
+Status ViaRoutePlugin::HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                         const api::RouteParameters &route_parameters,
+                                         ResultT &result) const
 {
     BOOST_ASSERT(route_parameters.IsValid());
 
@@ -40,12 +66,12 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
                      "Number of entries " + std::to_string(route_parameters.coordinates.size()) +
                          " is higher than current maximum (" +
                          std::to_string(max_locations_viaroute) + ")",
-                     json_result);
+                     result);
     }
 
     if (!CheckAllCoordinates(route_parameters.coordinates))
     {
-        return Error("InvalidValue", "Invalid coordinate value.", json_result);
+        return Error("InvalidValue", "Invalid coordinate value.", result);
     }
 
     auto phantom_node_pairs = GetPhantomNodes(*facade, route_parameters);
@@ -54,7 +80,7 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
         return Error("NoSegment",
                      std::string("Could not find a matching segment for coordinate ") +
                          std::to_string(phantom_node_pairs.size()),
-                     json_result);
+                     result);
     }
     BOOST_ASSERT(phantom_node_pairs.size() == route_parameters.coordinates.size());
 
@@ -84,31 +110,61 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
     };
     util::for_each_pair(snapped_phantoms, build_phantom_pairs);
 
-    if (1 == raw_route.segment_end_coordinates.size())
-    {
-        if (route_parameters.alternatives && facade->GetCoreSize() == 0)
+    const auto compute_route = [&](InternalRouteResult &route) {
+        util::metrics::ScopedStage search_stage(util::metrics::Stage::Search);
+        const auto &routing_facade = GetRoutingFacade(*facade);
+        if (1 == route.segment_end_coordinates.size())
         {
-            alternative_path(*facade, raw_route.segment_end_coordinates.front(), raw_route);
+            if (route_parameters.alternatives && facade->GetCoreSize() == 0)
+            {
+                alternative_path(routing_facade, route.segment_end_coordinates.front(), route);
+            }
+            else
+            {
+                direct_shortest_path(routing_facade, route.segment_end_coordinates, route);
+            }
         }
         else
         {
-            direct_shortest_path(*facade, raw_route.segment_end_coordinates, raw_route);
+            shortest_path(routing_facade,
+                          route.segment_end_coordinates,
+                          route_parameters.continue_straight,
+                          route);
+        }
+    };
+
+    // Identical searches are answered from the cache, the response is still built per request.
+    // The phantom nodes already reflect continue_straight at the waypoints.
+    std::shared_ptr<const InternalRouteResult> cached_route;
+    if (route_cache)
+    {
+        ResultCacheKey key;
+        key.Add(route_parameters.alternatives)
+            .Add(static_cast<std::uint8_t>(
+                route_parameters.continue_straight ? 1 + *route_parameters.continue_straight : 0));
+        for (const auto &phantom_nodes : raw_route.segment_end_coordinates)
+        {
+            key.Add(phantom_nodes.source_phantom).Add(phantom_nodes.target_phantom);
         }
+        cached_route = route_cache->GetOrCompute(facade->GetDataVersion(), key.key, [&] {
+            auto route = raw_route;
+            compute_route(route);
+            return route;
+        });
     }
     else
     {
-        shortest_path(*facade,
-                      raw_route.segment_end_coordinates,
-                      route_parameters.continue_straight,
-                      raw_route);
+        compute_route(raw_route);
     }
+    const auto &route = cached_route ? *cached_route : raw_route;
 
     // we can only know this after the fact, different SCC ids still
     // allow for connection in one direction.
-    if (raw_route.is_valid())
+    if (route.is_valid())
     {
+        util::metrics::ScopedStage guidance_stage(util::metrics::Stage::Guidance);
         api::RouteAPI route_api{*facade, route_parameters};
-        route_api.MakeResponse(raw_route, json_result);
+        route_api.MakeResponse(route, result);
     }
     else
     {
@@ -121,11 +177,11 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
 
         if (not_in_same_component)
         {
-            return Error("NoRoute", "Impossible route between points", json_result);
+            return Error("NoRoute", "Impossible route between points", result);
         }
         else
         {
-            return Error("NoRoute", "No route found between points", json_result);
+            return Error("NoRoute", "No route found between points", result);
         }
     }
 
@@ -13,10 +13,11 @@ SearchEngineData::SearchEngineHeapPtr SearchEngineData::forward_heap_2;
 SearchEngineData::SearchEngineHeapPtr SearchEngineData::reverse_heap_2;
 SearchEngineData::SearchEngineHeapPtr SearchEngineData::forward_heap_3;
 SearchEngineData::SearchEngineHeapPtr SearchEngineData::reverse_heap_3;
+SearchEngineData::SweepWeightsPtr SearchEngineData::sweep_weights;
 
 void SearchEngineData::InitializeOrClearFirstThreadLocalStorage(const unsigned number_of_nodes)
 {
-    if (forward_heap_1.get())
+    if (forward_heap_1.get() && forward_heap_1->MaxID() >= number_of_nodes)
     {
         forward_heap_1->Clear();
     }
@@ -25,7 +26,7 @@ void SearchEngineData::InitializeOrClearFirstThreadLocalStorage(const unsigned n
         forward_heap_1.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_1.get())
+    if (reverse_heap_1.get() && reverse_heap_1->MaxID() >= number_of_nodes)
     {
         reverse_heap_1->Clear();
     }
@@ -37,7 +38,7 @@ void SearchEngineData::InitializeOrClearFirstThreadLocalStorage(const unsigned n
 
 void SearchEngineData::InitializeOrClearSecondThreadLocalStorage(const unsigned number_of_nodes)
 {
-    if (forward_heap_2.get())
+    if (forward_heap_2.get() && forward_heap_2->MaxID() >= number_of_nodes)
     {
         forward_heap_2->Clear();
     }
@@ -46,7 +47,7 @@ void SearchEngineData::InitializeOrClearSecondThreadLocalStorage(const unsigned
         forward_heap_2.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_2.get())
+    if (reverse_heap_2.get() && reverse_heap_2->MaxID() >= number_of_nodes)
     {
         reverse_heap_2->Clear();
     }
@@ -58,7 +59,7 @@ void SearchEngineData::InitializeOrClearSecondThreadLocalStorage(const unsigned
 
 void SearchEngineData::InitializeOrClearThirdThreadLocalStorage(const unsigned number_of_nodes)
 {
-    if (forward_heap_3.get())
+    if (forward_heap_3.get() && forward_heap_3->MaxID() >= number_of_nodes)
     {
         forward_heap_3->Clear();
     }
@@ -67,7 +68,7 @@ void SearchEngineData::InitializeOrClearThirdThreadLocalStorage(const unsigned n
         forward_heap_3.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_3.get())
+    if (reverse_heap_3.get() && reverse_heap_3->MaxID() >= number_of_nodes)
     {
         reverse_heap_3->Clear();
     }
@@ -76,5 +77,17 @@ void SearchEngineData::InitializeOrClearThirdThreadLocalStorage(const unsigned n
         reverse_heap_3.reset(new QueryHeap(number_of_nodes));
     }
 }
+
+void SearchEngineData::InitializeOrClearSweepThreadLocalStorage(const unsigned number_of_nodes)
+{
+    if (sweep_weights.get())
+    {
+        sweep_weights->assign(number_of_nodes, INVALID_EDGE_WEIGHT);
+    }
+    else
+    {
+        sweep_weights.reset(new SweepWeights(number_of_nodes, INVALID_EDGE_WEIGHT));
+    }
+}
 }
 }
@@ -18,19 +18,72 @@
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+
 #include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace osrm
 {
 namespace extractor
 {
+namespace
+{
+// Number of intersections that are expanded as a single work item
+const constexpr NodeID INTERSECTION_GRAIN_SIZE = 100;
+
+// Assigns ids in the order keys are seen first, the way the serial expansion assigns them
+template <typename Key, typename ID, typename Hash = std::hash<Key>> struct FirstOccurrenceIDs
+{
+    ID Add(const Key &key)
+    {
+        const auto result = ids.emplace(key, boost::numeric_cast<ID>(keys.size()));
+        if (result.second)
+            keys.push_back(key);
+        return result.first->second;
+    }
+
+    std::unordered_map<Key, ID, Hash> ids;
+    std::vector<Key> keys;
+};
+
+// Output of expanding a range of intersections, all ids are local to the range
+struct IntersectionBuffer
+{
+    NodeID last_node = 0;
+    std::size_t node_based_edge_counter = 0;
+
+    std::vector<EdgeBasedEdge> edges;
+    std::vector<OriginalEdgeData> original_edge_data;
+    std::vector<char> edge_segment_lookup;
+    std::vector<lookup::PenaltyBlock> edge_penalties;
+
+    FirstOccurrenceIDs<util::guidance::EntryClass, EntryClassID> entry_classes;
+    FirstOccurrenceIDs<util::guidance::BearingClass, BearingClassID> bearing_classes;
+    std::vector<std::pair<NodeID, BearingClassID>> bearing_class_by_node;
+
+    util::guidance::LaneDataIdMap lane_data_map;
+    guidance::LaneDescriptionMap new_lane_descriptions;
+};
+
+template <typename Block> void appendBytes(std::vector<char> &bytes, const Block &block)
+{
+    const auto first = reinterpret_cast<const char *>(&block);
+    bytes.insert(bytes.end(), first, first + sizeof(block));
+}
+} // namespace
+
 // Configuration to find representative candidate for turn angle calculations
 
 EdgeBasedGraphFactory::EdgeBasedGraphFactory(
@@ -337,9 +390,6 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     edge_data_file.write(reinterpret_cast<const char *>(&length_prefix_empty_space),
                          sizeof(length_prefix_empty_space));
 
-    std::vector<OriginalEdgeData> original_edge_data_vector;
-    original_edge_data_vector.reserve(1024 * 1024);
-
     // Loop over all turns and generate new set of edges.
     // Three nested loop look super-linear, but we are dealing with a (kind of)
     // linear number of turns only.
@@ -353,28 +403,34 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                          street_name_suffix_table,
                                          profile_properties);
 
-    util::guidance::LaneDataIdMap lane_data_map;
     guidance::lanes::TurnLaneHandler turn_lane_handler(*m_node_based_graph,
                                                        turn_lane_offsets,
                                                        turn_lane_masks,
                                                        lane_description_map,
-                                                       turn_analysis,
-                                                       lane_data_map);
+                                                       turn_analysis);
+
+    util::guidance::LaneDataIdMap lane_data_map;
+    // combined lane descriptions of sliproads, added to the lane description map at the end
+    FirstOccurrenceIDs<guidance::TurnLaneDescription,
+                       LaneDescriptionID,
+                       guidance::TurnLaneDescription_hash>
+        new_lane_descriptions;
+    const auto first_new_lane_description_id = lane_description_map.size();
 
     bearing_class_by_node_based_node.resize(m_node_based_graph->GetNumberOfNodes(),
                                             std::numeric_limits<std::uint32_t>::max());
 
-    {
-        util::UnbufferedLog log;
+    // Expands the intersections of a range of nodes. Everything that needs a global id or a
+    // position in one of the output files is buffered with ids that are local to the range.
+    const auto expand_intersections = [&](const tbb::blocked_range<NodeID> &intersection_range) {
+        auto buffer = std::make_shared<IntersectionBuffer>();
+        buffer->last_node = intersection_range.end();
 
-        util::Percent progress(log, m_node_based_graph->GetNumberOfNodes());
         // going over all nodes (which form the center of an intersection), we compute all
         // possible turns along these intersections.
         for (const auto node_at_center_of_intersection :
-             util::irange(0u, m_node_based_graph->GetNumberOfNodes()))
+             util::irange(intersection_range.begin(), intersection_range.end()))
         {
-            progress.PrintStatus(node_at_center_of_intersection);
-
             const auto shape_result =
                 turn_analysis.ComputeIntersectionShapes(node_at_center_of_intersection);
 
@@ -409,7 +465,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 if (m_node_based_graph->GetEdgeData(incoming_edge).reversed)
                     continue;
 
-                ++node_based_edge_counter;
+                ++buffer->node_based_edge_counter;
 
                 auto intersection_with_flags_and_angles =
                     turn_analysis.GetIntersectionGenerator().TransformIntersectionShapeIntoView(
@@ -424,40 +480,22 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
                 BOOST_ASSERT(intersection.valid());
 
-                intersection = turn_lane_handler.assignTurnLanes(
-                    node_along_road_entering, incoming_edge, std::move(intersection));
+                intersection = turn_lane_handler.assignTurnLanes(node_along_road_entering,
+                                                                 incoming_edge,
+                                                                 std::move(intersection),
+                                                                 buffer->lane_data_map,
+                                                                 buffer->new_lane_descriptions);
 
                 // the entry class depends on the turn, so we have to classify the interesction for
                 // every edge
                 const auto turn_classification = classifyIntersection(intersection);
 
-                const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
-                    if (0 == entry_class_hash.count(entry_class))
-                    {
-                        const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
-                        entry_class_hash[entry_class] = id;
-                        return id;
-                    }
-                    else
-                    {
-                        return entry_class_hash.find(entry_class)->second;
-                    }
-                }(turn_classification.first);
+                const auto entry_class_id = buffer->entry_classes.Add(turn_classification.first);
 
                 const auto bearing_class_id =
-                    [&](const util::guidance::BearingClass bearing_class) {
-                        if (0 == bearing_class_hash.count(bearing_class))
-                        {
-                            const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
-                            bearing_class_hash[bearing_class] = id;
-                            return id;
-                        }
-                        else
-                        {
-                            return bearing_class_hash.find(bearing_class)->second;
-                        }
-                    }(turn_classification.second);
-                bearing_class_by_node_based_node[node_at_center_of_intersection] = bearing_class_id;
+                    buffer->bearing_classes.Add(turn_classification.second);
+                buffer->bearing_class_by_node.emplace_back(node_at_center_of_intersection,
+                                                           bearing_class_id);
 
                 for (const auto &turn : intersection)
                 {
@@ -503,7 +541,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                     BOOST_ASSERT(is_encoded_forwards || is_encoded_backwards);
                     if (is_encoded_forwards)
                     {
-                        original_edge_data_vector.emplace_back(
+                        buffer->original_edge_data.emplace_back(
                             GeometryID{m_compressed_edge_container.GetZippedPositionForForwardID(
                                            incoming_edge),
                                        true},
@@ -517,7 +555,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                     }
                     else if (is_encoded_backwards)
                     {
-                        original_edge_data_vector.emplace_back(
+                        buffer->original_edge_data.emplace_back(
                             GeometryID{m_compressed_edge_container.GetZippedPositionForReverseID(
                                            incoming_edge),
                                        false},
@@ -530,26 +568,17 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                             util::guidance::TurnBearing(turn.bearing));
                     }
 
-                    ++original_edges_counter;
-
-                    if (original_edge_data_vector.size() > 1024 * 1024 * 10)
-                    {
-                        FlushVectorToStream(edge_data_file, original_edge_data_vector);
-                    }
-
                     BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
                     BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
 
-                    // NOTE: potential overflow here if we hit 2^32 routable edges
-                    BOOST_ASSERT(m_edge_based_edge_list.size() <=
-                                 std::numeric_limits<NodeID>::max());
-                    m_edge_based_edge_list.emplace_back(edge_data1.edge_id,
-                                                        edge_data2.edge_id,
-                                                        m_edge_based_edge_list.size(),
-                                                        distance,
-                                                        true,
-                                                        false);
-                    BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
+                    // the id is relative to the range until the buffer is merged
+                    buffer->edges.emplace_back(edge_data1.edge_id,
+                                               edge_data2.edge_id,
+                                               buffer->edges.size(),
+                                               distance,
+                                               true,
+                                               false);
+                    BOOST_ASSERT(buffer->original_edge_data.size() == buffer->edges.size());
 
                     // Here is where we write out the mapping between the edge-expanded edges, and
                     // the node-based edges that are originally used to calculate the `distance`
@@ -575,8 +604,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
                         lookup::SegmentHeaderBlock header = {node_count, first_node.node_id};
 
-                        edge_segment_file.write(reinterpret_cast<const char *>(&header),
-                                                sizeof(header));
+                        appendBytes(buffer->edge_segment_lookup, header);
 
                         for (auto target_node : node_based_edges)
                         {
@@ -588,8 +616,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                             lookup::SegmentBlock nodeblock = {
                                 to.node_id, segment_length, target_node.weight};
 
-                            edge_segment_file.write(reinterpret_cast<const char *>(&nodeblock),
-                                                    sizeof(nodeblock));
+                            appendBytes(buffer->edge_segment_lookup, nodeblock);
                             previous = target_node.node_id;
                         }
 
@@ -619,14 +646,141 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                 turn.eid)];
 
                         const unsigned fixed_penalty = distance - edge_data1.distance;
-                        lookup::PenaltyBlock penaltyblock = {
-                            fixed_penalty, from_node.node_id, via_node.node_id, to_node.node_id};
-                        edge_penalty_file.write(reinterpret_cast<const char *>(&penaltyblock),
-                                                sizeof(penaltyblock));
+                        buffer->edge_penalties.push_back(
+                            {fixed_penalty, from_node.node_id, via_node.node_id, to_node.node_id});
                     }
                 }
             }
         }
+
+        return buffer;
+    };
+
+    {
+        util::UnbufferedLog log;
+        util::Percent progress(log, m_node_based_graph->GetNumberOfNodes());
+
+        // Buffers are merged in the order of their node ranges. Local ids are replaced with the
+        // ids a serial run assigns, i.e. ids in the order of first occurrence.
+        const auto merge_buffer = [&](const std::shared_ptr<IntersectionBuffer> &buffer) {
+            progress.PrintStatus(buffer->last_node);
+            node_based_edge_counter += buffer->node_based_edge_counter;
+
+            std::vector<EntryClassID> entry_class_ids;
+            entry_class_ids.reserve(buffer->entry_classes.keys.size());
+            for (const auto &entry_class : buffer->entry_classes.keys)
+            {
+                const auto id = static_cast<EntryClassID>(entry_class_hash.size());
+                entry_class_ids.push_back(entry_class_hash.emplace(entry_class, id).first->second);
+            }
+
+            std::vector<BearingClassID> bearing_class_ids;
+            bearing_class_ids.reserve(buffer->bearing_classes.keys.size());
+            for (const auto &bearing_class : buffer->bearing_classes.keys)
+            {
+                const auto id = static_cast<BearingClassID>(bearing_class_hash.size());
+                bearing_class_ids.push_back(
+                    bearing_class_hash.emplace(bearing_class, id).first->second);
+            }
+            for (const auto &node_and_class : buffer->bearing_class_by_node)
+            {
+                bearing_class_by_node_based_node[node_and_class.first] =
+                    bearing_class_ids[node_and_class.second];
+            }
+
+            std::vector<const guidance::TurnLaneDescription *> descriptions(
+                buffer->new_lane_descriptions.size());
+            for (const auto &description_and_id : buffer->new_lane_descriptions)
+            {
+                descriptions[description_and_id.second - first_new_lane_description_id] =
+                    &description_and_id.first;
+            }
+            std::vector<LaneDescriptionID> lane_description_ids;
+            lane_description_ids.reserve(descriptions.size());
+            for (const auto description : descriptions)
+            {
+                lane_description_ids.push_back(boost::numeric_cast<LaneDescriptionID>(
+                    first_new_lane_description_id + new_lane_descriptions.Add(*description)));
+            }
+
+            std::vector<util::guidance::LaneTupleIdPair> lane_data(buffer->lane_data_map.size());
+            for (const auto &lane_data_and_id : buffer->lane_data_map)
+            {
+                lane_data[lane_data_and_id.second] = lane_data_and_id.first;
+            }
+            std::vector<LaneDataID> lane_data_ids;
+            lane_data_ids.reserve(lane_data.size());
+            for (auto key : lane_data)
+            {
+                if (key.second != INVALID_LANE_DESCRIPTIONID &&
+                    key.second >= first_new_lane_description_id)
+                {
+                    key.second = lane_description_ids[key.second - first_new_lane_description_id];
+                }
+                const auto id = boost::numeric_cast<LaneDataID>(lane_data_map.size());
+                lane_data_ids.push_back(lane_data_map.emplace(key, id).first->second);
+            }
+
+            for (auto &data : buffer->original_edge_data)
+            {
+                data.entry_classid = entry_class_ids[data.entry_classid];
+                if (data.lane_data_id != INVALID_LANE_DATAID)
+                    data.lane_data_id = lane_data_ids[data.lane_data_id];
+            }
+            original_edges_counter += buffer->original_edge_data.size();
+            FlushVectorToStream(edge_data_file, buffer->original_edge_data);
+
+            // NOTE: potential overflow here if we hit 2^32 routable edges
+            BOOST_ASSERT(m_edge_based_edge_list.size() + buffer->edges.size() <=
+                         std::numeric_limits<NodeID>::max());
+            const NodeID first_edge_id = m_edge_based_edge_list.size();
+            for (auto &edge : buffer->edges)
+            {
+                edge.edge_id += first_edge_id;
+                m_edge_based_edge_list.push_back(edge);
+            }
+            BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
+
+            if (generate_edge_lookup)
+            {
+                edge_segment_file.write(buffer->edge_segment_lookup.data(),
+                                        buffer->edge_segment_lookup.size());
+                edge_penalty_file.write(
+                    reinterpret_cast<const char *>(buffer->edge_penalties.data()),
+                    buffer->edge_penalties.size() * sizeof(lookup::PenaltyBlock));
+            }
+        };
+
+        NodeID current_node = 0;
+        const NodeID number_of_nodes = m_node_based_graph->GetNumberOfNodes();
+
+        // serial_in_order stages keep the ranges and the merges in node order
+        tbb::parallel_pipeline(
+            tbb::task_scheduler_init::default_num_threads() * 4,
+            tbb::make_filter<void, tbb::blocked_range<NodeID>>(
+                tbb::filter::serial_in_order,
+                [&](tbb::flow_control &control) {
+                    if (current_node >= number_of_nodes)
+                    {
+                        control.stop();
+                        return tbb::blocked_range<NodeID>(number_of_nodes, number_of_nodes);
+                    }
+                    const auto first = current_node;
+                    current_node =
+                        std::min(number_of_nodes, current_node + INTERSECTION_GRAIN_SIZE);
+                    return tbb::blocked_range<NodeID>(first, current_node);
+                }) &
+                tbb::make_filter<tbb::blocked_range<NodeID>, std::shared_ptr<IntersectionBuffer>>(
+                    tbb::filter::parallel, expand_intersections) &
+                tbb::make_filter<std::shared_ptr<IntersectionBuffer>, void>(
+                    tbb::filter::serial_in_order, merge_buffer));
+    }
+
+    // Inserted in order of their ids, which is the order a serial run inserts them in
+    for (const auto &description : new_lane_descriptions.keys)
+    {
+        const auto id = boost::numeric_cast<LaneDescriptionID>(lane_description_map.size());
+        lane_description_map.emplace(description, id);
     }
 
     util::Log() << "Created " << entry_class_hash.size() << " entry classes and "
@@ -648,8 +802,6 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
     util::Log() << "done.";
 
-    FlushVectorToStream(edge_data_file, original_edge_data_vector);
-
     // Finally jump back to the empty space at the beginning and write length prefix
     edge_data_file.seekp(std::ios::beg);
 
@@ -34,14 +34,13 @@ std::size_t getNumberOfTurns(const Intersection &intersection)
 } // namespace
 
 TurnLaneHandler::TurnLaneHandler(const util::NodeBasedDynamicGraph &node_based_graph,
-                                 std::vector<std::uint32_t> &turn_lane_offsets,
-                                 std::vector<TurnLaneType::Mask> &turn_lane_masks,
-                                 LaneDescriptionMap &lane_description_map,
-                                 const TurnAnalysis &turn_analysis,
-                                 util::guidance::LaneDataIdMap &id_map)
+                                 const std::vector<std::uint32_t> &turn_lane_offsets,
+                                 const std::vector<TurnLaneType::Mask> &turn_lane_masks,
+                                 const LaneDescriptionMap &lane_description_map,
+                                 const TurnAnalysis &turn_analysis)
     : node_based_graph(node_based_graph), turn_lane_offsets(turn_lane_offsets),
       turn_lane_masks(turn_lane_masks), lane_description_map(lane_description_map),
-      turn_analysis(turn_analysis), id_map(id_map)
+      turn_analysis(turn_analysis)
 {
     count_handled = count_called = 0;
 }
@@ -70,8 +69,11 @@ TurnLaneHandler::~TurnLaneHandler()
     assignment onto the turns.
     For example: (130, turn slight right), (180, ramp straight), (320, turn sharp left).
  */
-Intersection
-TurnLaneHandler::assignTurnLanes(const NodeID at, const EdgeID via_edge, Intersection intersection)
+Intersection TurnLaneHandler::assignTurnLanes(const NodeID at,
+                                              const EdgeID via_edge,
+                                              Intersection intersection,
+                                              util::guidance::LaneDataIdMap &id_map,
+                                              LaneDescriptionMap &new_lane_descriptions) const
 {
     // if only a uturn exists, there is nothing we can do
     if (intersection.size() == 1)
@@ -108,7 +110,8 @@ TurnLaneHandler::assignTurnLanes(const NodeID at, const EdgeID via_edge, Interse
     case TurnLaneScenario::SIMPLE:
     case TurnLaneScenario::PARTITION_LOCAL:
         lane_data = handleNoneValueAtSimpleTurn(std::move(lane_data), intersection);
-        return simpleMatchTuplesToTurns(std::move(intersection), lane_data, lane_description_id);
+        return simpleMatchTuplesToTurns(
+            std::move(intersection), lane_data, lane_description_id, id_map);
 
     // Cases operating on data carried over from a previous lane
     case TurnLaneScenario::SIMPLE_PREVIOUS:
@@ -116,14 +119,16 @@ TurnLaneHandler::assignTurnLanes(const NodeID at, const EdgeID via_edge, Interse
         previous_lane_data =
             handleNoneValueAtSimpleTurn(std::move(previous_lane_data), intersection);
         return simpleMatchTuplesToTurns(
-            std::move(intersection), previous_lane_data, previous_description_id);
+            std::move(intersection), previous_lane_data, previous_description_id, id_map);
 
     // Sliproads-turns that are to be handled as a single entity
     case TurnLaneScenario::SLIPROAD:
         return handleSliproadTurn(std::move(intersection),
                                   lane_description_id,
                                   std::move(lane_data),
-                                  previous_intersection);
+                                  previous_intersection,
+                                  id_map,
+                                  new_lane_descriptions);
     case TurnLaneScenario::MERGE:
         return intersection;
     default:
@@ -147,7 +152,7 @@ TurnLaneScenario TurnLaneHandler::deduceScenario(const NodeID at,
                                                  EdgeID &previous_via_edge,
                                                  Intersection &previous_intersection,
                                                  LaneDataVector &previous_lane_data,
-                                                 LaneDescriptionID &previous_description_id)
+                                                 LaneDescriptionID &previous_description_id) const
 {
     // as long as we don't want to emit lanes on roundabout, don't assign them
     if (node_based_graph.GetEdgeData(via_edge).roundabout)
@@ -668,9 +673,11 @@ std::pair<LaneDataVector, LaneDataVector> TurnLaneHandler::partitionLaneData(
     return {std::move(first), std::move(second)};
 }
 
-Intersection TurnLaneHandler::simpleMatchTuplesToTurns(Intersection intersection,
-                                                       const LaneDataVector &lane_data,
-                                                       const LaneDescriptionID lane_description_id)
+Intersection
+TurnLaneHandler::simpleMatchTuplesToTurns(Intersection intersection,
+                                          const LaneDataVector &lane_data,
+                                          const LaneDescriptionID lane_description_id,
+                                          util::guidance::LaneDataIdMap &id_map) const
 {
     if (lane_data.empty() || !canMatchTrivially(intersection, lane_data))
         return intersection;
@@ -688,7 +695,9 @@ Intersection TurnLaneHandler::simpleMatchTuplesToTurns(Intersection intersection
 Intersection TurnLaneHandler::handleSliproadTurn(Intersection intersection,
                                                  const LaneDescriptionID lane_description_id,
                                                  LaneDataVector lane_data,
-                                                 const Intersection &previous_intersection)
+                                                 const Intersection &previous_intersection,
+                                                 util::guidance::LaneDataIdMap &id_map,
+                                                 LaneDescriptionMap &new_lane_descriptions) const
 {
     const std::size_t sliproad_index =
         std::distance(previous_intersection.begin(),
@@ -783,18 +792,24 @@ Intersection TurnLaneHandler::handleSliproadTurn(Intersection intersection,
 
     const auto combined_id = [&]() {
         auto itr = lane_description_map.find(combined_description);
-        if (lane_description_map.find(combined_description) == lane_description_map.end())
+        if (itr != lane_description_map.end())
+            return itr->second;
+
+        // new descriptions are numbered after the existing ones
+        auto new_itr = new_lane_descriptions.find(combined_description);
+        if (new_itr == new_lane_descriptions.end())
         {
-            const auto new_id = boost::numeric_cast<LaneDescriptionID>(lane_description_map.size());
-            lane_description_map[combined_description] = new_id;
+            const auto new_id = boost::numeric_cast<LaneDescriptionID>(
+                lane_description_map.size() + new_lane_descriptions.size());
+            new_lane_descriptions[combined_description] = new_id;
             return new_id;
         }
         else
         {
-            return itr->second;
+            return new_itr->second;
         }
     }();
-    return simpleMatchTuplesToTurns(std::move(intersection), lane_data, combined_id);
+    return simpleMatchTuplesToTurns(std::move(intersection), lane_data, combined_id, id_map);
 }
 
 } // namespace lanes
@@ -330,11 +330,12 @@ const ProfileProperties &Sol2ScriptingEnvironment::GetProfileProperties()
 
 LuaScriptingContext &Sol2ScriptingEnvironment::GetSol2Context()
 {
-    std::lock_guard<std::mutex> lock(init_mutex);
+    // local() is thread-safe, only the setup of a new context needs the lock
     bool initialized = false;
     auto &ref = script_contexts.local(initialized);
     if (!initialized)
     {
+        std::lock_guard<std::mutex> lock(init_mutex);
         ref = std::make_unique<LuaScriptingContext>();
         InitContext(*ref);
     }
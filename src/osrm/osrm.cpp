@@ -1,4 +1,7 @@
 #include "osrm/osrm.hpp"
+#include "engine/api/batch_nearest_parameters.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -28,11 +31,26 @@ engine::Status OSRM::Route(const engine::api::RouteParameters &params,
     return engine_->Route(params, result);
 }
 
+engine::Status OSRM::Route(const engine::api::RouteParameters &params, std::string &result) const
+{
+    return engine_->Route(params, result);
+}
+
 engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Object &result) const
 {
     return engine_->Table(params, result);
 }
 
+engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Writer &result) const
+{
+    return engine_->Table(params, result);
+}
+
+engine::Status OSRM::Table(const engine::api::TableParameters &params, std::string &result) const
+{
+    return engine_->Table(params, result);
+}
+
 engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
                              json::Object &result) const
 {
@@ -49,9 +67,49 @@ engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Obj
     return engine_->Match(params, result);
 }
 
+engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Writer &result) const
+{
+    return engine_->Match(params, result);
+}
+
+engine::Status OSRM::Match(const engine::api::MatchParameters &params, std::string &result) const
+{
+    return engine_->Match(params, result);
+}
+
 engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string &result) const
 {
     return engine_->Tile(params, result);
 }
 
+engine::Status OSRM::Isochrone(const engine::api::IsochroneParameters &params,
+                               json::Object &result) const
+{
+    return engine_->Isochrone(params, result);
+}
+
+engine::Status OSRM::BatchRoute(const engine::api::BatchRouteParameters &params,
+                                json::Object &result) const
+{
+    return engine_->BatchRoute(params, result);
+}
+
+engine::Status OSRM::BatchRoute(const engine::api::BatchRouteParameters &params,
+                                json::Writer &result) const
+{
+    return engine_->BatchRoute(params, result);
+}
+
+engine::Status OSRM::BatchNearest(const engine::api::BatchNearestParameters &params,
+                                  json::Object &result) const
+{
+    return engine_->BatchNearest(params, result);
+}
+
+engine::Status OSRM::BatchNearest(const engine::api::BatchNearestParameters &params,
+                                  json::Writer &result) const
+{
+    return engine_->BatchNearest(params, result);
+}
+
 } // ns osrm
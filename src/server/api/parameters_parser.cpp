@@ -1,5 +1,8 @@
 #include "server/api/parameters_parser.hpp"
 
+#include "server/api/batch_nearest_parameters_grammar.hpp"
+#include "server/api/batch_route_parameters_grammar.hpp"
+#include "server/api/isochrone_parameter_grammar.hpp"
 #include "server/api/match_parameter_grammar.hpp"
 #include "server/api/nearest_parameter_grammar.hpp"
 #include "server/api/route_parameters_grammar.hpp"
@@ -26,7 +29,10 @@ using is_grammar_t =
                                std::is_same<NearestParametersGrammar<>, T>::value ||
                                std::is_same<TripParametersGrammar<>, T>::value ||
                                std::is_same<MatchParametersGrammar<>, T>::value ||
-                               std::is_same<TileParametersGrammar<>, T>::value>;
+                               std::is_same<TileParametersGrammar<>, T>::value ||
+                               std::is_same<IsochroneParametersGrammar<>, T>::value ||
+                               std::is_same<BatchRouteParametersGrammar<>, T>::value ||
+                               std::is_same<BatchNearestParametersGrammar<>, T>::value>;
 
 template <typename ParameterT,
           typename GrammarT,
@@ -111,6 +117,30 @@ boost::optional<engine::api::TileParameters> parseParameters(std::string::iterat
     return detail::parseParameters<engine::api::TileParameters, TileParametersGrammar<>>(iter, end);
 }
 
+template <>
+boost::optional<engine::api::IsochroneParameters> parseParameters(std::string::iterator &iter,
+                                                                  const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::IsochroneParameters,
+                                   IsochroneParametersGrammar<>>(iter, end);
+}
+
+template <>
+boost::optional<engine::api::BatchRouteParameters>
+parseParameters(std::string::iterator &iter, const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::BatchRouteParameters,
+                                   BatchRouteParametersGrammar<>>(iter, end);
+}
+
+template <>
+boost::optional<engine::api::BatchNearestParameters>
+parseParameters(std::string::iterator &iter, const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::BatchNearestParameters,
+                                   BatchNearestParametersGrammar<>>(iter, end);
+}
+
 } // ns api
 } // ns server
 } // ns osrm
@@ -0,0 +1,78 @@
+#include "server/compression_pool.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+
+#include <boost/assert.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+
+namespace osrm
+{
+namespace server
+{
+
+CompressionPool::CompressionPool(const unsigned num_threads,
+                                 const int level,
+                                 const std::size_t min_size)
+    : work(std::make_unique<boost::asio::io_service::work>(service)), compression_level(level),
+      min_size(min_size)
+{
+    BOOST_ASSERT(level >= Z_BEST_SPEED && level <= Z_BEST_COMPRESSION);
+    for (unsigned i = 0; i < std::max(1u, num_threads); ++i)
+    {
+        threads.emplace_back([this] { service.run(); });
+    }
+}
+
+CompressionPool::~CompressionPool()
+{
+    // let queued compressions finish, their handlers keep the connections alive
+    work.reset();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void CompressionPool::Compress(const std::vector<char> &input,
+                               const http::compression_type compression_type,
+                               const int level,
+                               std::vector<char> &output)
+{
+    BOOST_ASSERT(compression_type != http::no_compression);
+
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+
+    // negative window bits write a raw deflate stream, adding 16 writes a gzip header and trailer
+    const int window_bits = compression_type == http::gzip_rfc1952 ? MAX_WBITS + 16 : -MAX_WBITS;
+    const int memory_level = 8;
+    if (deflateInit2(&stream, level, Z_DEFLATED, window_bits, memory_level, Z_DEFAULT_STRATEGY) !=
+        Z_OK)
+    {
+        throw util::exception("Could not initialize zlib" + SOURCE_REF);
+    }
+
+    // the bound is large enough to compress everything with a single call
+    output.resize(deflateBound(&stream, input.size()));
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const auto result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    if (result != Z_STREAM_END)
+    {
+        throw util::exception("Could not compress the reply" + SOURCE_REF);
+    }
+}
+}
+}
@@ -0,0 +1,84 @@
+#include "server/compute_pool.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace osrm
+{
+namespace server
+{
+
+ComputePool::ComputePool(const unsigned num_threads, const std::size_t max_queue_size)
+    : queues(util::metrics::MAX_SERVICES + 1), num_queued(0), last_queue(0), stopping(false),
+      max_queue_size(max_queue_size)
+{
+    for (unsigned i = 0; i < std::max(1u, num_threads); ++i)
+    {
+        threads.emplace_back([this] { Work(); });
+    }
+}
+
+ComputePool::~ComputePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+bool ComputePool::Submit(const util::metrics::ServiceID service, Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        BOOST_ASSERT(service < util::metrics::MAX_SERVICES ||
+                     service == util::metrics::INVALID_SERVICE);
+        auto &queue = queues[std::min<std::size_t>(service, util::metrics::MAX_SERVICES)];
+        if (queue.size() >= max_queue_size)
+        {
+            return false;
+        }
+        queue.push_back(std::move(task));
+        ++num_queued;
+    }
+    task_available.notify_one();
+    return true;
+}
+
+void ComputePool::Work()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            task_available.wait(lock, [this] { return stopping || num_queued > 0; });
+            // queued tasks are dropped on shutdown
+            if (stopping)
+            {
+                return;
+            }
+
+            // round robin over the services with queued tasks
+            auto queue = last_queue;
+            do
+            {
+                queue = (queue + 1) % queues.size();
+            } while (queues[queue].empty());
+
+            task = std::move(queues[queue].front());
+            queues[queue].pop_front();
+            --num_queued;
+            last_queue = queue;
+        }
+        task();
+    }
+}
+}
+}
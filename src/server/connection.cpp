@@ -1,11 +1,11 @@
 #include "server/connection.hpp"
+#include "server/compression_pool.hpp"
+#include "server/compute_pool.hpp"
 #include "server/request_handler.hpp"
 #include "server/request_parser.hpp"
 
 #include <boost/assert.hpp>
 #include <boost/bind.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
 
 #include <iterator>
 #include <string>
@@ -16,8 +16,36 @@ namespace osrm
 namespace server
 {
 
-Connection::Connection(boost::asio::io_service &io_service, RequestHandler &handler)
-    : strand(io_service), TCP_socket(io_service), request_handler(handler)
+namespace
+{
+// Seconds a client has to send a complete request once it started sending it
+const constexpr long REQUEST_TIMEOUT = 30;
+
+// Requests are queued per service, which is the first segment of the path: /{service}/...
+// Names that are not registered are mapped to INVALID_SERVICE by the caller.
+std::string getServiceName(const std::string &uri)
+{
+    const auto begin = uri.find_first_not_of('/');
+    if (begin == std::string::npos)
+    {
+        return {};
+    }
+    const auto end = uri.find_first_of("/?", begin);
+    return uri.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+}
+}
+
+Connection::Connection(boost::asio::io_service &io_service,
+                       RequestHandler &handler,
+                       ComputePool &compute_pool,
+                       CompressionPool &compression_pool,
+                       const unsigned keepalive_timeout,
+                       const unsigned keepalive_max_requests)
+    : strand(io_service), TCP_socket(io_service), timer(io_service), request_handler(handler),
+      compute_pool(compute_pool), compression_pool(compression_pool), pending_begin(nullptr),
+      pending_end(nullptr), service(util::metrics::INVALID_SERVICE),
+      keepalive_timeout(keepalive_timeout), keepalive_max_requests(keepalive_max_requests),
+      processed_requests(0), keep_alive(false), reading_request(false), timer_armed(false)
 {
 }
 
@@ -25,6 +53,14 @@ boost::asio::ip::tcp::socket &Connection::socket() { return TCP_socket; }
 
 /// Start the first asynchronous operation for the connection.
 void Connection::start()
+{
+    // the first request is expected right after connecting
+    reading_request = true;
+    arm_timer(REQUEST_TIMEOUT);
+    read();
+}
+
+void Connection::read()
 {
     TCP_socket.async_read_some(
         boost::asio::buffer(incoming_data_buffer),
@@ -41,109 +77,172 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
         return;
     }
 
+    process(incoming_data_buffer.data(), incoming_data_buffer.data() + bytes_transferred);
+}
+
+void Connection::process(char *begin, char *end)
+{
     // no error detected, let's parse the request
     http::compression_type compression_type(http::no_compression);
     RequestParser::RequestStatus result;
-    std::tie(result, compression_type) =
-        request_parser.parse(current_request,
-                             incoming_data_buffer.data(),
-                             incoming_data_buffer.data() + bytes_transferred);
+    std::tie(result, compression_type, pending_begin) =
+        request_parser.parse(current_request, begin, end);
+    pending_end = end;
 
     // the request has been parsed
     if (result == RequestParser::RequestStatus::valid)
     {
+        cancel_timer();
+        reading_request = false;
+        ++processed_requests;
+        keep_alive = current_request.keep_alive && processed_requests < keepalive_max_requests;
+
         current_request.endpoint = TCP_socket.remote_endpoint().address();
-        request_handler.HandleRequest(current_request, current_reply);
 
-        // compress the result w/ gzip/deflate if requested
-        switch (compression_type)
+        // the routing computation runs on the compute pool, the reply is sent from the strand
+        service = util::metrics::FindService(getServiceName(current_request.uri));
+        auto self = this->shared_from_this();
+        const auto accepted = compute_pool.Submit(service, [self, compression_type] {
+            self->request_handler.HandleRequest(self->current_request, self->current_reply);
+            self->strand.post(boost::bind(&Connection::handle_response, self, compression_type));
+        });
+        if (!accepted)
         {
-        case http::deflate_rfc1951:
-            // use deflate for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "deflate"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::gzip_rfc1952:
-            // use gzip for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "gzip"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::no_compression:
-            // don't use any compression
-            current_reply.set_uncompressed_size();
-            output_buffer = current_reply.to_buffers();
-            break;
+            current_reply = http::reply::stock_reply(http::reply::service_unavailable);
+            handle_response(http::no_compression);
         }
-        // write result to stream
-        boost::asio::async_write(TCP_socket,
-                                 output_buffer,
-                                 strand.wrap(boost::bind(&Connection::handle_write,
-                                                         this->shared_from_this(),
-                                                         boost::asio::placeholders::error)));
     }
     else if (result == RequestParser::RequestStatus::invalid)
     { // request is not parseable
+        cancel_timer();
+        reading_request = false;
+        keep_alive = false;
         current_reply = http::reply::stock_reply(http::reply::bad_request);
+        current_reply.headers.emplace_back("Connection", "close");
+        write(http::no_compression);
+    }
+    else
+    {
+        // we don't have a result yet, so continue reading. The deadline of the request starts
+        // with its first bytes and is not extended by further partial reads.
+        if (!reading_request)
+        {
+            reading_request = true;
+            arm_timer(REQUEST_TIMEOUT);
+        }
+        read();
+    }
+}
+
+void Connection::handle_response(const http::compression_type compression_type)
+{
+    current_reply.headers.emplace_back("Connection", keep_alive ? "keep-alive" : "close");
+
+    // compress the result w/ gzip/deflate if requested and worth it, off the I/O thread
+    if (compression_pool.ShouldCompress(compression_type, current_reply.content))
+    {
+        compression_start = std::chrono::steady_clock::now();
+        auto self = this->shared_from_this();
+        compression_pool.Compress(current_reply.content,
+                                  compression_type,
+                                  compressed_output,
+                                  strand.wrap([self](const http::compression_type applied) {
+                                      self->write(applied);
+                                  }));
+    }
+    else
+    {
+        write(http::no_compression);
+    }
+}
 
-        boost::asio::async_write(TCP_socket,
-                                 current_reply.to_buffers(),
-                                 strand.wrap(boost::bind(&Connection::handle_write,
-                                                         this->shared_from_this(),
-                                                         boost::asio::placeholders::error)));
+void Connection::write(const http::compression_type compression_type)
+{
+    if (compression_type != http::no_compression)
+    {
+        current_reply.headers.insert(
+            current_reply.headers.begin(),
+            {"Content-Encoding", compression_type == http::gzip_rfc1952 ? "gzip" : "deflate"});
+        util::metrics::Record(service,
+                              util::metrics::Stage::Compression,
+                              std::chrono::steady_clock::now() - compression_start);
+        current_reply.set_size(compressed_output.size());
+        output_buffer = current_reply.headers_to_buffers();
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
     }
     else
     {
-        // we don't have a result yet, so continue reading
-        TCP_socket.async_read_some(
-            boost::asio::buffer(incoming_data_buffer),
-            strand.wrap(boost::bind(&Connection::handle_read,
-                                    this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred)));
+        current_reply.set_uncompressed_size();
+        output_buffer = current_reply.to_buffers();
     }
+
+    // write result to stream, the reply is sent directly from its buffers
+    boost::asio::async_write(TCP_socket,
+                             output_buffer,
+                             strand.wrap(boost::bind(&Connection::handle_write,
+                                                     this->shared_from_this(),
+                                                     boost::asio::placeholders::error)));
 }
 
 /// Handle completion of a write operation.
 void Connection::handle_write(const boost::system::error_code &error)
 {
-    if (!error)
+    if (error)
+    {
+        return;
+    }
+
+    if (!keep_alive)
     {
         // Initiate graceful connection closure.
         boost::system::error_code ignore_error;
         TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+        return;
+    }
+
+    current_request.clear();
+    current_reply.clear();
+    request_parser.reset();
+
+    // answer requests that were pipelined behind the current one before reading again
+    if (pending_begin != pending_end)
+    {
+        process(pending_begin, pending_end);
+    }
+    else
+    {
+        // idle until the next request arrives
+        arm_timer(keepalive_timeout);
+        read();
     }
 }
 
-std::vector<char> Connection::compress_buffers(const std::vector<char> &uncompressed_data,
-                                               const http::compression_type compression_type)
+void Connection::arm_timer(const long seconds)
 {
-    boost::iostreams::gzip_params compression_parameters;
+    timer_armed = true;
+    timer.expires_from_now(boost::posix_time::seconds(seconds));
+    timer.async_wait(strand.wrap(boost::bind(
+        &Connection::handle_timeout, this->shared_from_this(), boost::asio::placeholders::error)));
+}
 
-    // there's a trade-off between speed and size. speed wins
-    compression_parameters.level = boost::iostreams::zlib::best_speed;
-    // check which compression flavor is used
-    if (http::deflate_rfc1951 == compression_type)
+void Connection::cancel_timer()
+{
+    timer_armed = false;
+    timer.cancel();
+}
+
+void Connection::handle_timeout(const boost::system::error_code &error)
+{
+    // the timer is cancelled once a request is complete and re-armed for the next one
+    if (error == boost::asio::error::operation_aborted || !timer_armed ||
+        timer.expires_at() > boost::asio::deadline_timer::traits_type::now())
     {
-        compression_parameters.noheader = true;
+        return;
     }
 
-    std::vector<char> compressed_data;
-    // plug data into boost's compression stream
-    boost::iostreams::filtering_ostream gzip_stream;
-    gzip_stream.push(boost::iostreams::gzip_compressor(compression_parameters));
-    gzip_stream.push(boost::iostreams::back_inserter(compressed_data));
-    gzip_stream.write(&uncompressed_data[0], uncompressed_data.size());
-    boost::iostreams::close(gzip_stream);
-
-    return compressed_data;
+    boost::system::error_code ignore_error;
+    TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+    TCP_socket.close(ignore_error);
 }
 }
 }
@@ -7,6 +7,7 @@
 
 #include "util/json_renderer.hpp"
 #include "util/log.hpp"
+#include "util/metrics.hpp"
 #include "util/string_util.hpp"
 #include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
@@ -22,6 +23,7 @@
 #include <ctime>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <string>
@@ -32,12 +34,24 @@ namespace osrm
 namespace server
 {
 
+namespace
+{
+// counted per thread, so sampling does not need a shared counter
+thread_local unsigned access_log_counter = 0;
+}
+
 void RequestHandler::RegisterServiceHandler(
     std::unique_ptr<ServiceHandlerInterface> service_handler_)
 {
     service_handler = std::move(service_handler_);
 }
 
+void RequestHandler::SetAccessLogSampleRate(const unsigned sample_rate)
+{
+    BOOST_ASSERT(sample_rate > 0);
+    access_log_sample_rate = sample_rate;
+}
+
 void RequestHandler::HandleRequest(const http::request &current_request, http::reply &current_reply)
 {
     if (!service_handler)
@@ -58,10 +72,28 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
         util::Log(logDEBUG) << "[req][" << tid << "] " << request_string;
 
+        if (request_string == "/metrics")
+        {
+            service_handler->RenderMetrics(current_reply.content);
+            current_reply.headers.emplace_back("Content-Type", "text/plain; version=0.0.4");
+            current_reply.headers.emplace_back("Content-Length",
+                                               std::to_string(current_reply.content.size()));
+            return;
+        }
+
         auto api_iterator = request_string.begin();
         auto maybe_parsed_url = api::parseURL(api_iterator, request_string.end());
         ServiceHandler::ResultT result;
 
+        // stages are recorded for the requested service from here on
+        const auto service = maybe_parsed_url
+                                 ? util::metrics::FindService(maybe_parsed_url->service)
+                                 : util::metrics::INVALID_SERVICE;
+        util::metrics::ScopedService scoped_service(service);
+        util::metrics::Record(service,
+                              util::metrics::Stage::ParseURL,
+                              std::chrono::steady_clock::now() - request_duration_start);
+
         // check if the was an error with the request
         if (maybe_parsed_url && api_iterator == request_string.end())
         {
@@ -108,8 +140,17 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
             current_reply.headers.emplace_back("Content-Disposition",
                                                "inline; filename=\"response.json\"");
 
+            util::metrics::ScopedStage render_stage(util::metrics::Stage::Render);
             util::json::render(current_reply.content, result.get<util::json::Object>());
         }
+        else if (result.is<std::vector<char>>())
+        {
+            current_reply.headers.emplace_back("Content-Type", "application/json; charset=UTF-8");
+            current_reply.headers.emplace_back("Content-Disposition",
+                                               "inline; filename=\"response.json\"");
+
+            current_reply.content = std::move(result.get<std::vector<char>>());
+        }
         else
         {
             BOOST_ASSERT(result.is<std::string>());
@@ -125,7 +166,12 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         current_reply.headers.emplace_back("Content-Length",
                                            std::to_string(current_reply.content.size()));
 
-        if (!std::getenv("DISABLE_ACCESS_LOGGING"))
+        util::metrics::Record(service,
+                              util::metrics::Stage::Request,
+                              std::chrono::steady_clock::now() - request_duration_start);
+
+        if (!std::getenv("DISABLE_ACCESS_LOGGING") &&
+            ++access_log_counter % access_log_sample_rate == 0)
         {
             // deactivated as GCC apparently does not implement that, not even in 4.9
             // std::time_t t = std::time(nullptr);
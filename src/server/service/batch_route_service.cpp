@@ -0,0 +1,89 @@
+#include "server/service/batch_route_service.hpp"
+#include "server/service/utils.hpp"
+
+#include "server/api/parameters_parser.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/format.hpp>
+
+namespace osrm
+{
+namespace server
+{
+namespace service
+{
+
+namespace
+{
+std::string getWrongOptionHelp(const engine::api::BatchRouteParameters &parameters)
+{
+    std::string help;
+
+    const auto coord_size = parameters.coordinates.size();
+
+    const bool param_size_mismatch =
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "hints", parameters.hints, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "bearings", parameters.bearings, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "radiuses", parameters.radiuses, coord_size, help);
+
+    if (!param_size_mismatch && parameters.pairs.empty())
+    {
+        help = "Number of pairs needs to be at least one.";
+    }
+    else if (!param_size_mismatch)
+    {
+        help = "Pairs need to refer to the indices of the coordinates.";
+    }
+
+    return help;
+}
+} // anon. ns
+
+engine::Status
+BatchRouteService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+{
+    result = util::json::Object();
+    auto &json_result = result.get<util::json::Object>();
+
+    auto query_iterator = query.begin();
+    auto parameters =
+        api::parseParameters<engine::api::BatchRouteParameters>(query_iterator, query.end());
+    if (!parameters || query_iterator != query.end())
+    {
+        const auto position = std::distance(query.begin(), query_iterator);
+        json_result.values["code"] = "InvalidQuery";
+        json_result.values["message"] =
+            "Query string malformed close to position " + std::to_string(prefix_length + position);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters);
+
+    if (!parameters->IsValid())
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = getWrongOptionHelp(*parameters);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters->IsValid());
+
+    if (parameters->format != engine::api::BaseParameters::OutputFormatType::JSON)
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = "Only the json format is supported by this service";
+        return engine::Status::Error;
+    }
+
+    // stream the response directly into the reply buffer
+    result = std::vector<char>();
+    util::json::Writer writer(result.get<std::vector<char>>());
+    return BaseService::routing_machine.BatchRoute(*parameters, writer);
+}
+}
+}
+}
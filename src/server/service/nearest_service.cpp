@@ -67,6 +67,13 @@ NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    if (parameters->format != engine::api::BaseParameters::OutputFormatType::JSON)
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = "Only the json format is supported by this service";
+        return engine::Status::Error;
+    }
+
     return BaseService::routing_machine.Nearest(*parameters, json_result);
 }
 }
@@ -64,6 +64,12 @@ RouteService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::PBF)
+    {
+        result = std::string();
+        return BaseService::routing_machine.Route(*parameters, result.get<std::string>());
+    }
+
     return BaseService::routing_machine.Route(*parameters, json_result);
 }
 }
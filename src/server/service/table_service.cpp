@@ -4,6 +4,7 @@
 #include "engine/api/table_parameters.hpp"
 
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
 
 #include <boost/format.hpp>
 
@@ -85,7 +86,16 @@ TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Table(*parameters, json_result);
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::PBF)
+    {
+        result = std::string();
+        return BaseService::routing_machine.Table(*parameters, result.get<std::string>());
+    }
+
+    // stream the response directly into the reply buffer
+    result = std::vector<char>();
+    util::json::Writer writer(result.get<std::vector<char>>());
+    return BaseService::routing_machine.Table(*parameters, writer);
 }
 }
 }
@@ -67,6 +67,13 @@ engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &que
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    if (parameters->format != engine::api::BaseParameters::OutputFormatType::JSON)
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = "Only the json format is supported by this service";
+        return engine::Status::Error;
+    }
+
     return BaseService::routing_machine.Trip(*parameters, json_result);
 }
 }
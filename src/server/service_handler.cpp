@@ -1,5 +1,8 @@
 #include "server/service_handler.hpp"
 
+#include "server/service/batch_nearest_service.hpp"
+#include "server/service/batch_route_service.hpp"
+#include "server/service/isochrone_service.hpp"
 #include "server/service/match_service.hpp"
 #include "server/service/nearest_service.hpp"
 #include "server/service/route_service.hpp"
@@ -9,6 +12,7 @@
 
 #include "server/api/parsed_url.hpp"
 #include "util/json_util.hpp"
+#include "util/metrics.hpp"
 
 #include <memory>
 
@@ -24,6 +28,14 @@ ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(con
     service_map["trip"] = std::make_unique<service::TripService>(routing_machine);
     service_map["match"] = std::make_unique<service::MatchService>(routing_machine);
     service_map["tile"] = std::make_unique<service::TileService>(routing_machine);
+    service_map["isochrone"] = std::make_unique<service::IsochroneService>(routing_machine);
+    service_map["batch"] = std::make_unique<service::BatchRouteService>(routing_machine);
+    service_map["snap"] = std::make_unique<service::BatchNearestService>(routing_machine);
+
+    for (const auto &service : service_map)
+    {
+        util::metrics::RegisterService(service.first);
+    }
 }
 
 engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
@@ -51,5 +63,7 @@ engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
 
     return service->RunQuery(parsed_url.prefix_length, parsed_url.query, result);
 }
+
+void ServiceHandler::RenderMetrics(std::vector<char> &output) { util::metrics::Render(output); }
 }
 }
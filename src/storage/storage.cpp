@@ -1,5 +1,6 @@
 #include "storage/storage.hpp"
 #include "contractor/query_edge.hpp"
+#include "contractor/sweep_edge.hpp"
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/original_edge_data.hpp"
@@ -16,6 +17,7 @@
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
+#include "util/integer_range.hpp"
 #include "util/io.hpp"
 #include "util/log.hpp"
 #include "util/packed_vector.hpp"
@@ -50,8 +52,10 @@ namespace storage
 {
 
 using RTreeLeaf = engine::datafacade::BaseDataFacade::RTreeLeaf;
-using RTreeNode =
-    util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>::TreeNode;
+using SharedRTree =
+    util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
+using RTreeNode = SharedRTree::TreeNode;
+using RTreeLeafNode = SharedRTree::LeafNode;
 using QueryGraph = util::StaticGraph<contractor::QueryEdge::EdgeData>;
 
 Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
@@ -83,6 +87,89 @@ RegionsLayout getRegionsLayout(SharedBarriers &barriers)
     return RegionsLayout{REGION_2, barriers.region_2_mutex, REGION_1, barriers.region_1_mutex};
 }
 
+// A weight update goes into the weights region the current dataset does not use
+RegionsLayout getWeightsRegionsLayout(SharedBarriers &barriers)
+{
+    auto shared_region = makeSharedMemory(CURRENT_REGION);
+    const auto shared_timestamp = static_cast<const SharedDataTimestamp *>(shared_region->Ptr());
+    if (shared_timestamp->weights_region == WEIGHTS_REGION_1)
+    {
+        return RegionsLayout{WEIGHTS_REGION_1,
+                             barriers.weights_region_1_mutex,
+                             WEIGHTS_REGION_2,
+                             barriers.weights_region_2_mutex};
+    }
+
+    return RegionsLayout{WEIGHTS_REGION_2,
+                         barriers.weights_region_2_mutex,
+                         WEIGHTS_REGION_1,
+                         barriers.weights_region_1_mutex};
+}
+
+// Returns the data region of the current dataset or REGION_NONE if nothing was loaded yet
+SharedDataType getCurrentDataRegion()
+{
+    if (!SharedMemory::RegionExists(CURRENT_REGION))
+    {
+        return REGION_NONE;
+    }
+
+    auto shared_region = makeSharedMemory(CURRENT_REGION);
+    const auto shared_timestamp = static_cast<const SharedDataTimestamp *>(shared_region->Ptr());
+    if ((shared_timestamp->region != REGION_1 && shared_timestamp->region != REGION_2) ||
+        !SharedMemory::RegionExists(shared_timestamp->region))
+    {
+        return REGION_NONE;
+    }
+
+    return shared_timestamp->region;
+}
+
+// Makes sure a weight update can replace the weight blocks of the given dataset
+void checkWeightLayout(const DataLayout &layout, const DataLayout &data_layout)
+{
+    const auto check = [&](const DataLayout::BlockID bid, const std::uint64_t expected) {
+        if (layout.num_entries[bid] != expected)
+        {
+            throw util::exception("Weight update does not match the current dataset, " +
+                                  std::string(block_id_to_name[bid]) + " has " +
+                                  std::to_string(layout.num_entries[bid]) + " instead of " +
+                                  std::to_string(expected) + " entries. Load the full dataset." +
+                                  SOURCE_REF);
+        }
+    };
+
+    const auto number_of_segments = data_layout.num_entries[DataLayout::GEOMETRIES_NODE_LIST];
+    check(DataLayout::GRAPH_NODE_LIST, data_layout.num_entries[DataLayout::GRAPH_NODE_LIST]);
+    check(DataLayout::CORE_MARKER, data_layout.num_entries[DataLayout::CORE_MARKER]);
+    check(DataLayout::GEOMETRIES_FWD_WEIGHT_LIST, number_of_segments);
+    check(DataLayout::GEOMETRIES_REV_WEIGHT_LIST, number_of_segments);
+    if (layout.num_entries[DataLayout::DATASOURCES_LIST] > 0)
+    {
+        check(DataLayout::DATASOURCES_LIST, number_of_segments);
+    }
+}
+
+// Removes the weight regions of replaced datasets. Regions that are still in use are removed
+// by the last facade using them.
+void removeUnusedWeightsRegions(SharedBarriers &barriers)
+{
+    for (const auto region : {WEIGHTS_REGION_1, WEIGHTS_REGION_2})
+    {
+        if (!SharedMemory::RegionExists(region))
+        {
+            continue;
+        }
+
+        boost::interprocess::scoped_lock<boost::interprocess::named_sharable_mutex> region_lock(
+            barriers.GetRegionMutex(region), boost::interprocess::try_to_lock);
+        if (region_lock.owns())
+        {
+            SharedMemory::Remove(region);
+        }
+    }
+}
+
 Storage::ReturnCode Storage::Run(int max_wait)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
@@ -118,7 +205,17 @@ Storage::ReturnCode Storage::Run(int max_wait)
     }
 #endif
 
-    auto regions_layout = getRegionsLayout(barriers);
+    // a weight update shares all other blocks with the current dataset
+    const SharedDataType base_data_region =
+        config.update_weights ? getCurrentDataRegion() : REGION_NONE;
+    if (config.update_weights && base_data_region == REGION_NONE)
+    {
+        util::Log(logWARNING) << "No dataset loaded that the weights could be applied to";
+        return ReturnCode::Error;
+    }
+
+    auto regions_layout =
+        config.update_weights ? getWeightsRegionsLayout(barriers) : getRegionsLayout(barriers);
     const SharedDataType data_region = regions_layout.old_data_region;
 
     if (max_wait > 0)
@@ -142,15 +239,7 @@ Storage::ReturnCode Storage::Run(int max_wait)
             util::Log(logWARNING) << "Queries did not finish in " << max_wait
                                   << " seconds. Claiming the lock by force.";
             // WARNING: if queries are still using the old dataset they might crash
-            if (regions_layout.old_data_region == REGION_1)
-            {
-                barriers.resetRegion1();
-            }
-            else
-            {
-                BOOST_ASSERT(regions_layout.old_data_region == REGION_2);
-                barriers.resetRegion2();
-            }
+            barriers.resetRegion(regions_layout.old_data_region);
 
             return ReturnCode::Retry;
         }
@@ -172,6 +261,22 @@ Storage::ReturnCode Storage::Run(int max_wait)
     DataLayout layout;
     PopulateLayout(layout);
 
+    if (config.update_weights)
+    {
+        // keep the entry sizes so that the layout still aligns, but store no other blocks
+        for (const auto bid : util::irange(0, static_cast<int>(DataLayout::NUM_BLOCKS)))
+        {
+            if (!DataLayout::IsWeightBlock(static_cast<DataLayout::BlockID>(bid)))
+            {
+                layout.num_entries[bid] = 0;
+            }
+        }
+
+        auto base_memory = makeSharedMemory(base_data_region);
+        checkWeightLayout(layout, *static_cast<const DataLayout *>(base_memory->Ptr()));
+        util::Log() << "applying weights to the dataset in " << regionToString(base_data_region);
+    }
+
     // Allocate shared memory block
     auto regions_size = sizeof(layout) + layout.GetSizeOfLayout();
     util::Log() << "allocating shared memory of " << regions_size << " bytes";
@@ -180,7 +285,14 @@ Storage::ReturnCode Storage::Run(int max_wait)
     // Copy memory layout to shared memory and populate data
     char *shared_memory_ptr = static_cast<char *>(shared_memory->Ptr());
     memcpy(shared_memory_ptr, &layout, sizeof(layout));
-    PopulateData(layout, shared_memory_ptr + sizeof(layout));
+    if (config.update_weights)
+    {
+        PopulateWeightData(layout, shared_memory_ptr + sizeof(layout));
+    }
+    else
+    {
+        PopulateData(layout, shared_memory_ptr + sizeof(layout));
+    }
 
     auto data_type_memory = makeSharedMemory(CURRENT_REGION, sizeof(SharedDataTimestamp), true);
     SharedDataTimestamp *data_timestamp_ptr =
@@ -219,9 +331,23 @@ Storage::ReturnCode Storage::Run(int max_wait)
         }
 
         util::Log() << "Ok.";
-        data_timestamp_ptr->region = data_region;
+        if (config.update_weights)
+        {
+            data_timestamp_ptr->region = base_data_region;
+            data_timestamp_ptr->weights_region = data_region;
+        }
+        else
+        {
+            data_timestamp_ptr->region = data_region;
+            data_timestamp_ptr->weights_region = REGION_NONE;
+        }
         data_timestamp_ptr->timestamp += 1;
     }
+
+    if (!config.update_weights)
+    {
+        removeUnusedWeightsRegions(barriers);
+    }
     util::Log() << "All data loaded.";
 
     return ReturnCode::Ok;
@@ -298,16 +424,39 @@ void Storage::PopulateLayout(DataLayout &layout)
                                                         hsgr_header.number_of_nodes);
         layout.SetBlockSize<QueryGraph::EdgeArrayEntry>(DataLayout::GRAPH_EDGE_LIST,
                                                         hsgr_header.number_of_edges);
+
+        hsgr_file.Skip<QueryGraph::NodeArrayEntry>(hsgr_header.number_of_nodes);
+        hsgr_file.Skip<QueryGraph::EdgeArrayEntry>(hsgr_header.number_of_edges);
+        const auto sweep_header = serialization::readHSGRSweepHeader(hsgr_file);
+        layout.SetBlockSize<contractor::SweepNode>(DataLayout::GRAPH_SWEEP_NODE_LIST,
+                                                   sweep_header.number_of_sweep_nodes);
+        layout.SetBlockSize<NodeID>(DataLayout::GRAPH_SWEEP_POSITION_LIST,
+                                    serialization::sweepPositionCount(sweep_header));
+        layout.SetBlockSize<contractor::SweepEdge>(DataLayout::GRAPH_SWEEP_EDGE_LIST,
+                                                   sweep_header.number_of_sweep_edges);
     }
 
     // load rsearch tree size
     {
         io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
 
-        const auto tree_size = tree_node_file.ReadElementCount64();
+        const auto tree_size = SharedRTree::ReadTreeHeader(tree_node_file);
         layout.SetBlockSize<RTreeNode>(DataLayout::R_SEARCH_TREE, tree_size);
     }
 
+    // the leaves of the rtree are only kept in memory on request, otherwise they are mapped
+    // from the leaf file by each facade
+    {
+        std::uint64_t number_of_leaves = 0;
+        if (config.load_rtree_leaves)
+        {
+            io::FileReader leaf_node_file(config.file_index_path,
+                                          io::FileReader::HasNoFingerprint);
+            number_of_leaves = leaf_node_file.Size() / sizeof(RTreeLeafNode);
+        }
+        layout.SetBlockSize<RTreeLeafNode>(DataLayout::R_SEARCH_LEAVES, number_of_leaves);
+    }
+
     {
         // allocate space in shared memory for profile properties
         const auto properties_size = serialization::readPropertiesCount();
@@ -429,12 +578,10 @@ void Storage::PopulateLayout(DataLayout &layout)
     }
 }
 
-void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
+void Storage::PopulateWeightData(const DataLayout &layout, char *memory_ptr)
 {
     BOOST_ASSERT(memory_ptr != nullptr);
 
-    // read actual data into shared memory object //
-
     // Load the HSGR file
     {
         io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::VerifyFingerprint);
@@ -458,8 +605,151 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                 hsgr_header.number_of_nodes,
                                 graph_edge_list_ptr,
                                 hsgr_header.number_of_edges);
+
+        // load the downward sweep over the search graph
+        const auto sweep_header = serialization::readHSGRSweepHeader(hsgr_file);
+        const auto sweep_node_list_ptr = layout.GetBlockPtr<contractor::SweepNode, true>(
+            memory_ptr, DataLayout::GRAPH_SWEEP_NODE_LIST);
+        const auto sweep_position_list_ptr =
+            layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::GRAPH_SWEEP_POSITION_LIST);
+        const auto sweep_edge_list_ptr = layout.GetBlockPtr<contractor::SweepEdge, true>(
+            memory_ptr, DataLayout::GRAPH_SWEEP_EDGE_LIST);
+        serialization::readHSGRSweep(hsgr_file,
+                                     sweep_node_list_ptr,
+                                     sweep_position_list_ptr,
+                                     sweep_edge_list_ptr,
+                                     sweep_header);
+    }
+
+    // load the weights of the compressed geometries
+    {
+        io::FileReader geometry_input_file(config.geometries_path,
+                                           io::FileReader::HasNoFingerprint);
+
+        const auto geometry_index_count = geometry_input_file.ReadElementCount32();
+        geometry_input_file.Skip<unsigned>(geometry_index_count);
+        const auto geometry_node_lists_count = geometry_input_file.ReadElementCount32();
+        geometry_input_file.Skip<NodeID>(geometry_node_lists_count);
+
+        const auto geometries_fwd_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
+            memory_ptr, DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
+        BOOST_ASSERT(geometry_node_lists_count ==
+                     layout.num_entries[DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]);
+        geometry_input_file.ReadInto(geometries_fwd_weight_list_ptr, geometry_node_lists_count);
+
+        const auto geometries_rev_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
+            memory_ptr, DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
+        BOOST_ASSERT(geometry_node_lists_count ==
+                     layout.num_entries[DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
+        geometry_input_file.ReadInto(geometries_rev_weight_list_ptr, geometry_node_lists_count);
+    }
+
+    {
+        io::FileReader geometry_datasource_file(config.datasource_indexes_path,
+                                                io::FileReader::HasNoFingerprint);
+        const auto number_of_compressed_datasources = geometry_datasource_file.ReadElementCount64();
+
+        // load datasource information (if it exists)
+        const auto datasources_list_ptr =
+            layout.GetBlockPtr<uint8_t, true>(memory_ptr, DataLayout::DATASOURCES_LIST);
+        if (number_of_compressed_datasources > 0)
+        {
+            serialization::readDatasourceIndexes(
+                geometry_datasource_file, datasources_list_ptr, number_of_compressed_datasources);
+        }
     }
 
+    {
+        /* Load names */
+        io::FileReader datasource_names_file(config.datasource_names_path,
+                                             io::FileReader::HasNoFingerprint);
+
+        const auto datasource_names_data =
+            serialization::readDatasourceNames(datasource_names_file);
+
+        // load datasource name information (if it exists)
+        const auto datasource_name_data_ptr =
+            layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::DATASOURCE_NAME_DATA);
+        if (layout.GetBlockSize(DataLayout::DATASOURCE_NAME_DATA) > 0)
+        {
+            BOOST_ASSERT(std::distance(datasource_names_data.names.begin(),
+                                       datasource_names_data.names.end()) *
+                             sizeof(decltype(datasource_names_data.names)::value_type) <=
+                         layout.GetBlockSize(DataLayout::DATASOURCE_NAME_DATA));
+            std::copy(datasource_names_data.names.begin(),
+                      datasource_names_data.names.end(),
+                      datasource_name_data_ptr);
+        }
+
+        const auto datasource_name_offsets_ptr =
+            layout.GetBlockPtr<std::size_t, true>(memory_ptr, DataLayout::DATASOURCE_NAME_OFFSETS);
+        if (layout.GetBlockSize(DataLayout::DATASOURCE_NAME_OFFSETS) > 0)
+        {
+            BOOST_ASSERT(std::distance(datasource_names_data.offsets.begin(),
+                                       datasource_names_data.offsets.end()) *
+                             sizeof(decltype(datasource_names_data.offsets)::value_type) <=
+                         layout.GetBlockSize(DataLayout::DATASOURCE_NAME_OFFSETS));
+            std::copy(datasource_names_data.offsets.begin(),
+                      datasource_names_data.offsets.end(),
+                      datasource_name_offsets_ptr);
+        }
+
+        const auto datasource_name_lengths_ptr =
+            layout.GetBlockPtr<std::size_t, true>(memory_ptr, DataLayout::DATASOURCE_NAME_LENGTHS);
+        if (layout.GetBlockSize(DataLayout::DATASOURCE_NAME_LENGTHS) > 0)
+        {
+            BOOST_ASSERT(std::distance(datasource_names_data.lengths.begin(),
+                                       datasource_names_data.lengths.end()) *
+                             sizeof(decltype(datasource_names_data.lengths)::value_type) <=
+                         layout.GetBlockSize(DataLayout::DATASOURCE_NAME_LENGTHS));
+            std::copy(datasource_names_data.lengths.begin(),
+                      datasource_names_data.lengths.end(),
+                      datasource_name_lengths_ptr);
+        }
+    }
+
+    {
+        io::FileReader core_marker_file(config.core_data_path, io::FileReader::HasNoFingerprint);
+        const auto number_of_core_markers = core_marker_file.ReadElementCount32();
+
+        // load core markers
+        std::vector<char> unpacked_core_markers(number_of_core_markers);
+        core_marker_file.ReadInto(unpacked_core_markers.data(), number_of_core_markers);
+
+        const auto core_marker_ptr =
+            layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::CORE_MARKER);
+
+        for (auto i = 0u; i < number_of_core_markers; ++i)
+        {
+            BOOST_ASSERT(unpacked_core_markers[i] == 0 || unpacked_core_markers[i] == 1);
+
+            if (unpacked_core_markers[i] == 1)
+            {
+                const unsigned bucket = i / 32;
+                const unsigned offset = i % 32;
+                const unsigned value = [&] {
+                    unsigned return_value = 0;
+                    if (0 != offset)
+                    {
+                        return_value = core_marker_ptr[bucket];
+                    }
+                    return return_value;
+                }();
+
+                core_marker_ptr[bucket] = (value | (1u << offset));
+            }
+        }
+    }
+}
+
+void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
+{
+    BOOST_ASSERT(memory_ptr != nullptr);
+
+    // read actual data into shared memory object //
+
+    PopulateWeightData(layout, memory_ptr);
+
     // store the filename of the on-disk portion of the RTree
     {
         const auto file_index_path_ptr =
@@ -619,82 +909,6 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_NODE_LIST]);
         geometry_input_file.ReadInto(geometries_node_id_list_ptr, geometry_node_lists_count);
-
-        const auto geometries_fwd_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
-            memory_ptr, DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
-        BOOST_ASSERT(geometry_node_lists_count ==
-                     layout.num_entries[DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]);
-        geometry_input_file.ReadInto(geometries_fwd_weight_list_ptr, geometry_node_lists_count);
-
-        const auto geometries_rev_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
-            memory_ptr, DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
-        BOOST_ASSERT(geometry_node_lists_count ==
-                     layout.num_entries[DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
-        geometry_input_file.ReadInto(geometries_rev_weight_list_ptr, geometry_node_lists_count);
-    }
-
-    {
-        io::FileReader geometry_datasource_file(config.datasource_indexes_path,
-                                                io::FileReader::HasNoFingerprint);
-        const auto number_of_compressed_datasources = geometry_datasource_file.ReadElementCount64();
-
-        // load datasource information (if it exists)
-        const auto datasources_list_ptr =
-            layout.GetBlockPtr<uint8_t, true>(memory_ptr, DataLayout::DATASOURCES_LIST);
-        if (number_of_compressed_datasources > 0)
-        {
-            serialization::readDatasourceIndexes(
-                geometry_datasource_file, datasources_list_ptr, number_of_compressed_datasources);
-        }
-    }
-
-    {
-        /* Load names */
-        io::FileReader datasource_names_file(config.datasource_names_path,
-                                             io::FileReader::HasNoFingerprint);
-
-        const auto datasource_names_data =
-            serialization::readDatasourceNames(datasource_names_file);
-
-        // load datasource name information (if it exists)
-        const auto datasource_name_data_ptr =
-            layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::DATASOURCE_NAME_DATA);
-        if (layout.GetBlockSize(DataLayout::DATASOURCE_NAME_DATA) > 0)
-        {
-            BOOST_ASSERT(std::distance(datasource_names_data.names.begin(),
-                                       datasource_names_data.names.end()) *
-                             sizeof(decltype(datasource_names_data.names)::value_type) <=
-                         layout.GetBlockSize(DataLayout::DATASOURCE_NAME_DATA));
-            std::copy(datasource_names_data.names.begin(),
-                      datasource_names_data.names.end(),
-                      datasource_name_data_ptr);
-        }
-
-        const auto datasource_name_offsets_ptr =
-            layout.GetBlockPtr<std::size_t, true>(memory_ptr, DataLayout::DATASOURCE_NAME_OFFSETS);
-        if (layout.GetBlockSize(DataLayout::DATASOURCE_NAME_OFFSETS) > 0)
-        {
-            BOOST_ASSERT(std::distance(datasource_names_data.offsets.begin(),
-                                       datasource_names_data.offsets.end()) *
-                             sizeof(decltype(datasource_names_data.offsets)::value_type) <=
-                         layout.GetBlockSize(DataLayout::DATASOURCE_NAME_OFFSETS));
-            std::copy(datasource_names_data.offsets.begin(),
-                      datasource_names_data.offsets.end(),
-                      datasource_name_offsets_ptr);
-        }
-
-        const auto datasource_name_lengths_ptr =
-            layout.GetBlockPtr<std::size_t, true>(memory_ptr, DataLayout::DATASOURCE_NAME_LENGTHS);
-        if (layout.GetBlockSize(DataLayout::DATASOURCE_NAME_LENGTHS) > 0)
-        {
-            BOOST_ASSERT(std::distance(datasource_names_data.lengths.begin(),
-                                       datasource_names_data.lengths.end()) *
-                             sizeof(decltype(datasource_names_data.lengths)::value_type) <=
-                         layout.GetBlockSize(DataLayout::DATASOURCE_NAME_LENGTHS));
-            std::copy(datasource_names_data.lengths.begin(),
-                      datasource_names_data.lengths.end(),
-                      datasource_name_lengths_ptr);
-        }
     }
 
     // Loading list of coordinates
@@ -731,43 +945,23 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
         // perform this read so that we're at the right stream position for the next
         // read.
-        tree_node_file.Skip<std::uint64_t>(1);
+        SharedRTree::ReadTreeHeader(tree_node_file);
         const auto rtree_ptr =
             layout.GetBlockPtr<RTreeNode, true>(memory_ptr, DataLayout::R_SEARCH_TREE);
 
         tree_node_file.ReadInto(rtree_ptr, layout.num_entries[DataLayout::R_SEARCH_TREE]);
     }
 
+    // store leaves of rtree if requested
     {
-        io::FileReader core_marker_file(config.core_data_path, io::FileReader::HasNoFingerprint);
-        const auto number_of_core_markers = core_marker_file.ReadElementCount32();
-
-        // load core markers
-        std::vector<char> unpacked_core_markers(number_of_core_markers);
-        core_marker_file.ReadInto(unpacked_core_markers.data(), number_of_core_markers);
-
-        const auto core_marker_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::CORE_MARKER);
-
-        for (auto i = 0u; i < number_of_core_markers; ++i)
+        const auto leaves_ptr =
+            layout.GetBlockPtr<RTreeLeafNode, true>(memory_ptr, DataLayout::R_SEARCH_LEAVES);
+        const auto number_of_leaves = layout.num_entries[DataLayout::R_SEARCH_LEAVES];
+        if (number_of_leaves > 0)
         {
-            BOOST_ASSERT(unpacked_core_markers[i] == 0 || unpacked_core_markers[i] == 1);
-
-            if (unpacked_core_markers[i] == 1)
-            {
-                const unsigned bucket = i / 32;
-                const unsigned offset = i % 32;
-                const unsigned value = [&] {
-                    unsigned return_value = 0;
-                    if (0 != offset)
-                    {
-                        return_value = core_marker_ptr[bucket];
-                    }
-                    return return_value;
-                }();
-
-                core_marker_ptr[bucket] = (value | (1u << offset));
-            }
+            io::FileReader leaf_node_file(config.file_index_path,
+                                          io::FileReader::HasNoFingerprint);
+            leaf_node_file.ReadInto(leaves_ptr, number_of_leaves);
         }
     }
 
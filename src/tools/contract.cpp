@@ -45,16 +45,22 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
         boost::program_options::value<std::vector<std::string>>(
             &contractor_config.segment_speed_lookup_paths)
             ->composing(),
-        "Lookup files containing nodeA, nodeB, speed data to adjust edge weights")(
+        "Lookup files containing nodeA, nodeB, speed data to adjust edge weights, as CSV or in "
+        "the binary format of osrm-convert-lookups")(
         "turn-penalty-file",
         boost::program_options::value<std::vector<std::string>>(
             &contractor_config.turn_penalty_lookup_paths)
             ->composing(),
-        "Lookup files containing from_, to_, via_nodes, and turn penalties to adjust turn weights")(
+        "Lookup files containing from_, to_, via_nodes, and turn penalties to adjust turn weights, "
+        "as CSV or in the binary format of osrm-convert-lookups")(
         "level-cache,o",
         boost::program_options::value<bool>(&contractor_config.use_cached_priority)
             ->default_value(false),
         "Use .level file to retain the contaction level for each node from the last run.")(
+        "customize",
+        boost::program_options::value<bool>(&contractor_config.customize_only)
+            ->default_value(false),
+        "Keep the shortcuts of the existing .hsgr file and only recompute their weights.")(
         "edge-weight-updates-over-factor",
         boost::program_options::value<double>(&contractor_config.log_edge_updates_factor)
             ->default_value(0.0),
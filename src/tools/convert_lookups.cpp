@@ -0,0 +1,149 @@
+#include "contractor/lookup_tables.hpp"
+#include "util/log.hpp"
+#include "util/version.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/program_options/errors.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+enum class return_code : unsigned
+{
+    ok,
+    fail,
+    exit
+};
+
+struct ConverterConfig
+{
+    std::vector<std::string> input_paths;
+    std::string output_path;
+    bool turn_penalties = false;
+};
+
+return_code parseArguments(int argc, char *argv[], ConverterConfig &converter_config)
+{
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message");
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options()(
+        "output,o",
+        boost::program_options::value<std::string>(&converter_config.output_path),
+        "Binary file to write, use it with --segment-speed-file or --turn-penalty-file")(
+        "turn-penalties",
+        boost::program_options::bool_switch(&converter_config.turn_penalties)
+            ->default_value(false),
+        "Convert turn penalty files instead of segment speed files");
+
+    // hidden options, will be allowed on command line, but will not be shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()(
+        "input,i",
+        boost::program_options::value<std::vector<std::string>>(&converter_config.input_paths)
+            ->composing(),
+        "CSV files, later files take precedence");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("input", -1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        "Usage: " + boost::filesystem::path(executable).filename().string() +
+        " <input.csv> [<input.csv> ...] -o <output> [options]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    if (option_variables.count("version"))
+    {
+        std::cout << OSRM_VERSION << std::endl;
+        return return_code::exit;
+    }
+
+    if (option_variables.count("help"))
+    {
+        std::cout << visible_options;
+        return return_code::exit;
+    }
+
+    boost::program_options::notify(option_variables);
+
+    if (!option_variables.count("input") || !option_variables.count("output"))
+    {
+        std::cout << visible_options;
+        return return_code::fail;
+    }
+
+    return return_code::ok;
+}
+
+int main(int argc, char *argv[]) try
+{
+    util::LogPolicy::GetInstance().Unmute();
+    ConverterConfig converter_config;
+
+    const return_code result = parseArguments(argc, argv, converter_config);
+
+    if (return_code::fail == result)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (return_code::exit == result)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    // All inputs end up in a single file, the sources of the entries are not kept
+    if (converter_config.turn_penalties)
+    {
+        const auto lookup =
+            contractor::parse_turn_penalty_lookup_from_csv_files(converter_config.input_paths);
+        contractor::writeTurnPenaltyFile(converter_config.output_path, lookup);
+        util::Log() << "Wrote " << lookup.size() << " turn penalties to "
+                    << converter_config.output_path;
+    }
+    else
+    {
+        const auto lookup =
+            contractor::parse_segment_lookup_from_csv_files(converter_config.input_paths);
+        contractor::writeSegmentSpeedFile(converter_config.output_path, lookup);
+        util::Log() << "Wrote " << lookup.size() << " speeds to " << converter_config.output_path;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
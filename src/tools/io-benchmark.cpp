@@ -11,6 +11,7 @@
 #include <fcntl.h>
 #ifdef __linux__
 #include <malloc.h>
+#include <sys/mman.h>
 #endif
 
 #include <algorithm>
@@ -18,6 +19,7 @@
 #include <iomanip>
 #include <numeric>
 #include <random>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -45,6 +47,98 @@ void runStatistics(std::vector<double> &timings_vector, Statistics &stats)
         timings_vector.begin(), timings_vector.end(), timings_vector.begin(), 0.0);
     stats.dev = std::sqrt(primary_sq_sum / timings_vector.size() - (stats.mean * stats.mean));
 }
+
+#ifdef __linux__
+const unsigned LEAF_PAGE_SIZE = 4096;
+const unsigned NUMBER_OF_LEAF_ACCESSES = 1000;
+
+// Touches random leaves of a mapped leaf file, returns the duration of each access in ms
+std::vector<double> timeRandomLeafAccesses(const char *leaves, const std::size_t number_of_leaves)
+{
+    std::random_device rd;
+    std::default_random_engine e1(rd());
+    std::uniform_int_distribution<std::size_t> uniform_dist(0, number_of_leaves - 1);
+
+    std::vector<double> timings;
+    timings.reserve(NUMBER_OF_LEAF_ACCESSES);
+    for (unsigned i = 0; i < NUMBER_OF_LEAF_ACCESSES; ++i)
+    {
+        const volatile char *leaf = leaves + uniform_dist(e1) * LEAF_PAGE_SIZE;
+        TIMER_START(leaf_access);
+        (void)*leaf;
+        TIMER_STOP(leaf_access);
+        timings.push_back(TIMER_MSEC(leaf_access));
+    }
+    return timings;
+}
+
+void logLeafStatistics(const std::string &label, std::vector<double> &timings)
+{
+    Statistics stats;
+    runStatistics(timings, stats);
+    util::Log() << label << ": " << std::setprecision(5) << std::fixed
+                << "min: " << stats.min << "ms, "
+                << "mean: " << stats.mean << "ms, "
+                << "med: " << stats.med << "ms, "
+                << "max: " << stats.max << "ms, "
+                << "dev: " << stats.dev << "ms";
+}
+
+// Maps an r-tree leaf file like the data facades do and compares the latency of queries
+// hitting cold leaves with the time it takes to warm up all leaves before serving queries.
+void runLeafBenchmark(const boost::filesystem::path &leaf_path)
+{
+    const int file_desc = open(leaf_path.string().c_str(), O_RDONLY);
+    if (-1 == file_desc)
+    {
+        throw util::exception("Could not open leaf file " + leaf_path.string() + SOURCE_REF);
+    }
+
+    const std::size_t file_size = boost::filesystem::file_size(leaf_path);
+    const std::size_t number_of_leaves = file_size / LEAF_PAGE_SIZE;
+    if (0 == number_of_leaves)
+    {
+        throw util::exception("Leaf file " + leaf_path.string() + " is empty" + SOURCE_REF);
+    }
+
+    const auto map_cold_leaves = [&] {
+        // drop the leaves from the page cache, pages still mapped by other processes
+        // (e.g. a running osrm-routed) stay cached and make the cold numbers look better
+        posix_fadvise(file_desc, 0, 0, POSIX_FADV_DONTNEED);
+        void *leaves = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, file_desc, 0);
+        if (MAP_FAILED == leaves)
+        {
+            throw util::exception("Could not map leaf file " + leaf_path.string() + SOURCE_REF);
+        }
+        return static_cast<const char *>(leaves);
+    };
+
+    util::Log() << "running " << NUMBER_OF_LEAF_ACCESSES << " random accesses to "
+                << number_of_leaves << " leaves";
+
+    const char *leaves = map_cold_leaves();
+    auto cold_timings = timeRandomLeafAccesses(leaves, number_of_leaves);
+    munmap(const_cast<char *>(leaves), file_size);
+    logLeafStatistics("cold leaf access", cold_timings);
+
+    leaves = map_cold_leaves();
+    TIMER_START(warm_up);
+    madvise(const_cast<char *>(leaves), file_size, MADV_WILLNEED);
+    for (std::size_t leaf = 0; leaf < number_of_leaves; ++leaf)
+    {
+        (void)*(const volatile char *)(leaves + leaf * LEAF_PAGE_SIZE);
+    }
+    TIMER_STOP(warm_up);
+    util::Log() << "leaf warm-up: " << std::setprecision(5) << std::fixed << TIMER_SEC(warm_up)
+                << "s, " << file_size / (1024. * 1024.) / TIMER_SEC(warm_up) << "MB/sec";
+
+    auto warm_timings = timeRandomLeafAccesses(leaves, number_of_leaves);
+    munmap(const_cast<char *>(leaves), file_size);
+    logLeafStatistics("warm leaf access", warm_timings);
+
+    close(file_desc);
+}
+#endif
 }
 }
 
@@ -65,10 +159,23 @@ int main(int argc, char *argv[])
     osrm::util::LogPolicy::GetInstance().Unmute();
     if (1 == argc)
     {
-        osrm::util::Log(logWARNING) << "usage: " << argv[0] << " /path/on/device";
+        osrm::util::Log(logWARNING) << "usage: " << argv[0]
+                                    << " /path/on/device | /path/to/data.osrm.fileIndex";
         return -1;
     }
 
+    // a leaf file measures the cost of cold r-tree leaves instead of the raw device
+    if (boost::filesystem::is_regular_file(argv[1]))
+    {
+#ifdef __linux__
+        osrm::tools::runLeafBenchmark(argv[1]);
+        return EXIT_SUCCESS;
+#else
+        osrm::util::Log() << "Leaf benchmark is only supported on Linux";
+        return 0;
+#endif
+    }
+
     test_path = boost::filesystem::path(argv[1]);
     test_path /= "osrm.tst";
     osrm::util::Log(logDEBUG) << "temporary file: " << test_path.string();
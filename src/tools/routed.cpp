@@ -1,4 +1,5 @@
 #include "server/server.hpp"
+#include "util/async_log.hpp"
 #include "util/log.hpp"
 #include "util/version.hpp"
 
@@ -55,13 +56,31 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              std::string &ip_address,
                                              int &ip_port,
                                              int &requested_num_threads,
+                                             int &io_threads,
+                                             int &max_queue_size,
+                                             int &keepalive_timeout,
+                                             int &keepalive_max_requests,
+                                             int &compression_threads,
+                                             int &compression_level,
+                                             int &compression_min_size,
+                                             int &log_buffer_size,
+                                             int &access_log_sample_rate,
                                              bool &use_shared_memory,
+                                             bool &load_rtree_leaves,
+                                             bool &warm_up,
                                              bool &trial,
                                              int &max_locations_trip,
                                              int &max_locations_viaroute,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
-                                             int &max_results_nearest)
+                                             int &max_results_nearest,
+                                             int &max_table_threads,
+                                             int &max_duration_isochrone,
+                                             int &max_pairs_batch_route,
+                                             int &max_locations_batch_nearest,
+                                             int &max_batch_threads,
+                                             int &result_cache_size,
+                                             int &snapping_cache_size)
 {
     using boost::program_options::value;
     using boost::filesystem::path;
@@ -83,10 +102,43 @@ inline unsigned generateServerProgramOptions(const int argc,
          "TCP/IP port") //
         ("threads,t",
          value<int>(&requested_num_threads)->default_value(8),
-         "Number of threads to use") //
+         "Number of threads computing requests") //
+        ("io-threads",
+         value<int>(&io_threads)->default_value(2),
+         "Number of threads reading requests and writing responses") //
+        ("max-queue-size",
+         value<int>(&max_queue_size)->default_value(128),
+         "Max. requests queued per service, more are rejected with 503") //
+        ("keepalive-timeout",
+         value<int>(&keepalive_timeout)->default_value(5),
+         "Seconds an idle connection is kept open waiting for the next request") //
+        ("keepalive-requests",
+         value<int>(&keepalive_max_requests)->default_value(512),
+         "Max. requests served over one connection (1 disables keep-alive)") //
+        ("compression-threads",
+         value<int>(&compression_threads)->default_value(2),
+         "Number of threads compressing responses") //
+        ("compression-level",
+         value<int>(&compression_level)->default_value(1),
+         "gzip/deflate compression level from 1 (fastest) to 9 (smallest)") //
+        ("compression-min-size",
+         value<int>(&compression_min_size)->default_value(1024),
+         "Responses smaller than this number of bytes are sent uncompressed") //
+        ("log-buffer-size",
+         value<int>(&log_buffer_size)->default_value(4096),
+         "Log lines buffered per thread for the background writer (0 logs synchronously)") //
+        ("access-log-sample-rate",
+         value<int>(&access_log_sample_rate)->default_value(1),
+         "Write only every n-th request to the access log") //
         ("shared-memory,s",
          value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
+        ("load-rtree-leaves",
+         value<bool>(&load_rtree_leaves)->implicit_value(true)->default_value(false),
+         "Load the r-tree leaves into memory instead of mapping them from disk") //
+        ("warm-up",
+         value<bool>(&warm_up)->implicit_value(true)->default_value(false),
+         "Fault in the r-tree leaves of a dataset before it serves requests") //
         ("max-viaroute-size",
          value<int>(&max_locations_viaroute)->default_value(500),
          "Max. locations supported in viaroute query") //
@@ -101,7 +153,30 @@ inline unsigned generateServerProgramOptions(const int argc,
          "Max. locations supported in map matching query") //
         ("max-nearest-size",
          value<int>(&max_results_nearest)->default_value(100),
-         "Max. results supported in nearest query");
+         "Max. results supported in nearest query") //
+        ("max-table-threads",
+         value<int>(&max_table_threads)->default_value(-1),
+         "Max. threads shared by all distance table queries (-1 or 0 for one per core)") //
+        ("max-isochrone-duration",
+         value<int>(&max_duration_isochrone)->default_value(3600),
+         "Max. duration in seconds supported in isochrone query") //
+        ("max-batch-route-size",
+         value<int>(&max_pairs_batch_route)->default_value(1000),
+         "Max. pairs and locations supported in batch route query") //
+        ("max-batch-nearest-size",
+         value<int>(&max_locations_batch_nearest)->default_value(10000),
+         "Max. locations supported in batch nearest query") //
+        ("max-batch-threads",
+         value<int>(&max_batch_threads)->default_value(-1),
+         "Max. threads shared by all batch route and batch nearest queries (-1 or 0 for one per "
+         "core)") //
+        ("result-cache-size",
+         value<int>(&result_cache_size)->default_value(0),
+         "Megabytes of memory for caching route and table search results each (0 disables the "
+         "cache)") //
+        ("snapping-cache-size",
+         value<int>(&snapping_cache_size)->default_value(0),
+         "Megabytes of memory for caching snapped coordinates (0 disables the cache)");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -151,6 +226,39 @@ inline unsigned generateServerProgramOptions(const int argc,
 
     boost::program_options::notify(option_variables);
 
+    if (requested_num_threads < 1 || io_threads < 1 || max_queue_size < 1)
+    {
+        util::Log(logERROR) << "Threads, I/O threads and queue size need to be at least 1";
+        return INIT_FAILED;
+    }
+
+    if (keepalive_timeout < 1 || keepalive_max_requests < 1)
+    {
+        util::Log(logERROR) << "Keep-alive timeout and requests need to be at least 1";
+        return INIT_FAILED;
+    }
+
+    if (compression_threads < 1 || compression_level < 1 || compression_level > 9 ||
+        compression_min_size < 0)
+    {
+        util::Log(logERROR) << "Compression needs at least 1 thread, a level from 1 to 9 and a "
+                               "non-negative minimum size";
+        return INIT_FAILED;
+    }
+
+    if (result_cache_size < 0 || snapping_cache_size < 0)
+    {
+        util::Log(logERROR) << "Result and snapping cache sizes need to be non-negative";
+        return INIT_FAILED;
+    }
+
+    if (log_buffer_size < 0 || access_log_sample_rate < 1)
+    {
+        util::Log(logERROR) << "Log buffer size needs to be non-negative and the access log "
+                               "sample rate at least 1";
+        return INIT_FAILED;
+    }
+
     if (!use_shared_memory && option_variables.count("base"))
     {
         return INIT_OK_START_ENGINE;
@@ -173,8 +281,12 @@ int main(int argc, const char *argv[]) try
     util::LogPolicy::GetInstance().Unmute();
 
     bool trial_run = false;
+    bool load_rtree_leaves = false;
     std::string ip_address;
-    int ip_port, requested_thread_num;
+    int ip_port, requested_thread_num, io_threads, max_queue_size;
+    int keepalive_timeout, keepalive_max_requests;
+    int compression_threads, compression_level, compression_min_size;
+    int log_buffer_size, access_log_sample_rate;
 
     EngineConfig config;
     boost::filesystem::path base_path;
@@ -184,13 +296,31 @@ int main(int argc, const char *argv[]) try
                                                               ip_address,
                                                               ip_port,
                                                               requested_thread_num,
+                                                              io_threads,
+                                                              max_queue_size,
+                                                              keepalive_timeout,
+                                                              keepalive_max_requests,
+                                                              compression_threads,
+                                                              compression_level,
+                                                              compression_min_size,
+                                                              log_buffer_size,
+                                                              access_log_sample_rate,
                                                               config.use_shared_memory,
+                                                              load_rtree_leaves,
+                                                              config.warm_up,
                                                               trial_run,
                                                               config.max_locations_trip,
                                                               config.max_locations_viaroute,
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
-                                                              config.max_results_nearest);
+                                                              config.max_results_nearest,
+                                                              config.max_table_threads,
+                                                              config.max_duration_isochrone,
+                                                              config.max_pairs_batch_route,
+                                                              config.max_locations_batch_nearest,
+                                                              config.max_batch_threads,
+                                                              config.result_cache_size,
+                                                              config.snapping_cache_size);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -202,6 +332,7 @@ int main(int argc, const char *argv[]) try
     if (!base_path.empty())
     {
         config.storage_config = storage::StorageConfig(base_path);
+        config.storage_config.load_rtree_leaves = load_rtree_leaves;
     }
     if (!config.IsValid())
     {
@@ -272,9 +403,38 @@ int main(int argc, const char *argv[]) try
         util::Log() << "Loading from shared memory";
     }
 
-    util::Log() << "Threads: " << requested_thread_num;
+    util::Log() << "Threads: " << requested_thread_num << ", I/O threads: " << io_threads
+                << ", queued requests per service: " << max_queue_size;
+    if (config.max_table_threads > 0)
+    {
+        util::Log() << "Table threads: " << config.max_table_threads;
+    }
+    if (config.max_batch_threads > 0)
+    {
+        util::Log() << "Batch threads: " << config.max_batch_threads;
+    }
+    if (config.result_cache_size > 0)
+    {
+        util::Log() << "Result cache: " << config.result_cache_size << " MB per service";
+    }
+    if (config.snapping_cache_size > 0)
+    {
+        util::Log() << "Snapping cache: " << config.snapping_cache_size << " MB";
+    }
+    if (config.warm_up)
+    {
+        util::Log() << "Warming up r-tree leaves of new datasets";
+    }
     util::Log() << "IP address: " << ip_address;
     util::Log() << "IP port: " << ip_port;
+    util::Log() << "Keep-alive: " << keepalive_timeout << "s, " << keepalive_max_requests
+                << " requests";
+    util::Log() << "Compression: " << compression_threads << " threads, level "
+                << compression_level << ", responses from " << compression_min_size << " bytes";
+    if (access_log_sample_rate > 1)
+    {
+        util::Log() << "Access log: every " << access_log_sample_rate << ". request";
+    }
 
 #ifndef _WIN32
     int sig = 0;
@@ -284,7 +444,24 @@ int main(int argc, const char *argv[]) try
     pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 #endif
 
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    // started after blocking the signals, so its writer thread does not receive them
+    std::unique_ptr<util::AsyncLog> async_log;
+    if (log_buffer_size > 0)
+    {
+        async_log = std::make_unique<util::AsyncLog>(log_buffer_size);
+    }
+
+    auto routing_server = server::Server::CreateServer(ip_address,
+                                                       ip_port,
+                                                       requested_thread_num,
+                                                       io_threads,
+                                                       max_queue_size,
+                                                       keepalive_timeout,
+                                                       keepalive_max_requests,
+                                                       compression_threads,
+                                                       compression_level,
+                                                       compression_min_size);
+    routing_server->SetAccessLogSampleRate(access_log_sample_rate);
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
@@ -343,6 +520,7 @@ int main(int argc, const char *argv[]) try
     util::Log() << "freeing objects";
     routing_server.reset();
     util::Log() << "shutdown completed";
+    async_log.reset();
 }
 catch (const std::bad_alloc &e)
 {
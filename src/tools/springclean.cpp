@@ -25,6 +25,10 @@ void deleteRegion(const SharedDataType region)
                 return "REGION_1";
             case REGION_2:
                 return "REGION_2";
+            case WEIGHTS_REGION_1:
+                return "WEIGHTS_REGION_1";
+            case WEIGHTS_REGION_2:
+                return "WEIGHTS_REGION_2";
             default: // REGION_NONE:
                 return "REGION_NONE";
             }
@@ -40,6 +44,8 @@ void springclean()
     util::Log() << "spring-cleaning all shared memory regions";
     deleteRegion(REGION_1);
     deleteRegion(REGION_2);
+    deleteRegion(WEIGHTS_REGION_1);
+    deleteRegion(WEIGHTS_REGION_2);
     deleteRegion(CURRENT_REGION);
 }
 }
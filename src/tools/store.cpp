@@ -17,7 +17,9 @@ using namespace osrm;
 bool generateDataStoreOptions(const int argc,
                               const char *argv[],
                               boost::filesystem::path &base_path,
-                              int &max_wait)
+                              int &max_wait,
+                              bool &load_rtree_leaves,
+                              bool &update_weights)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -29,7 +31,18 @@ bool generateDataStoreOptions(const int argc,
     config_options.add_options()(
         "max-wait",
         boost::program_options::value<int>(&max_wait)->default_value(-1),
-        "Maximum number of seconds to wait on requests that use the old dataset.");
+        "Maximum number of seconds to wait on requests that use the old dataset.")(
+        "load-rtree-leaves",
+        boost::program_options::value<bool>(&load_rtree_leaves)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Load the r-tree leaves into shared memory instead of mapping them from disk.")(
+        "update-weights",
+        boost::program_options::value<bool>(&update_weights)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Only load the files written by osrm-contract and share everything else with the "
+        "dataset that is currently loaded.");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -109,11 +122,16 @@ int main(const int argc, const char *argv[]) try
 
     boost::filesystem::path base_path;
     int max_wait = -1;
-    if (!generateDataStoreOptions(argc, argv, base_path, max_wait))
+    bool load_rtree_leaves = false;
+    bool update_weights = false;
+    if (!generateDataStoreOptions(
+            argc, argv, base_path, max_wait, load_rtree_leaves, update_weights))
     {
         return EXIT_SUCCESS;
     }
     storage::StorageConfig config(base_path);
+    config.load_rtree_leaves = load_rtree_leaves;
+    config.update_weights = update_weights;
     if (!config.IsValid())
     {
         util::Log(logERROR) << "Config contains invalid file paths. Exiting!";
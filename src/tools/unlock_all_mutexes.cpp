@@ -11,6 +11,8 @@ int main()
     osrm::storage::SharedBarriers::resetCurrentRegion();
     osrm::storage::SharedBarriers::resetRegion1();
     osrm::storage::SharedBarriers::resetRegion2();
+    osrm::storage::SharedBarriers::resetWeightsRegion1();
+    osrm::storage::SharedBarriers::resetWeightsRegion2();
 
     return 0;
 }
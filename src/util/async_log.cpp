@@ -0,0 +1,182 @@
+#include "util/async_log.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+namespace osrm
+{
+namespace util
+{
+
+namespace
+{
+std::atomic<AsyncLog *> current_log{nullptr};
+// distinguishes instances, a new instance may be allocated at the address of an old one
+std::atomic<std::uint64_t> next_generation{0};
+
+const constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(10);
+
+std::size_t roundUpToPowerOfTwo(const std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+}
+
+// Single producer, single consumer queue of log lines. The logging thread only moves head,
+// the writer thread only moves tail, so neither side needs a lock.
+class AsyncLog::RingBuffer
+{
+  public:
+    explicit RingBuffer(const std::size_t capacity) : entries(capacity), head(0), tail(0)
+    {
+        BOOST_ASSERT((capacity & (capacity - 1)) == 0);
+    }
+
+    bool Push(const LogLevel level, std::string &line)
+    {
+        const auto current_head = head.load(std::memory_order_relaxed);
+        if (current_head - tail.load(std::memory_order_acquire) == entries.size())
+        {
+            return false;
+        }
+        auto &entry = entries[current_head & (entries.size() - 1)];
+        entry.level = level;
+        entry.line = std::move(line);
+        head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Writer> void Drain(Writer &&write)
+    {
+        const auto current_tail = tail.load(std::memory_order_relaxed);
+        const auto current_head = head.load(std::memory_order_acquire);
+        for (auto index = current_tail; index != current_head; ++index)
+        {
+            auto &entry = entries[index & (entries.size() - 1)];
+            write(entry.level, entry.line);
+            entry.line.clear();
+        }
+        tail.store(current_head, std::memory_order_release);
+    }
+
+    bool Empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Entry
+    {
+        LogLevel level;
+        std::string line;
+    };
+
+    std::vector<Entry> entries;
+    std::atomic<std::size_t> head;
+    std::atomic<std::size_t> tail;
+};
+
+AsyncLog::AsyncLog(const std::size_t capacity)
+    : capacity(roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2))),
+      generation(++next_generation), dropped(0), reported_dropped(0), stopping(false)
+{
+    AsyncLog *expected = nullptr;
+    const auto installed = current_log.compare_exchange_strong(expected, this);
+    BOOST_ASSERT_MSG(installed, "only one AsyncLog may exist at a time");
+    (void)installed;
+
+    writer = std::thread([this] { Run(); });
+}
+
+AsyncLog::~AsyncLog()
+{
+    current_log.store(nullptr);
+    stopping = true;
+    writer.join();
+}
+
+AsyncLog *AsyncLog::Current() { return current_log.load(std::memory_order_acquire); }
+
+bool AsyncLog::Push(const LogLevel level, std::string line)
+{
+    if (!GetThreadBuffer().Push(level, line))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t AsyncLog::Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+AsyncLog::RingBuffer &AsyncLog::GetThreadBuffer()
+{
+    // the writer frees the buffer once the thread exited and the buffer is drained
+    thread_local std::uint64_t buffer_generation = 0;
+    thread_local std::shared_ptr<RingBuffer> buffer;
+
+    if (buffer_generation != generation)
+    {
+        buffer = std::make_shared<RingBuffer>(capacity);
+        buffer_generation = generation;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void AsyncLog::Run()
+{
+    while (!stopping)
+    {
+        Drain();
+        std::this_thread::sleep_for(DRAIN_INTERVAL);
+    }
+    Drain();
+}
+
+void AsyncLog::Drain()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto iter = buffers.begin(); iter != buffers.end();)
+    {
+        (*iter)->Drain([](const LogLevel level, const std::string &line) {
+            auto &output = (level == logWARNING || level == logERROR) ? std::cerr : std::cout;
+            output << line << '\n';
+        });
+
+        // only we hold the buffer if its thread exited
+        if ((*iter).use_count() == 1 && (*iter)->Empty())
+        {
+            iter = buffers.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    const auto current_dropped = Dropped();
+    if (current_dropped != reported_dropped)
+    {
+        std::cerr << "[warn] dropped " << (current_dropped - reported_dropped)
+                  << " log lines, the log buffers were full\n";
+        reported_dropped = current_dropped;
+    }
+
+    std::cout.flush();
+    std::cerr.flush();
+}
+}
+}
@@ -1,4 +1,5 @@
 #include "util/log.hpp"
+#include "util/async_log.hpp"
 #include "util/isatty.hpp"
 #include <cstdio>
 #include <iostream>
@@ -38,7 +39,12 @@ LogPolicy &LogPolicy::GetInstance()
 Log::Log(LogLevel level_, std::ostream &ostream) : level(level_), stream(ostream)
 {
     const bool is_terminal = IsStdoutATTY();
-    std::lock_guard<std::mutex> lock(get_mutex());
+    // only unbuffered logs write to the shared stream right away
+    std::unique_lock<std::mutex> lock(get_mutex(), std::defer_lock);
+    if (&stream != &buffer)
+    {
+        lock.lock();
+    }
     switch (level)
     {
     case logWARNING:
@@ -71,15 +77,31 @@ std::mutex &Log::get_mutex()
  * This destructor is responsible for flushing any buffered data,
  * and printing a newline character (each logger object is responsible for only one line)
  * Because sub-classes can replace the `stream` object - we need to verify whether
- * we're writing to std::cerr/cout, or whether we should write to the stream
+ * we're writing to std::cerr/cout, or whether we should write to the stream.
+ * Buffered lines are handed to the background writer if an AsyncLog is active.
  */
 Log::~Log()
 {
-    std::lock_guard<std::mutex> lock(get_mutex());
     const bool usestd = (&stream == &buffer);
     if (!LogPolicy::GetInstance().IsMute())
     {
         const bool is_terminal = IsStdoutATTY();
+        auto *async_log = AsyncLog::Current();
+#ifdef NDEBUG
+        const bool is_written = level != logDEBUG;
+#else
+        const bool is_written = true;
+#endif
+        if (usestd && async_log)
+        {
+            if (is_written)
+            {
+                async_log->Push(level, buffer.str() + (is_terminal ? COL_RESET : ""));
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(get_mutex());
         if (usestd)
         {
             switch (level)
@@ -0,0 +1,283 @@
+#include "util/metrics.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/latency_histogram.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace osrm
+{
+namespace util
+{
+namespace metrics
+{
+
+namespace
+{
+const constexpr std::size_t NUM_STAGES = static_cast<std::size_t>(Stage::NUM_STAGES);
+const char *const STAGE_NAMES[NUM_STAGES] = {"request",
+                                             "parse_url",
+                                             "snapping",
+                                             "search",
+                                             "unpacking",
+                                             "guidance",
+                                             "render",
+                                             "compression"};
+const constexpr std::size_t NUM_COUNTERS = static_cast<std::size_t>(Counter::NUM_COUNTERS);
+const char *const COUNTER_NAMES[NUM_COUNTERS] = {"osrm_snapping_cache_hits_total",
+                                                 "osrm_snapping_cache_misses_total",
+                                                 "osrm_table_sweeps_total"};
+const char *const COUNTER_HELP[NUM_COUNTERS] = {
+    "Phantom node lookups answered from the snapping cache.",
+    "Phantom node lookups that queried the r-tree because the snapping cache missed.",
+    "Table requests computed with one downward sweep per source."};
+// bucket bounds exported to Prometheus, the powers of two from 16us to about 67s
+const constexpr std::uint64_t MIN_EXPORTED_BOUND = 1 << 4;
+const constexpr std::uint64_t MAX_EXPORTED_BOUND = 1 << 26;
+
+using ServiceHistograms = std::array<LatencyHistogram, NUM_STAGES>;
+
+// Histograms recorded by one thread, the histograms of a service are allocated on first use.
+// They are never freed while the process runs so they can be read after the thread exited.
+struct ThreadHistograms
+{
+    ThreadHistograms()
+    {
+        for (auto &service : services)
+        {
+            service.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~ThreadHistograms()
+    {
+        for (auto &service : services)
+        {
+            delete service.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::array<std::atomic<ServiceHistograms *>, MAX_SERVICES> services;
+};
+
+struct Registry
+{
+    // guards registering services and threads, recording never takes it
+    std::mutex mutex;
+    std::array<std::string, MAX_SERVICES> names;
+    std::atomic<std::size_t> num_services{0};
+    std::vector<std::unique_ptr<ThreadHistograms>> threads;
+    std::array<std::atomic<std::uint64_t>, NUM_COUNTERS> counters{};
+};
+
+Registry &GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+thread_local ThreadHistograms *thread_histograms = nullptr;
+thread_local ServiceID current_service = INVALID_SERVICE;
+
+ServiceHistograms &GetHistograms(const ServiceID service)
+{
+    if (!thread_histograms)
+    {
+        auto &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(std::make_unique<ThreadHistograms>());
+        thread_histograms = registry.threads.back().get();
+    }
+
+    auto &slot = thread_histograms->services[service];
+    auto *histograms = slot.load(std::memory_order_relaxed);
+    if (!histograms)
+    {
+        histograms = new ServiceHistograms();
+        // pairs with the acquire in Render, which must see the initialized histograms
+        slot.store(histograms, std::memory_order_release);
+    }
+    return *histograms;
+}
+
+void append(std::vector<char> &output, const std::string &text)
+{
+    output.insert(output.end(), text.begin(), text.end());
+}
+
+// formats microseconds as seconds without a round trip through floating point
+std::string toSeconds(const std::uint64_t microseconds)
+{
+    const auto fraction = std::to_string(microseconds % 1000000);
+    return std::to_string(microseconds / 1000000) + "." + std::string(6 - fraction.size(), '0') +
+           fraction;
+}
+}
+
+ServiceID RegisterService(const std::string &name)
+{
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    const auto num_services = registry.num_services.load(std::memory_order_relaxed);
+    const auto names_end = registry.names.begin() + num_services;
+    const auto existing = std::find(registry.names.begin(), names_end, name);
+    if (existing != names_end)
+    {
+        return static_cast<ServiceID>(existing - registry.names.begin());
+    }
+
+    if (num_services == MAX_SERVICES)
+    {
+        throw util::exception("Too many services registered for metrics" + SOURCE_REF);
+    }
+    registry.names[num_services] = name;
+    registry.num_services.store(num_services + 1, std::memory_order_release);
+    return static_cast<ServiceID>(num_services);
+}
+
+ServiceID FindService(const std::string &name)
+{
+    const auto &registry = GetRegistry();
+    const auto num_services = registry.num_services.load(std::memory_order_acquire);
+    for (std::size_t service = 0; service < num_services; ++service)
+    {
+        if (registry.names[service] == name)
+        {
+            return static_cast<ServiceID>(service);
+        }
+    }
+    return INVALID_SERVICE;
+}
+
+void Record(const ServiceID service,
+            const Stage stage,
+            const std::chrono::steady_clock::duration duration)
+{
+    if (service == INVALID_SERVICE)
+    {
+        return;
+    }
+    BOOST_ASSERT(service < MAX_SERVICES);
+    BOOST_ASSERT(stage < Stage::NUM_STAGES);
+
+    const auto microseconds =
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    GetHistograms(service)[static_cast<std::size_t>(stage)].Record(
+        static_cast<std::uint64_t>(std::max<decltype(microseconds)>(0, microseconds)));
+}
+
+void Increment(const Counter counter, const std::uint64_t value)
+{
+    BOOST_ASSERT(counter < Counter::NUM_COUNTERS);
+    GetRegistry().counters[static_cast<std::size_t>(counter)].fetch_add(
+        value, std::memory_order_relaxed);
+}
+
+std::uint64_t Get(const Counter counter)
+{
+    BOOST_ASSERT(counter < Counter::NUM_COUNTERS);
+    return GetRegistry().counters[static_cast<std::size_t>(counter)].load(
+        std::memory_order_relaxed);
+}
+
+ServiceID CurrentService() { return current_service; }
+
+ScopedService::ScopedService(const ServiceID service) : previous(current_service)
+{
+    current_service = service;
+}
+
+ScopedService::~ScopedService() { current_service = previous; }
+
+void Render(std::vector<char> &output)
+{
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    append(output,
+           "# HELP osrm_stage_duration_seconds Time spent in each stage of a request.\n"
+           "# TYPE osrm_stage_duration_seconds histogram\n");
+
+    const auto num_services = registry.num_services.load(std::memory_order_relaxed);
+    for (std::size_t service = 0; service < num_services; ++service)
+    {
+        for (std::size_t stage = 0; stage < NUM_STAGES; ++stage)
+        {
+            // merge the histograms of all threads
+            std::array<std::uint64_t, LatencyHistogram::NUM_BUCKETS> counts{};
+            std::uint64_t sum = 0;
+            for (const auto &thread : registry.threads)
+            {
+                const auto *histograms =
+                    thread->services[service].load(std::memory_order_acquire);
+                if (!histograms)
+                {
+                    continue;
+                }
+                const auto &histogram = (*histograms)[stage];
+                for (std::size_t bucket = 0; bucket < counts.size(); ++bucket)
+                {
+                    counts[bucket] += histogram.Count(bucket);
+                }
+                sum += histogram.Sum();
+            }
+
+            std::uint64_t total = 0;
+            for (const auto count : counts)
+            {
+                total += count;
+            }
+            if (total == 0)
+            {
+                continue;
+            }
+
+            const std::string labels =
+                "service=\"" + registry.names[service] + "\",stage=\"" + STAGE_NAMES[stage] + "\"";
+
+            // the exported bounds coincide with bucket bounds, so the cumulative counts are exact
+            std::uint64_t cumulative = 0;
+            for (std::size_t bucket = 0; bucket < counts.size(); ++bucket)
+            {
+                cumulative += counts[bucket];
+                const auto bound = LatencyHistogram::BucketUpperBound(bucket);
+                const bool is_power_of_two = (bound & (bound - 1)) == 0;
+                if (is_power_of_two && bound >= MIN_EXPORTED_BOUND && bound <= MAX_EXPORTED_BOUND)
+                {
+                    append(output,
+                           "osrm_stage_duration_seconds_bucket{" + labels + ",le=\"" +
+                               toSeconds(bound) + "\"} " + std::to_string(cumulative) + "\n");
+                }
+            }
+            append(output,
+                   "osrm_stage_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} " +
+                       std::to_string(total) + "\n");
+            append(output,
+                   "osrm_stage_duration_seconds_sum{" + labels + "} " + toSeconds(sum) + "\n");
+            append(output,
+                   "osrm_stage_duration_seconds_count{" + labels + "} " + std::to_string(total) +
+                       "\n");
+        }
+    }
+
+    for (std::size_t counter = 0; counter < NUM_COUNTERS; ++counter)
+    {
+        const std::string name = COUNTER_NAMES[counter];
+        append(output,
+               "# HELP " + name + " " + COUNTER_HELP[counter] + "\n# TYPE " + name +
+                   " counter\n" + name + " " +
+                   std::to_string(registry.counters[counter].load(std::memory_order_relaxed)) +
+                   "\n");
+    }
+}
+}
+}
+}
@@ -0,0 +1,144 @@
+#include "contractor/graph_customizer.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/exception.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(graph_customizer)
+
+using namespace osrm;
+using namespace osrm::contractor;
+using EdgeBasedEdge = extractor::EdgeBasedEdge;
+
+namespace
+{
+
+inline QueryEdge MakeEdge(const NodeID source,
+                          const NodeID target,
+                          const NodeID id,
+                          const EdgeWeight weight,
+                          const bool shortcut,
+                          const bool forward,
+                          const bool backward)
+{
+    QueryEdge edge;
+    edge.source = source;
+    edge.target = target;
+    edge.data.id = id;
+    edge.data.weight = weight;
+    edge.data.shortcut = shortcut;
+    edge.data.forward = forward;
+    edge.data.backward = backward;
+    return edge;
+}
+
+inline std::vector<QueryEdge> Customize(const NodeID number_of_nodes,
+                                        const std::vector<QueryEdge> &hierarchy,
+                                        const std::vector<EdgeBasedEdge> &graph)
+{
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    for (const auto &edge : hierarchy)
+    {
+        contracted_edges.push_back(edge);
+    }
+    util::DeallocatingVector<EdgeBasedEdge> edge_based_edges;
+    for (const auto &edge : graph)
+    {
+        edge_based_edges.push_back(edge);
+    }
+
+    GraphCustomizer customizer(number_of_nodes, contracted_edges);
+    customizer.Run(edge_based_edges);
+    customizer.GetEdges(contracted_edges);
+
+    return std::vector<QueryEdge>(contracted_edges.begin(), contracted_edges.end());
+}
+
+// 0---1---2 with node 1 contracted first
+inline std::vector<QueryEdge> MakePathHierarchy()
+{
+    return {MakeEdge(1, 0, 0, 2, false, true, true),
+            MakeEdge(1, 2, 1, 3, false, true, true),
+            MakeEdge(0, 2, 1, 5, true, true, true)};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(shortcut_reweighting)
+{
+    // the shortcut over 1 gets the new weights, a new direct edge 0 -> 2 beats it
+    const auto edges = Customize(3,
+                                 MakePathHierarchy(),
+                                 {{0, 1, 0, 4, true, true},
+                                  {1, 2, 1, 3, true, true},
+                                  {0, 2, 2, 6, true, false}});
+
+    const std::vector<QueryEdge> reference = {MakeEdge(0, 2, 1, 7, true, false, true),
+                                              MakeEdge(0, 2, 2, 6, false, true, false),
+                                              MakeEdge(1, 0, 0, 4, false, true, true),
+                                              MakeEdge(1, 2, 1, 3, false, true, true)};
+
+    BOOST_REQUIRE_EQUAL(edges.size(), reference.size());
+    for (std::size_t index = 0; index < reference.size(); ++index)
+    {
+        BOOST_CHECK(edges[index] == reference[index]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(unreachable_edges_are_dropped)
+{
+    // 1 -> 2 vanished from the graph, e.g. because of a zero speed
+    const auto edges = Customize(3, MakePathHierarchy(), {{0, 1, 0, 2, true, true}});
+
+    BOOST_REQUIRE_EQUAL(edges.size(), 1);
+    BOOST_CHECK(edges[0] == MakeEdge(1, 0, 0, 2, false, true, true));
+}
+
+BOOST_AUTO_TEST_CASE(loop_shortcut)
+{
+    // the loop at 0 allows turning around over the lower node 1
+    const std::vector<QueryEdge> hierarchy = {MakeEdge(1, 0, 0, 2, false, false, true),
+                                              MakeEdge(1, 0, 1, 3, false, true, false),
+                                              MakeEdge(0, 0, 1, 5, true, true, true)};
+
+    const auto edges =
+        Customize(2, hierarchy, {{0, 1, 0, 7, true, false}, {1, 0, 1, 1, true, false}});
+
+    const std::vector<QueryEdge> reference = {MakeEdge(0, 0, 1, 8, true, true, true),
+                                              MakeEdge(1, 0, 0, 7, false, false, true),
+                                              MakeEdge(1, 0, 1, 1, false, true, false)};
+
+    BOOST_REQUIRE_EQUAL(edges.size(), reference.size());
+    for (std::size_t index = 0; index < reference.size(); ++index)
+    {
+        BOOST_CHECK(edges[index] == reference[index]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rounds_follow_hierarchy)
+{
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    for (const auto &edge : MakePathHierarchy())
+    {
+        contracted_edges.push_back(edge);
+    }
+
+    // 1, then 0 and then 2 since the shortcut is stored at 0
+    GraphCustomizer customizer(3, contracted_edges);
+    BOOST_CHECK_EQUAL(customizer.NumberOfRounds(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(cycle_is_rejected)
+{
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    contracted_edges.push_back(MakeEdge(0, 1, 0, 1, false, true, false));
+    contracted_edges.push_back(MakeEdge(1, 0, 1, 1, false, true, false));
+
+    BOOST_CHECK_THROW(GraphCustomizer(2, contracted_edges), util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
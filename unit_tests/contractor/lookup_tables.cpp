@@ -0,0 +1,176 @@
+#include "contractor/lookup_tables.hpp"
+#include "util/exception.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(lookup_tables)
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+
+// Removes the files again when going out of scope
+struct TemporaryFiles
+{
+    ~TemporaryFiles()
+    {
+        for (const auto &filename : filenames)
+        {
+            boost::filesystem::remove(filename);
+        }
+    }
+
+    const std::string &Add(const std::string &content)
+    {
+        filenames.push_back(boost::filesystem::unique_path().string());
+        std::ofstream file(filenames.back(), std::ios::binary);
+        file << content;
+        return filenames.back();
+    }
+
+    const std::string &AddBinarySpeeds(const std::string &content)
+    {
+        TemporaryFiles csv;
+        const auto lookup = parse_segment_lookup_from_csv_files({csv.Add(content)});
+        filenames.push_back(boost::filesystem::unique_path().string());
+        writeSegmentSpeedFile(filenames.back(), lookup);
+        return filenames.back();
+    }
+
+    std::vector<std::string> filenames;
+};
+
+inline SpeedSource Speed(const SegmentSpeedSourceFlatMap &lookup,
+                         const std::uint64_t from,
+                         const std::uint64_t to)
+{
+    const auto it = find(lookup, SegmentSpeedSource{{OSMNodeID{from}, OSMNodeID{to}}, {0, 0}});
+    BOOST_REQUIRE(it != lookup.end());
+    return it->speed_source;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(later_files_take_precedence)
+{
+    TemporaryFiles files;
+    files.Add("1,2,10\n2,3,20\n");
+    files.Add("2,3,30,comment\n3,4,40");
+
+    const auto lookup = parse_segment_lookup_from_csv_files(files.filenames);
+
+    BOOST_REQUIRE_EQUAL(lookup.size(), 3);
+    BOOST_CHECK_EQUAL(Speed(lookup, 1, 2).speed, 10);
+    BOOST_CHECK_EQUAL(Speed(lookup, 1, 2).source, 1);
+    BOOST_CHECK_EQUAL(Speed(lookup, 2, 3).speed, 30);
+    BOOST_CHECK_EQUAL(Speed(lookup, 2, 3).source, 2);
+    BOOST_CHECK_EQUAL(Speed(lookup, 3, 4).speed, 40);
+}
+
+BOOST_AUTO_TEST_CASE(first_line_wins_across_chunks)
+{
+    // large enough to be split into several chunks
+    std::string content = "7,8,1\n";
+    for (std::uint64_t node = 100; node < 500000; ++node)
+    {
+        content += std::to_string(node) + "," + std::to_string(node + 1) + ",50\n";
+    }
+    content += "7,8,2\n";
+
+    TemporaryFiles files;
+    files.Add(content);
+    files.Add("");
+
+    const auto lookup = parse_segment_lookup_from_csv_files(files.filenames);
+
+    BOOST_REQUIRE_EQUAL(lookup.size(), 500000 - 100 + 1);
+    BOOST_CHECK_EQUAL(Speed(lookup, 7, 8).speed, 1);
+    BOOST_CHECK_EQUAL(Speed(lookup, 499999, 500000).speed, 50);
+}
+
+BOOST_AUTO_TEST_CASE(turn_penalties)
+{
+    TemporaryFiles files;
+    files.Add("1,2,3,1.5\n1,2,3,2.5\n3,2,1,-0.5\n");
+
+    const auto lookup = parse_turn_penalty_lookup_from_csv_files(files.filenames);
+
+    BOOST_REQUIRE_EQUAL(lookup.size(), 2);
+    const auto it = find(
+        lookup, TurnPenaltySource{{OSMNodeID{1}, OSMNodeID{2}, OSMNodeID{3}}, {0., 0}});
+    BOOST_REQUIRE(it != lookup.end());
+    BOOST_CHECK_EQUAL(it->penalty_source.penalty, 1.5);
+    BOOST_CHECK_EQUAL(it->penalty_source.source, 1);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_line)
+{
+    TemporaryFiles files;
+    files.Add("1,2,10\n2,3,20\n3,4\n");
+
+    try
+    {
+        parse_segment_lookup_from_csv_files(files.filenames);
+        BOOST_FAIL("malformed file was accepted");
+    }
+    catch (const util::exception &e)
+    {
+        const std::string message = e.what();
+        BOOST_CHECK(message.find("malformed on line 3") != std::string::npos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(binary_segment_speeds)
+{
+    TemporaryFiles files;
+    files.Add("1,2,10\n2,3,20\n");
+    files.AddBinarySpeeds("5,6,50\n2,3,30\n1,2,40\n");
+    files.Add("1,2,60\n");
+
+    BOOST_CHECK(!isBinaryUpdateFile(files.filenames[0]));
+    BOOST_CHECK(isBinaryUpdateFile(files.filenames[1]));
+
+    const SegmentSpeedLookup lookup(files.filenames);
+
+    // the binary file beats the first but not the last CSV file
+    BOOST_REQUIRE(lookup.Find(OSMNodeID{1}, OSMNodeID{2}));
+    BOOST_CHECK_EQUAL(lookup.Find(OSMNodeID{1}, OSMNodeID{2})->speed, 60);
+    BOOST_CHECK_EQUAL(lookup.Find(OSMNodeID{1}, OSMNodeID{2})->source, 3);
+    BOOST_REQUIRE(lookup.Find(OSMNodeID{2}, OSMNodeID{3}));
+    BOOST_CHECK_EQUAL(lookup.Find(OSMNodeID{2}, OSMNodeID{3})->speed, 30);
+    BOOST_CHECK_EQUAL(lookup.Find(OSMNodeID{2}, OSMNodeID{3})->source, 2);
+    BOOST_REQUIRE(lookup.Find(OSMNodeID{5}, OSMNodeID{6}));
+    BOOST_CHECK_EQUAL(lookup.Find(OSMNodeID{5}, OSMNodeID{6})->speed, 50);
+    BOOST_CHECK(!lookup.Find(OSMNodeID{6}, OSMNodeID{5}));
+}
+
+BOOST_AUTO_TEST_CASE(binary_turn_penalties)
+{
+    TemporaryFiles csv;
+    const auto parsed =
+        parse_turn_penalty_lookup_from_csv_files({csv.Add("3,2,1,-0.5\n1,2,3,1.5\n")});
+
+    TemporaryFiles files;
+    files.filenames.push_back(boost::filesystem::unique_path().string());
+    writeTurnPenaltyFile(files.filenames.back(), parsed);
+
+    const TurnPenaltyLookup lookup(files.filenames);
+
+    const auto penalty = lookup.Find(OSMNodeID{3}, OSMNodeID{2}, OSMNodeID{1});
+    BOOST_REQUIRE(penalty);
+    BOOST_CHECK_EQUAL(penalty->penalty, -0.5);
+    BOOST_CHECK_EQUAL(penalty->source, 1);
+    BOOST_CHECK(!lookup.Find(OSMNodeID{1}, OSMNodeID{2}, OSMNodeID{4}));
+
+    // a turn penalty file is not a segment speed file
+    BOOST_CHECK_THROW(SegmentSpeedLookup{files.filenames}, util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,30 @@
+#include "engine/plugins/plugin_base.hpp"
+#include "util/exception.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(plugin_base)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+struct TestPlugin : plugins::BasePlugin
+{
+    using plugins::BasePlugin::GetRoutingFacade;
+};
+}
+
+BOOST_AUTO_TEST_CASE(routing_facade_rejects_other_facades_test)
+{
+    const TestPlugin plugin{};
+    const test::MockDataFacade facade{};
+
+    BOOST_CHECK_THROW(plugin.GetRoutingFacade(facade), util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+#include "engine/result_cache.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(result_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+// budget for two entries with single character keys
+const auto TWO_ENTRIES = 2 * ResultCache<int>::EntrySize("a", 0);
+
+BOOST_AUTO_TEST_CASE(lru_eviction_test)
+{
+    ResultCache<int> cache(TWO_ENTRIES);
+    int computed = 0;
+    const auto compute = [&computed] { return ++computed; };
+
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "a", compute), 1);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "b", compute), 2);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "a", compute), 1);
+    // b is the least recently used entry
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "c", compute), 3);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "a", compute), 1);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "b", compute), 4);
+    BOOST_CHECK_EQUAL(computed, 4);
+}
+
+BOOST_AUTO_TEST_CASE(data_version_test)
+{
+    ResultCache<int> cache(TWO_ENTRIES);
+    int computed = 0;
+    const auto compute = [&computed] { return ++computed; };
+
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(1, "a", compute), 1);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(1, "a", compute), 1);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(2, "a", compute), 2);
+    // searches on the previous dataset bypass the cache and do not clear it
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(1, "a", compute), 3);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(2, "a", compute), 2);
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget_test)
+{
+    const std::vector<int> small(10);
+    const std::vector<int> large(1000);
+    ResultCache<std::vector<int>> cache(2 * ResultCache<std::vector<int>>::EntrySize("a", small) +
+                                        ResultCache<std::vector<int>>::EntrySize("a", large) / 2);
+    int computed = 0;
+    const auto compute_small = [&] {
+        ++computed;
+        return small;
+    };
+    const auto compute_large = [&] {
+        ++computed;
+        return large;
+    };
+
+    cache.GetOrCompute(0, "a", compute_small);
+    cache.GetOrCompute(0, "b", compute_small);
+    BOOST_CHECK_EQUAL(computed, 2);
+    // too large for the budget, it is not cached and does not evict anything
+    cache.GetOrCompute(0, "c", compute_large);
+    cache.GetOrCompute(0, "c", compute_large);
+    BOOST_CHECK_EQUAL(computed, 4);
+    cache.GetOrCompute(0, "a", compute_small);
+    cache.GetOrCompute(0, "b", compute_small);
+    BOOST_CHECK_EQUAL(computed, 4);
+}
+
+BOOST_AUTO_TEST_CASE(failed_compute_test)
+{
+    ResultCache<int> cache(TWO_ENTRIES);
+    BOOST_CHECK_THROW(cache.GetOrCompute(0, "a", []() -> int { throw std::runtime_error("x"); }),
+                      std::runtime_error);
+    BOOST_CHECK_EQUAL(*cache.GetOrCompute(0, "a", [] { return 5; }), 5);
+}
+
+BOOST_AUTO_TEST_CASE(coalescing_test)
+{
+    ResultCache<int> cache(TWO_ENTRIES);
+    std::atomic<int> computed{0};
+    std::atomic<bool> release{false};
+
+    const auto compute = [&] {
+        ++computed;
+        while (!release)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return 42;
+    };
+
+    std::vector<std::thread> threads;
+    std::atomic<int> correct{0};
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&] {
+            if (*cache.GetOrCompute(0, "a", compute) == 42)
+            {
+                ++correct;
+            }
+        });
+    }
+    // give all threads the chance to wait for the first computation
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    BOOST_CHECK_EQUAL(computed, 1);
+    BOOST_CHECK_EQUAL(correct, 4);
+}
+
+BOOST_AUTO_TEST_CASE(key_test)
+{
+    PhantomNode phantom;
+    phantom.location = util::Coordinate{util::FloatLongitude{1.}, util::FloatLatitude{2.}};
+    phantom.input_location = phantom.location;
+
+    ResultCacheKey first;
+    first.Add(phantom).Add(std::vector<std::size_t>{1, 2});
+    ResultCacheKey second;
+    second.Add(phantom).Add(std::vector<std::size_t>{1, 2});
+    BOOST_CHECK(first.key == second.key);
+
+    phantom.forward_weight += 1;
+    ResultCacheKey third;
+    third.Add(phantom).Add(std::vector<std::size_t>{1, 2});
+    BOOST_CHECK(first.key != third.key);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
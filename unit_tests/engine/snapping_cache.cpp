@@ -0,0 +1,100 @@
+#include "engine/datafacade/snapping_cache.hpp"
+#include "util/metrics.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(snapping_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::engine::datafacade;
+
+namespace
+{
+SnappingCache::Value makePhantoms(const NodeID id)
+{
+    PhantomNode phantom;
+    phantom.forward_segment_id = {id, true};
+    return std::make_pair(phantom, phantom);
+}
+}
+
+BOOST_AUTO_TEST_CASE(key_options_test)
+{
+    SnappingCache cache(1024 * 1024);
+    NodeID computed = 0;
+    const auto compute = [&computed] { return makePhantoms(++computed); };
+
+    const util::Coordinate coordinate{util::FloatLongitude{7.41}, util::FloatLatitude{43.73}};
+    const util::Coordinate other{util::FloatLongitude{7.42}, util::FloatLatitude{43.73}};
+
+    const auto hits = util::metrics::Get(util::metrics::Counter::SnappingCacheHits);
+    const auto misses = util::metrics::Get(util::metrics::Counter::SnappingCacheMisses);
+
+    BOOST_CHECK_EQUAL(cache.GetOrCompute({coordinate}, compute).first.forward_segment_id.id, 1);
+    BOOST_CHECK_EQUAL(cache.GetOrCompute({coordinate}, compute).first.forward_segment_id.id, 1);
+    BOOST_CHECK_EQUAL(cache.GetOrCompute({other}, compute).first.forward_segment_id.id, 2);
+    BOOST_CHECK_EQUAL(cache.GetOrCompute({coordinate, 10.}, compute).first.forward_segment_id.id,
+                      3);
+    BOOST_CHECK_EQUAL(
+        cache.GetOrCompute({coordinate, 10., 90, 20}, compute).first.forward_segment_id.id, 4);
+    BOOST_CHECK_EQUAL(
+        cache.GetOrCompute({coordinate, -1., 90, 20}, compute).first.forward_segment_id.id, 5);
+    BOOST_CHECK_EQUAL(
+        cache.GetOrCompute({coordinate, 10., 90, 20}, compute).first.forward_segment_id.id, 4);
+    BOOST_CHECK_EQUAL(computed, 5);
+
+    BOOST_CHECK_EQUAL(util::metrics::Get(util::metrics::Counter::SnappingCacheHits) - hits, 2);
+    BOOST_CHECK_EQUAL(util::metrics::Get(util::metrics::Counter::SnappingCacheMisses) - misses,
+                      5);
+}
+
+BOOST_AUTO_TEST_CASE(memory_budget_test)
+{
+    // the smallest cache holds one entry per shard
+    SnappingCache cache(1);
+    BOOST_CHECK_GT(cache.Capacity(), 0);
+    BOOST_CHECK_LT(cache.Capacity(), SnappingCache(1024 * 1024).Capacity());
+
+    NodeID computed = 0;
+    const auto compute = [&computed] { return makePhantoms(++computed); };
+    for (int lon = 0; lon < 1000; ++lon)
+    {
+        cache.GetOrCompute(
+            {util::Coordinate{util::FixedLongitude{lon}, util::FixedLatitude{0}}}, compute);
+    }
+    BOOST_CHECK_EQUAL(computed, 1000);
+
+    // the most recent entry is still cached
+    cache.GetOrCompute({util::Coordinate{util::FixedLongitude{999}, util::FixedLatitude{0}}},
+                       compute);
+    BOOST_CHECK_EQUAL(computed, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test)
+{
+    SnappingCache cache(1024 * 1024);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&cache] {
+            for (int lon = 0; lon < 1000; ++lon)
+            {
+                const auto phantoms = cache.GetOrCompute(
+                    {util::Coordinate{util::FixedLongitude{lon}, util::FixedLatitude{0}}},
+                    [lon] { return makePhantoms(lon); });
+                BOOST_CHECK_EQUAL(phantoms.first.forward_segment_id.id, lon);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "args.hpp"
+#include "coordinates.hpp"
+#include "fixture.hpp"
+
+#include "osrm/batch_nearest_parameters.hpp"
+#include "osrm/nearest_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/json_writer.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(batch_nearest)
+
+BOOST_AUTO_TEST_CASE(test_batch_nearest_matches_nearest)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    const auto locations = get_locations_in_big_component();
+
+    BatchNearestParameters params;
+    params.coordinates = locations;
+    params.number_of_results = 2;
+
+    json::Object result;
+    const auto rc = osrm.BatchNearest(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    // the waypoints are returned in the order of the coordinates, not in the snapping order
+    const auto &waypoints = result.values.at("waypoints").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(waypoints.size(), locations.size());
+
+    for (const auto index : util::irange<std::size_t>(0UL, locations.size()))
+    {
+        NearestParameters nearest_params;
+        nearest_params.coordinates.push_back(locations[index]);
+        nearest_params.number_of_results = 2;
+
+        json::Object nearest_result;
+        BOOST_REQUIRE(osrm.Nearest(nearest_params, nearest_result) == Status::Ok);
+
+        const auto &expected = nearest_result.values.at("waypoints").get<json::Array>().values;
+        const auto &actual = waypoints[index].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (const auto i : util::irange<std::size_t>(0UL, actual.size()))
+        {
+            const auto &expected_waypoint = expected[i].get<json::Object>();
+            const auto &actual_waypoint = actual[i].get<json::Object>();
+            BOOST_CHECK_EQUAL(actual_waypoint.values.at("hint").get<json::String>().value,
+                              expected_waypoint.values.at("hint").get<json::String>().value);
+            BOOST_CHECK_EQUAL(actual_waypoint.values.at("distance").get<json::Number>().value,
+                              expected_waypoint.values.at("distance").get<json::Number>().value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_nearest_no_segment)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    BatchNearestParameters params;
+    // the dataset has no segment within 1km of the coordinate
+    params.coordinates.push_back({util::FloatLongitude{0}, util::FloatLatitude{0}});
+    params.coordinates.push_back(get_dummy_location());
+    params.radiuses = {boost::make_optional(1000.), boost::none};
+
+    json::Object result;
+    const auto rc = osrm.BatchNearest(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    // coordinates without a segment do not fail the request
+    const auto &waypoints = result.values.at("waypoints").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(waypoints.size(), 2);
+    BOOST_CHECK(waypoints[0].get<json::Array>().values.empty());
+    BOOST_CHECK(!waypoints[1].get<json::Array>().values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_nearest_streaming)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    BatchNearestParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.generate_hints = false;
+
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+    const auto rc = osrm.BatchNearest(params, writer);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const std::string streamed(buffer.begin(), buffer.end());
+    BOOST_CHECK_EQUAL(streamed.substr(0, 27), "{\"code\":\"Ok\",\"waypoints\":[[");
+    BOOST_CHECK(streamed.find("\"hint\"") == std::string::npos);
+    BOOST_CHECK(streamed.find("\"distance\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_nearest_limited_threads_matches_unlimited)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_batch_threads = 1;
+
+    OSRM limited_osrm{config};
+
+    // enough coordinates for several tasks of the arena
+    BatchNearestParameters params;
+    for (int repeat = 0; repeat < 100; ++repeat)
+    {
+        for (const auto &location : get_locations_in_big_component())
+        {
+            params.coordinates.push_back(location);
+        }
+    }
+
+    json::Object result;
+    json::Object limited_result;
+
+    const auto rc = osrm.BatchNearest(params, result);
+    const auto limited_rc = limited_osrm.BatchNearest(params, limited_result);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(limited_rc == Status::Ok);
+
+    const auto &waypoints = result.values.at("waypoints").get<json::Array>().values;
+    const auto &limited_waypoints =
+        limited_result.values.at("waypoints").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(waypoints.size(), params.coordinates.size());
+    BOOST_REQUIRE_EQUAL(limited_waypoints.size(), params.coordinates.size());
+    for (const auto index : util::irange<std::size_t>(0UL, waypoints.size()))
+    {
+        const auto &actual = waypoints[index].get<json::Array>().values;
+        const auto &limited = limited_waypoints[index].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(actual.size(), limited.size());
+        for (const auto i : util::irange<std::size_t>(0UL, actual.size()))
+        {
+            BOOST_CHECK_EQUAL(
+                actual[i].get<json::Object>().values.at("hint").get<json::String>().value,
+                limited[i].get<json::Object>().values.at("hint").get<json::String>().value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
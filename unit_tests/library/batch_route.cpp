@@ -0,0 +1,195 @@
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "args.hpp"
+#include "coordinates.hpp"
+#include "fixture.hpp"
+#include "waypoint_check.hpp"
+
+#include "osrm/batch_route_parameters.hpp"
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/json_writer.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include "util/json_renderer.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(batch_route)
+
+BOOST_AUTO_TEST_CASE(test_batch_route_matches_route)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    const auto locations = get_locations_in_big_component();
+
+    BatchRouteParameters params;
+    params.coordinates = locations;
+    params.pairs = {{0, 1}, {1, 2}, {2, 0}, {0, 1}, {1, 1}};
+
+    json::Object result;
+    const auto rc = osrm.BatchRoute(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    // one waypoint per coordinate, no matter how many pairs use it
+    const auto &waypoints = result.values.at("waypoints").get<json::Array>().values;
+    BOOST_CHECK_EQUAL(waypoints.size(), locations.size());
+    for (const auto &waypoint : waypoints)
+    {
+        BOOST_CHECK(waypoint_check(waypoint));
+    }
+
+    const auto &routes = result.values.at("routes").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(routes.size(), params.pairs.size());
+
+    for (std::size_t index = 0; index < params.pairs.size(); ++index)
+    {
+        RouteParameters route_params;
+        route_params.coordinates.push_back(locations[params.pairs[index].first]);
+        route_params.coordinates.push_back(locations[params.pairs[index].second]);
+        route_params.overview = RouteParameters::OverviewType::False;
+
+        json::Object route_result;
+        BOOST_REQUIRE(osrm.Route(route_params, route_result) == Status::Ok);
+        const auto &reference =
+            route_result.values.at("routes").get<json::Array>().values.front().get<json::Object>();
+
+        const auto &route = routes[index].get<json::Object>();
+        BOOST_CHECK_EQUAL(route.values.at("duration").get<json::Number>().value,
+                          reference.values.at("duration").get<json::Number>().value);
+        BOOST_CHECK_EQUAL(route.values.at("distance").get<json::Number>().value,
+                          reference.values.at("distance").get<json::Number>().value);
+        // no geometry by default
+        BOOST_CHECK(route.values.find("geometry") == route.values.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_route_no_route)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    BatchRouteParameters params;
+    params.coordinates.push_back(get_locations_in_big_component().front());
+    params.coordinates.push_back(get_locations_in_small_component().front());
+    params.pairs = {{0, 1}, {0, 0}};
+
+    json::Object result;
+    const auto rc = osrm.BatchRoute(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    // pairs without a route do not fail the request
+    const auto &routes = result.values.at("routes").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(routes.size(), 2);
+    BOOST_CHECK(routes[0].is<json::Null>());
+    BOOST_CHECK(routes[1].is<json::Object>());
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_route_streaming_matches_object)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    BatchRouteParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.pairs = {{0, 1}, {2, 0}};
+    params.overview = RouteParameters::OverviewType::Full;
+
+    json::Object result;
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    const auto rc = osrm.BatchRoute(params, result);
+    const auto streamed_rc = osrm.BatchRoute(params, writer);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(streamed_rc == Status::Ok);
+
+    // the routes are embedded as they are, so the arrays can be compared as text
+    std::vector<char> routes;
+    mapbox::util::apply_visitor(util::json::ArrayRenderer(routes), result.values.at("routes"));
+    const std::string streamed(buffer.begin(), buffer.end());
+    BOOST_CHECK_EQUAL(streamed.substr(0, 13), "{\"code\":\"Ok\"");
+    BOOST_CHECK(streamed.find("\"routes\":" + std::string(routes.begin(), routes.end()) + "}") !=
+                std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_route_limited_threads_matches_unlimited)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_batch_threads = 1;
+
+    OSRM limited_osrm{config};
+
+    const auto locations = get_locations_in_big_component();
+
+    // enough pairs for several tasks of the arena
+    BatchRouteParameters params;
+    params.coordinates = locations;
+    for (std::size_t source = 0; source < locations.size(); ++source)
+    {
+        for (std::size_t destination = 0; destination < locations.size(); ++destination)
+        {
+            for (int repeat = 0; repeat < 4; ++repeat)
+            {
+                params.pairs.push_back({source, destination});
+            }
+        }
+    }
+
+    json::Object result;
+    json::Object limited_result;
+
+    const auto rc = osrm.BatchRoute(params, result);
+    const auto limited_rc = limited_osrm.BatchRoute(params, limited_result);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(limited_rc == Status::Ok);
+
+    const auto &routes = result.values.at("routes").get<json::Array>().values;
+    const auto &limited_routes = limited_result.values.at("routes").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(routes.size(), params.pairs.size());
+    BOOST_REQUIRE_EQUAL(limited_routes.size(), params.pairs.size());
+    for (std::size_t index = 0; index < routes.size(); ++index)
+    {
+        const auto &route = routes[index].get<json::Object>();
+        const auto &limited_route = limited_routes[index].get<json::Object>();
+        BOOST_CHECK_EQUAL(route.values.at("duration").get<json::Number>().value,
+                          limited_route.values.at("duration").get<json::Number>().value);
+        BOOST_CHECK_EQUAL(route.values.at("distance").get<json::Number>().value,
+                          limited_route.values.at("distance").get<json::Number>().value);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "args.hpp"
+#include "coordinates.hpp"
+#include "fixture.hpp"
+
+#include "osrm/isochrone_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+BOOST_AUTO_TEST_SUITE(isochrone)
+
+BOOST_AUTO_TEST_CASE(test_isochrone_polygon)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    IsochroneParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.duration = 300;
+
+    json::Object result;
+    const auto rc = osrm.Isochrone(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    const auto &waypoints = result.values.at("waypoints").get<json::Array>().values;
+    BOOST_CHECK_EQUAL(waypoints.size(), 1);
+
+    const auto &polygon = result.values.at("polygon").get<json::Object>();
+    BOOST_CHECK_EQUAL(polygon.values.at("type").get<json::String>().value, "Polygon");
+    const auto &rings = polygon.values.at("coordinates").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(rings.size(), 1);
+    const auto &ring = rings.front().get<json::Array>().values;
+    // at least a triangle and closed
+    BOOST_REQUIRE(ring.size() >= 4);
+    const auto &first = ring.front().get<json::Array>().values;
+    const auto &last = ring.back().get<json::Array>().values;
+    BOOST_CHECK_EQUAL(first[0].get<json::Number>().value, last[0].get<json::Number>().value);
+    BOOST_CHECK_EQUAL(first[1].get<json::Number>().value, last[1].get<json::Number>().value);
+}
+
+BOOST_AUTO_TEST_CASE(test_isochrone_segments_within_duration)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    IsochroneParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.duration = 120;
+    params.output = IsochroneParameters::OutputType::Segments;
+
+    json::Object result;
+    const auto rc = osrm.Isochrone(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const auto &segments = result.values.at("segments").get<json::Array>().values;
+    BOOST_CHECK(!segments.empty());
+    for (const auto &segment : segments)
+    {
+        const auto &segment_object = segment.get<json::Object>();
+        const auto duration = segment_object.values.at("duration").get<json::Number>().value;
+        BOOST_CHECK(duration >= 0);
+        BOOST_CHECK(duration <= params.duration);
+    }
+
+    // a larger budget reaches at least the same segments
+    params.duration = 600;
+    json::Object larger_result;
+    BOOST_REQUIRE(osrm.Isochrone(params, larger_result) == Status::Ok);
+    const auto &larger_segments = larger_result.values.at("segments").get<json::Array>().values;
+    BOOST_CHECK(larger_segments.size() >= segments.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_isochrone_polygon_single_segment)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    // only reaches a part of the segment the source is snapped to
+    IsochroneParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.duration = 0.1;
+
+    json::Object result;
+    const auto rc = osrm.Isochrone(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const auto &polygon = result.values.at("polygon").get<json::Object>();
+    const auto &rings = polygon.values.at("coordinates").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(rings.size(), 1);
+    const auto &ring = rings.front().get<json::Array>().values;
+    BOOST_REQUIRE(ring.size() >= 4);
+    const auto &first = ring.front().get<json::Array>().values;
+    const auto &last = ring.back().get<json::Array>().values;
+    BOOST_CHECK_EQUAL(first[0].get<json::Number>().value, last[0].get<json::Number>().value);
+    BOOST_CHECK_EQUAL(first[1].get<json::Number>().value, last[1].get<json::Number>().value);
+}
+
+BOOST_AUTO_TEST_CASE(test_isochrone_duration_out_of_range)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    IsochroneParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.duration = 1e12;
+
+    json::Object result;
+    const auto rc = osrm.Isochrone(params, result);
+    BOOST_REQUIRE(rc == Status::Error);
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "InvalidValue");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,9 @@
 
 #include "args.hpp"
 
+#include "osrm/batch_nearest_parameters.hpp"
+#include "osrm/batch_route_parameters.hpp"
+#include "osrm/isochrone_parameters.hpp"
 #include "osrm/match_parameters.hpp"
 #include "osrm/nearest_parameters.hpp"
 #include "osrm/route_parameters.hpp"
@@ -174,4 +177,92 @@ BOOST_AUTO_TEST_CASE(test_nearest_limits)
     BOOST_CHECK(code == "TooBig"); // per the New-Server API spec
 }
 
+BOOST_AUTO_TEST_CASE(test_isochrone_limits)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_duration_isochrone = 60;
+
+    OSRM osrm{config};
+
+    IsochroneParameters params;
+    params.coordinates.emplace_back(getZeroCoordinate());
+    params.duration = 61;
+
+    json::Object result;
+
+    const auto rc = osrm.Isochrone(params, result);
+
+    BOOST_CHECK(rc == Status::Error);
+
+    // Make sure we're not accidentally hitting a guard code path before
+    const auto code = result.values["code"].get<json::String>().value;
+    BOOST_CHECK(code == "TooBig"); // per the New-Server API spec
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_route_limits)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_pairs_batch_route = 2;
+
+    OSRM osrm{config};
+
+    BatchRouteParameters params;
+    params.coordinates.emplace_back(getZeroCoordinate());
+    params.pairs = {{0, 0}, {0, 0}, {0, 0}};
+
+    json::Object result;
+
+    const auto rc = osrm.BatchRoute(params, result);
+
+    BOOST_CHECK(rc == Status::Error);
+
+    // Make sure we're not accidentally hitting a guard code path before
+    const auto code = result.values["code"].get<json::String>().value;
+    BOOST_CHECK(code == "TooBig"); // per the New-Server API spec
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_nearest_limits)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_locations_batch_nearest = 2;
+
+    OSRM osrm{config};
+
+    BatchNearestParameters params;
+    params.coordinates.emplace_back(getZeroCoordinate());
+    params.coordinates.emplace_back(getZeroCoordinate());
+    params.coordinates.emplace_back(getZeroCoordinate());
+
+    json::Object result;
+
+    const auto rc = osrm.BatchNearest(params, result);
+
+    BOOST_CHECK(rc == Status::Error);
+
+    // Make sure we're not accidentally hitting a guard code path before
+    const auto code = result.values["code"].get<json::String>().value;
+    BOOST_CHECK(code == "TooBig"); // per the New-Server API spec
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,14 @@
 #include "osrm/route_parameters.hpp"
 #include "osrm/status.hpp"
 
+#include <protozero/pbf_reader.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(route)
 
 BOOST_AUTO_TEST_CASE(test_route_same_coordinates_fixture)
@@ -382,4 +390,148 @@ BOOST_AUTO_TEST_CASE(test_route_user_disables_generating_hints)
         BOOST_CHECK_EQUAL(waypoint.get<json::Object>().values.count("hint"), 0);
 }
 
+BOOST_AUTO_TEST_CASE(test_route_pbf_matches_json)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    RouteParameters params;
+    params.overview = RouteParameters::OverviewType::Full;
+    params.geometries = RouteParameters::GeometriesType::GeoJSON;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+
+    json::Object json_result;
+    const auto rc = osrm.Route(params, json_result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    std::string pbf_result;
+    const auto pbf_rc = osrm.Route(params, pbf_result);
+    BOOST_CHECK(pbf_rc == Status::Ok);
+
+    const auto &json_route =
+        json_result.values.at("routes").get<json::Array>().values.at(0).get<json::Object>();
+    const auto json_distance = json_route.values.at("distance").get<json::Number>().value;
+    const auto json_duration = json_route.values.at("duration").get<json::Number>().value;
+    const auto &json_geometry = json_route.values.at("geometry");
+    const auto &json_coordinates =
+        json_geometry.get<json::Object>().values.at("coordinates").get<json::Array>().values;
+
+    std::string code;
+    std::size_t number_of_waypoints = 0;
+    std::size_t number_of_routes = 0;
+    protozero::pbf_reader response(pbf_result);
+    while (response.next())
+    {
+        switch (response.tag())
+        {
+        case 1: // code
+            code = response.get_string();
+            break;
+        case 3: // waypoints
+            response.skip();
+            ++number_of_waypoints;
+            break;
+        case 4: // routes
+        {
+            ++number_of_routes;
+            protozero::pbf_reader route = response.get_message();
+            std::size_t number_of_legs = 0;
+            while (route.next())
+            {
+                switch (route.tag())
+                {
+                case 1: // distance
+                    BOOST_CHECK_EQUAL(route.get_double(), json_distance);
+                    break;
+                case 2: // duration
+                    BOOST_CHECK_EQUAL(route.get_double(), json_duration);
+                    break;
+                case 3: // geometry, delta encoded lon/lat pairs
+                {
+                    std::vector<std::int32_t> values;
+                    const auto packed = route.get_packed_sint32();
+                    std::copy(packed.first, packed.second, std::back_inserter(values));
+                    BOOST_REQUIRE_EQUAL(values.size(), 2 * json_coordinates.size());
+                    std::int32_t lon = values[0];
+                    for (std::size_t index = 2; index < values.size(); index += 2)
+                        lon += values[index];
+                    const auto &last = json_coordinates.back().get<json::Array>().values;
+                    BOOST_CHECK_CLOSE(lon / 1e6, last[0].get<json::Number>().value, 1e-4);
+                    break;
+                }
+                case 4: // legs
+                    route.skip();
+                    ++number_of_legs;
+                    break;
+                default:
+                    BOOST_CHECK(false);
+                }
+            }
+            BOOST_CHECK_EQUAL(number_of_legs, params.coordinates.size() - 1);
+            break;
+        }
+        default:
+            BOOST_CHECK(false);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(code, "Ok");
+    BOOST_CHECK_EQUAL(number_of_waypoints, params.coordinates.size());
+    BOOST_CHECK_EQUAL(number_of_routes, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_pbf_rejects_steps)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    RouteParameters params;
+    params.steps = true;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    std::string pbf_result;
+    const auto rc = osrm.Route(params, pbf_result);
+    BOOST_CHECK(rc == Status::Error);
+
+    protozero::pbf_reader response(pbf_result);
+    BOOST_REQUIRE(response.next(1));
+    BOOST_CHECK_EQUAL(response.get_string(), "InvalidOptions");
+}
+
+BOOST_AUTO_TEST_CASE(test_route_cached_matches_uncached)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args.at(0)};
+    config.use_shared_memory = false;
+    config.result_cache_size = 4;
+    OSRM cached_osrm{config};
+
+    RouteParameters params;
+    params.steps = true;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+
+    json::Object reference;
+    BOOST_CHECK(osrm.Route(params, reference) == Status::Ok);
+
+    // the second request is answered from the cache
+    for (int request = 0; request < 2; ++request)
+    {
+        json::Object result;
+        BOOST_CHECK(cached_osrm.Route(params, result) == Status::Ok);
+        CHECK_EQUAL_JSON(reference, result);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
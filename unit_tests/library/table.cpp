@@ -3,6 +3,7 @@
 
 #include "args.hpp"
 #include "coordinates.hpp"
+#include "equal_json.hpp"
 #include "fixture.hpp"
 #include "waypoint_check.hpp"
 
@@ -11,9 +12,21 @@
 #include "osrm/coordinate.hpp"
 #include "osrm/engine_config.hpp"
 #include "osrm/json_container.hpp"
+#include "osrm/json_writer.hpp"
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "util/json_renderer.hpp"
+#include "util/metrics.hpp"
+
+#include <protozero/pbf_reader.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(table)
 
 BOOST_AUTO_TEST_CASE(test_table_three_coords_one_source_one_dest_matrix)
@@ -161,4 +174,245 @@ BOOST_AUTO_TEST_CASE(test_table_three_coordinates_matrix)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_table_limited_threads_matches_unlimited)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_table_threads = 1;
+
+    OSRM limited_osrm{config};
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.coordinates.push_back(get_dummy_location());
+
+    json::Object result;
+    json::Object limited_result;
+
+    const auto rc = osrm.Table(params, result);
+    const auto limited_rc = limited_osrm.Table(params, limited_result);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(limited_rc == Status::Ok);
+
+    const auto &durations = result.values.at("durations").get<json::Array>().values;
+    const auto &limited_durations =
+        limited_result.values.at("durations").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(durations.size(), limited_durations.size());
+    for (unsigned int i = 0; i < durations.size(); i++)
+    {
+        const auto &row = durations[i].get<json::Array>().values;
+        const auto &limited_row = limited_durations[i].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(row.size(), limited_row.size());
+        for (unsigned int j = 0; j < row.size(); j++)
+        {
+            BOOST_CHECK_EQUAL(row[j].get<json::Number>().value,
+                              limited_row[j].get<json::Number>().value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_many_destinations_matches_small_table)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    const auto number_of_locations = params.coordinates.size();
+
+    // enough destinations to use the downward sweep instead of many-to-many
+    TableParameters wide_params;
+    wide_params.coordinates = params.coordinates;
+    for (std::size_t i = 0; i < 1024; i++)
+    {
+        wide_params.destinations.push_back(i % number_of_locations);
+    }
+
+    json::Object result;
+    json::Object wide_result;
+
+    const auto sweeps = util::metrics::Get(util::metrics::Counter::TableSweeps);
+    const auto rc = osrm.Table(params, result);
+    BOOST_CHECK_EQUAL(util::metrics::Get(util::metrics::Counter::TableSweeps), sweeps);
+    const auto wide_rc = osrm.Table(wide_params, wide_result);
+    BOOST_CHECK_EQUAL(util::metrics::Get(util::metrics::Counter::TableSweeps), sweeps + 1);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(wide_rc == Status::Ok);
+
+    const auto &durations = result.values.at("durations").get<json::Array>().values;
+    const auto &wide_durations = wide_result.values.at("durations").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(durations.size(), wide_durations.size());
+    for (unsigned int i = 0; i < durations.size(); i++)
+    {
+        const auto &row = durations[i].get<json::Array>().values;
+        const auto &wide_row = wide_durations[i].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(wide_row.size(), wide_params.destinations.size());
+        for (unsigned int j = 0; j < wide_row.size(); j++)
+        {
+            BOOST_CHECK_EQUAL(row[j % number_of_locations].get<json::Number>().value,
+                              wide_row[j].get<json::Number>().value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_streaming_matches_object)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.sources.push_back(0);
+
+    json::Object result;
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    const auto rc = osrm.Table(params, result);
+    const auto streamed_rc = osrm.Table(params, writer);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(streamed_rc == Status::Ok);
+
+    // members of the streamed object are in a fixed order, arrays can be compared as text
+    std::vector<char> durations;
+    mapbox::util::apply_visitor(util::json::ArrayRenderer(durations),
+                                result.values.at("durations"));
+    const std::string streamed(buffer.begin(), buffer.end());
+    BOOST_CHECK_EQUAL(streamed.substr(0, 13), "{\"code\":\"Ok\"");
+    BOOST_CHECK(streamed.find("\"durations\":" + std::string(durations.begin(), durations.end()) +
+                              "}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_pbf_matches_json)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.sources.push_back(0);
+
+    json::Object json_result;
+    std::string pbf_result;
+
+    const auto rc = osrm.Table(params, json_result);
+    const auto pbf_rc = osrm.Table(params, pbf_result);
+
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK(pbf_rc == Status::Ok);
+
+    std::string code;
+    std::size_t number_of_sources = 0;
+    std::size_t number_of_destinations = 0;
+    std::vector<std::int32_t> durations;
+    protozero::pbf_reader response(pbf_result);
+    while (response.next())
+    {
+        switch (response.tag())
+        {
+        case 1: // code
+            code = response.get_string();
+            break;
+        case 5: // sources
+            response.skip();
+            ++number_of_sources;
+            break;
+        case 6: // destinations
+            response.skip();
+            ++number_of_destinations;
+            break;
+        case 7: // durations
+        {
+            const auto packed = response.get_packed_sint32();
+            std::copy(packed.first, packed.second, std::back_inserter(durations));
+            break;
+        }
+        default:
+            BOOST_CHECK(false);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(code, "Ok");
+    BOOST_CHECK_EQUAL(number_of_sources, 1);
+    BOOST_CHECK_EQUAL(number_of_destinations, params.coordinates.size());
+
+    // the packed durations are in deciseconds, row after row
+    const auto &json_rows = json_result.values.at("durations").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(durations.size(), json_rows.size() * params.coordinates.size());
+    const auto &json_row = json_rows.at(0).get<json::Array>().values;
+    for (std::size_t column = 0; column < json_row.size(); ++column)
+    {
+        BOOST_CHECK_EQUAL(durations[column] / 10., json_row[column].get<json::Number>().value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_cached_matches_uncached)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.result_cache_size = 4;
+    OSRM cached_osrm{config};
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        params.coordinates.push_back(location);
+    }
+    params.sources.push_back(0);
+
+    json::Object reference;
+    BOOST_CHECK(osrm.Table(params, reference) == Status::Ok);
+
+    // the second request is answered from the cache
+    for (int request = 0; request < 2; ++request)
+    {
+        json::Object result;
+        BOOST_CHECK(cached_osrm.Table(params, result) == Status::Ok);
+        CHECK_EQUAL_JSON(reference, result);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
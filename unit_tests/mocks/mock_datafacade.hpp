@@ -21,6 +21,7 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
 {
   private:
     EdgeData foo;
+    contractor::SweepEdge sweep_edge;
 
   public:
     unsigned GetNumberOfNodes() const override { return 0; }
@@ -50,6 +51,18 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
         return SPECIAL_EDGEID;
     }
 
+    bool HasDownwardSweep() const override { return false; }
+    NodeID GetSweepPosition(const NodeID /* node */) const override { return SPECIAL_NODEID; }
+    osrm::engine::datafacade::EdgeRange
+    GetSweepEdgeRange(const NodeID /* position */) const override
+    {
+        return util::irange(static_cast<EdgeID>(0), static_cast<EdgeID>(0));
+    }
+    const contractor::SweepEdge &GetSweepEdge(const EdgeID /* edge */) const override
+    {
+        return sweep_edge;
+    }
+
     EdgeID FindEdgeIndicateIfReverse(const NodeID /* from */,
                                      const NodeID /* to */,
                                      bool & /* result */) const override
@@ -96,6 +109,38 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
     {
         return {};
     }
+    engine::datafacade::GeometryRange
+    GetUncompressedForwardGeometryRange(const EdgeID /* id */) const override
+    {
+        return {};
+    }
+    engine::datafacade::GeometryRange
+    GetUncompressedReverseGeometryRange(const EdgeID /* id */) const override
+    {
+        return {};
+    }
+    engine::datafacade::WeightRange
+    GetUncompressedForwardWeightsRange(const EdgeID /* id */) const override
+    {
+        static const EdgeWeight weight = 1;
+        return engine::datafacade::WeightRange(&weight, 1);
+    }
+    engine::datafacade::WeightRange
+    GetUncompressedReverseWeightsRange(const EdgeID /* id */) const override
+    {
+        static const EdgeWeight weight = 1;
+        return engine::datafacade::WeightRange(&weight, 1);
+    }
+    engine::datafacade::DatasourceRange
+    GetUncompressedForwardDatasourcesRange(const EdgeID /*id*/) const override
+    {
+        return {};
+    }
+    engine::datafacade::DatasourceRange
+    GetUncompressedReverseDatasourcesRange(const EdgeID /*id*/) const override
+    {
+        return {};
+    }
     std::string GetDatasourceName(const uint8_t /*datasource_name_id*/) const override
     {
         return "";
@@ -0,0 +1,115 @@
+#include "server/compression_pool.hpp"
+#include "server/http/compression_type.hpp"
+#include "util/exception.hpp"
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compression_pool)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+std::vector<char> makeContent()
+{
+    std::vector<char> content;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto chunk = "{\"code\":\"Ok\",\"duration\":" + std::to_string(i) + "},";
+        content.insert(content.end(), chunk.begin(), chunk.end());
+    }
+    return content;
+}
+
+template <typename Decompressor>
+std::vector<char> decompress(const std::vector<char> &compressed, Decompressor decompressor)
+{
+    std::vector<char> decompressed;
+    boost::iostreams::filtering_istream stream;
+    stream.push(decompressor);
+    stream.push(boost::iostreams::array_source(compressed.data(), compressed.size()));
+    boost::iostreams::copy(stream, boost::iostreams::back_inserter(decompressed));
+    return decompressed;
+}
+}
+
+BOOST_AUTO_TEST_CASE(gzip_roundtrip_test)
+{
+    const auto content = makeContent();
+    std::vector<char> compressed;
+    CompressionPool::Compress(content, http::gzip_rfc1952, 1, compressed);
+
+    BOOST_CHECK_LT(compressed.size(), content.size());
+    const auto decompressed = decompress(compressed, boost::iostreams::gzip_decompressor());
+    BOOST_CHECK(decompressed == content);
+}
+
+BOOST_AUTO_TEST_CASE(deflate_roundtrip_test)
+{
+    const auto content = makeContent();
+    std::vector<char> compressed;
+    CompressionPool::Compress(content, http::deflate_rfc1951, 9, compressed);
+
+    // raw deflate stream without zlib header
+    boost::iostreams::zlib_params parameters;
+    parameters.noheader = true;
+    const auto decompressed =
+        decompress(compressed, boost::iostreams::zlib_decompressor(parameters));
+    BOOST_CHECK(decompressed == content);
+}
+
+BOOST_AUTO_TEST_CASE(threshold_test)
+{
+    CompressionPool pool(1, 1, 100);
+    BOOST_CHECK(!pool.ShouldCompress(http::gzip_rfc1952, std::vector<char>(99)));
+    BOOST_CHECK(pool.ShouldCompress(http::gzip_rfc1952, std::vector<char>(100)));
+    BOOST_CHECK(!pool.ShouldCompress(http::no_compression, std::vector<char>(100)));
+}
+
+BOOST_AUTO_TEST_CASE(compress_on_pool_test)
+{
+    CompressionPool pool(2, 1, 0);
+    const auto content = makeContent();
+    std::vector<char> compressed;
+
+    std::mutex mutex;
+    std::condition_variable finished_condition;
+    bool finished = false;
+    http::compression_type applied = http::no_compression;
+    pool.Compress(content, http::gzip_rfc1952, compressed, [&](const http::compression_type type) {
+        std::lock_guard<std::mutex> lock(mutex);
+        applied = type;
+        finished = true;
+        finished_condition.notify_one();
+    });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished_condition.wait(lock, [&] { return finished; });
+    BOOST_CHECK(applied == http::gzip_rfc1952);
+    const auto decompressed = decompress(compressed, boost::iostreams::gzip_decompressor());
+    BOOST_CHECK(decompressed == content);
+}
+
+BOOST_AUTO_TEST_CASE(compress_failure_test)
+{
+    const auto content = makeContent();
+    std::vector<char> compressed;
+    // zlib rejects the level, the pool sends such replies uncompressed
+    BOOST_CHECK_THROW(CompressionPool::Compress(content, http::gzip_rfc1952, 42, compressed),
+                      util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
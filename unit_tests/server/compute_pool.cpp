@@ -0,0 +1,67 @@
+#include "server/compute_pool.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(compute_pool)
+
+using namespace osrm;
+using namespace osrm::server;
+
+BOOST_AUTO_TEST_CASE(per_service_queue_limit_test)
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool started = false;
+    bool released = false;
+    std::atomic<int> finished{0};
+
+    const auto match = util::metrics::RegisterService("match");
+    const auto route = util::metrics::RegisterService("route");
+
+    {
+        ComputePool pool(1, 1);
+
+        // blocks the only worker until released
+        BOOST_CHECK(pool.Submit(match, [&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            started = true;
+            changed.notify_all();
+            changed.wait(lock, [&] { return released; });
+            ++finished;
+        }));
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return started; });
+        }
+
+        BOOST_CHECK(pool.Submit(match, [&] { ++finished; }));
+        BOOST_CHECK(!pool.Submit(match, [&] { ++finished; }));
+        BOOST_CHECK(pool.Submit(route, [&] { ++finished; }));
+        BOOST_CHECK(!pool.Submit(route, [&] { ++finished; }));
+        // all unknown services share a single queue
+        BOOST_CHECK(pool.Submit(util::metrics::INVALID_SERVICE, [&] { ++finished; }));
+        BOOST_CHECK(!pool.Submit(util::metrics::INVALID_SERVICE, [&] { ++finished; }));
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            released = true;
+        }
+        changed.notify_all();
+
+        // queued tasks are dropped on shutdown, wait for them to run
+        while (finished < 4)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    BOOST_CHECK_EQUAL(finished, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,7 @@
 #ifndef OSRM_TEST_SERVER_PARAMETERS_IO
 #define OSRM_TEST_SERVER_PARAMETERS_IO
 
+#include "engine/api/base_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/bearing.hpp"
 
@@ -46,6 +47,22 @@ inline std::ostream &operator<<(std::ostream &out, api::RouteParameters::Overvie
     }
     return out;
 }
+
+inline std::ostream &operator<<(std::ostream &out, api::BaseParameters::OutputFormatType format)
+{
+    switch (format)
+    {
+    case api::BaseParameters::OutputFormatType::JSON:
+        out << "JSON";
+        break;
+    case api::BaseParameters::OutputFormatType::PBF:
+        out << "PBF";
+        break;
+    default:
+        BOOST_ASSERT_MSG(false, "OutputFormatType not fully captured");
+    }
+    return out;
+}
 }
 
 inline std::ostream &operator<<(std::ostream &out, Bearing bearing)
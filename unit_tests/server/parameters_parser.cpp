@@ -3,6 +3,9 @@
 #include "parameters_io.hpp"
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/batch_nearest_parameters.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -51,6 +54,7 @@ BOOST_AUTO_TEST_CASE(invalid_route_urls)
                       32UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?generate_hints=notboolean"),
                       23UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?format=xml"), 15UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?overview=false&geometries=foo"),
                       34UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?overview=false&overview=foo"),
@@ -311,6 +315,16 @@ BOOST_AUTO_TEST_CASE(valid_route_urls)
     auto result_13 = parseParameters<RouteParameters>("1,2;3,4");
     BOOST_CHECK(result_13);
     BOOST_CHECK_EQUAL(result_13->generate_hints, true);
+    BOOST_CHECK_EQUAL(result_13->format, RouteParameters::OutputFormatType::JSON);
+
+    auto result_14 = parseParameters<RouteParameters>("1,2;3,4?format=pbf&overview=full");
+    BOOST_CHECK(result_14);
+    BOOST_CHECK_EQUAL(result_14->format, RouteParameters::OutputFormatType::PBF);
+    BOOST_CHECK_EQUAL(result_14->overview, RouteParameters::OverviewType::Full);
+
+    auto result_15 = parseParameters<RouteParameters>("1,2;3,4?format=json");
+    BOOST_CHECK(result_15);
+    BOOST_CHECK_EQUAL(result_15->format, RouteParameters::OutputFormatType::JSON);
 }
 
 BOOST_AUTO_TEST_CASE(valid_table_urls)
@@ -347,6 +361,12 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.bearings, result_3->bearings);
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_3->radiuses);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_3->coordinates);
+
+    std::vector<std::size_t> sources_4 = {0};
+    auto result_4 = parseParameters<TableParameters>("1,2;3,4?sources=0&format=pbf");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK_EQUAL(result_4->format, TableParameters::OutputFormatType::PBF);
+    CHECK_EQUAL_RANGE(sources_4, result_4->sources);
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
@@ -398,6 +418,117 @@ BOOST_AUTO_TEST_CASE(valid_nearest_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
 }
 
+BOOST_AUTO_TEST_CASE(invalid_isochrone_urls)
+{
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?duration=foo"), 13UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?duration=60&output=foo"),
+                      23UL);
+}
+
+BOOST_AUTO_TEST_CASE(valid_isochrone_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+
+    IsochroneParameters reference_1{};
+    reference_1.coordinates = coords_1;
+    auto result_1 = parseParameters<IsochroneParameters>("1,2");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(!result_1->IsValid());
+    BOOST_CHECK_EQUAL(reference_1.duration, result_1->duration);
+    BOOST_CHECK(reference_1.output == result_1->output);
+    CHECK_EQUAL_RANGE(reference_1.coordinates, result_1->coordinates);
+
+    IsochroneParameters reference_2{};
+    reference_2.coordinates = coords_1;
+    reference_2.duration = 90.5;
+    reference_2.output = IsochroneParameters::OutputType::Segments;
+    auto result_2 = parseParameters<IsochroneParameters>("1,2?duration=90.5&output=segments");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->IsValid());
+    BOOST_CHECK_EQUAL(reference_2.duration, result_2->duration);
+    BOOST_CHECK(reference_2.output == result_2->output);
+    CHECK_EQUAL_RANGE(reference_2.bearings, result_2->bearings);
+    CHECK_EQUAL_RANGE(reference_2.radiuses, result_2->radiuses);
+    CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
+
+    auto result_3 = parseParameters<IsochroneParameters>("1,2;3,4?duration=60");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_batch_route_urls)
+{
+    BOOST_CHECK_EQUAL(testInvalidOptions<BatchRouteParameters>("1,2;3,4?pairs=0"), 15UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<BatchRouteParameters>("1,2;3,4?pairs=0,1;a"), 17UL);
+    // alternatives are not supported
+    BOOST_CHECK_EQUAL(
+        testInvalidOptions<BatchRouteParameters>("1,2;3,4?pairs=0,1&alternatives=true"), 17UL);
+}
+
+BOOST_AUTO_TEST_CASE(valid_batch_route_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                                              {util::FloatLongitude{3}, util::FloatLatitude{4}}};
+
+    BatchRouteParameters reference_1{};
+    reference_1.coordinates = coords_1;
+    reference_1.pairs = {{0, 1}, {1, 0}, {1, 1}};
+    auto result_1 = parseParameters<BatchRouteParameters>("1,2;3,4?pairs=0,1;1,0;1,1");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->IsValid());
+    BOOST_CHECK(reference_1.pairs == result_1->pairs);
+    BOOST_CHECK(result_1->overview == RouteParameters::OverviewType::False);
+    CHECK_EQUAL_RANGE(reference_1.coordinates, result_1->coordinates);
+
+    auto result_2 = parseParameters<BatchRouteParameters>(
+        "1,2;3,4?pairs=0,1&overview=full&geometries=geojson&radiuses=10;unlimited");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->IsValid());
+    BOOST_CHECK(result_2->overview == RouteParameters::OverviewType::Full);
+    BOOST_CHECK(result_2->geometries == RouteParameters::GeometriesType::GeoJSON);
+    BOOST_CHECK_EQUAL(result_2->radiuses.size(), 2);
+
+    // pairs refer to coordinates that do not exist or are missing
+    auto result_3 = parseParameters<BatchRouteParameters>("1,2;3,4?pairs=0,2");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+    auto result_4 = parseParameters<BatchRouteParameters>("1,2;3,4");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(!result_4->IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_batch_nearest_urls)
+{
+    BOOST_CHECK_EQUAL(testInvalidOptions<BatchNearestParameters>("1,2;3,4?number=a"), 15UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<BatchNearestParameters>("1,2;3,4?pairs=0,1"), 8UL);
+}
+
+BOOST_AUTO_TEST_CASE(valid_batch_nearest_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                                              {util::FloatLongitude{3}, util::FloatLatitude{4}},
+                                              {util::FloatLongitude{5}, util::FloatLatitude{6}}};
+
+    BatchNearestParameters reference_1{};
+    reference_1.coordinates = coords_1;
+    auto result_1 = parseParameters<BatchNearestParameters>("1,2;3,4;5,6");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->IsValid());
+    BOOST_CHECK_EQUAL(reference_1.number_of_results, result_1->number_of_results);
+    CHECK_EQUAL_RANGE(reference_1.coordinates, result_1->coordinates);
+
+    auto result_2 =
+        parseParameters<BatchNearestParameters>("1,2;3,4;5,6?number=3&radiuses=10;;unlimited");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->IsValid());
+    BOOST_CHECK_EQUAL(result_2->number_of_results, 3);
+    BOOST_CHECK_EQUAL(result_2->radiuses.size(), 3);
+
+    auto result_3 = parseParameters<BatchNearestParameters>("1,2;3,4?number=0");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+}
+
 BOOST_AUTO_TEST_CASE(invalid_tile_urls)
 {
     TileParameters reference_1{1, 2, 3};
@@ -0,0 +1,95 @@
+#include "server/request_parser.hpp"
+#include "server/http/compression_type.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <tuple>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+// parses a complete request and returns whether it asks for a persistent connection
+bool parseKeepAlive(std::string input)
+{
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+    std::tie(status, compression, parsed_end) =
+        parser.parse(request, &input[0], &input[0] + input.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    return request.keep_alive;
+}
+}
+
+BOOST_AUTO_TEST_CASE(keep_alive_test)
+{
+    BOOST_CHECK(parseKeepAlive("GET /a HTTP/1.1\r\n\r\n"));
+    BOOST_CHECK(!parseKeepAlive("GET /a HTTP/1.1\r\nConnection: close\r\n\r\n"));
+    BOOST_CHECK(!parseKeepAlive("GET /a HTTP/1.0\r\n\r\n"));
+    BOOST_CHECK(parseKeepAlive("GET /a HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n"));
+    BOOST_CHECK(
+        parseKeepAlive("GET /a HTTP/1.0\r\nconnection: keep-alive\r\nUser-Agent: x\r\n\r\n"));
+}
+
+BOOST_AUTO_TEST_CASE(pipelined_requests_test)
+{
+    std::string input = "GET /first HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n"
+                        "GET /second HTTP/1.1\r\nConnection: close\r\n\r\n";
+    char *const end = &input[0] + input.size();
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+
+    std::tie(status, compression, parsed_end) = parser.parse(request, &input[0], end);
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(compression, http::gzip_rfc1952);
+    BOOST_CHECK_EQUAL(request.uri, "/first");
+    BOOST_CHECK(request.keep_alive);
+    BOOST_CHECK_EQUAL(std::string(parsed_end, end).substr(0, 11), "GET /second");
+
+    request.clear();
+    parser.reset();
+    std::tie(status, compression, parsed_end) = parser.parse(request, parsed_end, end);
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(compression, http::no_compression);
+    BOOST_CHECK_EQUAL(request.uri, "/second");
+    BOOST_CHECK(!request.keep_alive);
+    BOOST_CHECK(parsed_end == end);
+}
+
+BOOST_AUTO_TEST_CASE(split_request_test)
+{
+    std::string input = "GET /route HTTP/1.1\r\nUser-Agent: test\r\n\r\n";
+    char *const middle = &input[0] + 12;
+    char *const end = &input[0] + input.size();
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+
+    std::tie(status, compression, parsed_end) = parser.parse(request, &input[0], middle);
+    BOOST_CHECK(status == RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK(parsed_end == middle);
+
+    std::tie(status, compression, parsed_end) = parser.parse(request, middle, end);
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.uri, "/route");
+    BOOST_CHECK_EQUAL(request.agent, "test");
+    BOOST_CHECK(parsed_end == end);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
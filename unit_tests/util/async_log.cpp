@@ -0,0 +1,71 @@
+#include "util/async_log.hpp"
+#include "util/log.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(async_log_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+// captures std::cout for the lifetime of the object
+struct CaptureStdout
+{
+    CaptureStdout() : previous(std::cout.rdbuf(captured.rdbuf())) {}
+    ~CaptureStdout() { std::cout.rdbuf(previous); }
+
+    std::stringstream captured;
+    std::streambuf *previous;
+};
+}
+
+BOOST_AUTO_TEST_CASE(write_lines_test)
+{
+    LogPolicy::GetInstance().Unmute();
+    CaptureStdout capture;
+    {
+        AsyncLog async_log(16);
+        BOOST_CHECK_EQUAL(AsyncLog::Current(), &async_log);
+
+        Log() << "first line";
+        std::thread([] { Log() << "second line"; }).join();
+    }
+    BOOST_CHECK(AsyncLog::Current() == nullptr);
+    LogPolicy::GetInstance().Mute();
+
+    const auto output = capture.captured.str();
+    BOOST_CHECK(output.find("[info] first line") != std::string::npos);
+    BOOST_CHECK(output.find("[info] second line") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(drop_lines_test)
+{
+    CaptureStdout capture;
+    const std::size_t num_lines = 10000;
+    std::uint64_t dropped;
+    {
+        AsyncLog async_log(4);
+        for (std::size_t line = 0; line < num_lines; ++line)
+        {
+            async_log.Push(logINFO, "line");
+        }
+        dropped = async_log.Dropped();
+    }
+
+    // every line was either written or dropped
+    const auto output = capture.captured.str();
+    const auto written = static_cast<std::size_t>(std::count(output.begin(), output.end(), '\n'));
+    BOOST_CHECK_GT(dropped, 0);
+    BOOST_CHECK_EQUAL(written + dropped, num_lines);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
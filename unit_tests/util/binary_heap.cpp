@@ -25,7 +25,8 @@ typedef int TestKey;
 typedef int TestWeight;
 typedef boost::mpl::list<ArrayStorage<TestNodeID, TestKey>,
                          MapStorage<TestNodeID, TestKey>,
-                         UnorderedMapStorage<TestNodeID, TestKey>>
+                         UnorderedMapStorage<TestNodeID, TestKey>,
+                         GenerationArrayStorage<TestNodeID, TestKey>>
     storage_types;
 
 template <unsigned NUM_ELEM> struct RandomDataFixture
@@ -123,6 +124,36 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(delete_all_test, T, storage_types, RandomDataFi
     BOOST_CHECK(heap.Empty());
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(clear_test, T, storage_types, RandomDataFixture<NUM_NODES>)
+{
+    BinaryHeap<TestNodeID, TestKey, TestWeight, TestData, T> heap(NUM_NODES);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    heap.Clear();
+
+    BOOST_CHECK(heap.Empty());
+    for (auto id : ids)
+    {
+        BOOST_CHECK(!heap.WasInserted(id));
+    }
+
+    // re-inserting only every second node must not resurrect the others
+    for (unsigned idx = 0; idx < NUM_NODES; idx += 2)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    for (unsigned idx = 0; idx < NUM_NODES; ++idx)
+    {
+        BOOST_CHECK_EQUAL(heap.WasInserted(ids[idx]), idx % 2 == 0);
+    }
+    BOOST_CHECK_EQUAL(heap.Min(), ids[0]);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(decrease_key_test, T, storage_types, RandomDataFixture<10>)
 {
     BinaryHeap<TestNodeID, TestKey, TestWeight, TestData, T> heap(10);
@@ -82,4 +82,31 @@ BOOST_AUTO_TEST_CASE(hilbert_linearization_32bit_test)
     BOOST_CHECK_EQUAL(bit32(0xffffffff, 0xffffffff), 0xaaaaaaaaaaaaaaaa);
 }
 
+BOOST_AUTO_TEST_CASE(hilbert_order_test)
+{
+    const auto coordinate = [](const double lon, const double lat) {
+        return Coordinate{FloatLongitude{lon}, FloatLatitude{lat}};
+    };
+
+    BOOST_CHECK(HilbertOrder({}).empty());
+
+    const std::vector<Coordinate> coordinates = {coordinate(90., -45.),
+                                                 coordinate(-90., 45.),
+                                                 coordinate(90., 45.),
+                                                 coordinate(-90., -45.),
+                                                 coordinate(-90., 45.)};
+    const auto order = HilbertOrder(coordinates);
+    BOOST_REQUIRE_EQUAL(order.size(), coordinates.size());
+    for (std::size_t i = 1; i < order.size(); ++i)
+    {
+        const auto previous = GetHilbertCode(coordinates[order[i - 1]]);
+        const auto current = GetHilbertCode(coordinates[order[i]]);
+        BOOST_CHECK_LE(previous, current);
+        // equal coordinates stay in their input order
+        BOOST_CHECK(previous != current || order[i - 1] < order[i]);
+    }
+    BOOST_CHECK(std::is_permutation(
+        order.begin(), order.end(), std::vector<std::size_t>{0, 1, 2, 3, 4}.begin()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
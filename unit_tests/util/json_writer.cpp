@@ -0,0 +1,94 @@
+#include "util/cast.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(json_writer)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(write_nested_object)
+{
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    writer.StartObject();
+    writer.WriteKey("code");
+    writer.WriteString("Ok");
+    writer.WriteKey("values");
+    writer.StartArray();
+    writer.WriteNumber(1.5);
+    writer.WriteNull();
+    writer.StartArray();
+    writer.EndArray();
+    writer.WriteBool(true);
+    writer.EndArray();
+    writer.WriteKey("empty");
+    writer.StartObject();
+    writer.EndObject();
+    writer.EndObject();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                      "{\"code\":\"Ok\",\"values\":[1.5,null,[],true],\"empty\":{}}");
+}
+
+BOOST_AUTO_TEST_CASE(write_escaped_string)
+{
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    writer.StartArray();
+    writer.WriteString("Aleja \"Solidarnosci\"");
+    writer.WriteString("a/b\\c\n");
+    writer.EndArray();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                      "[\"Aleja \\\"Solidarnosci\\\"\",\"a\\/b\\\\c\\n\"]");
+}
+
+BOOST_AUTO_TEST_CASE(write_dom_value)
+{
+    json::Array array;
+    array.values.push_back(json::Number(7.25));
+    array.values.push_back(json::String("x"));
+
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    writer.StartObject();
+    writer.WriteKey("first");
+    writer.WriteValue(array);
+    writer.WriteKey("second");
+    writer.WriteNumber(2);
+    writer.EndObject();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                      "{\"first\":[7.25,\"x\"],\"second\":2}");
+}
+
+BOOST_AUTO_TEST_CASE(number_formatting)
+{
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(0.), "0");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(10.), "10");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(-1.5), "-1.5");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(7.419062), "7.419062");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(43.73754), "43.73754");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(0.1234567), "0.123457");
+    // ties are rounded to even like printf does
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(0.0078125), "0.007812");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(0.0234375), "0.023438");
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(-0.0000001), "0");
+    // too large for the fixed point path
+    BOOST_CHECK_EQUAL(cast::to_string_with_precision(1e20), "100000000000000000000");
+
+    std::vector<char> buffer;
+    cast::append_with_precision<2>(buffer, 3.14159);
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()), "3.14");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
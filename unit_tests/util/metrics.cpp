@@ -0,0 +1,90 @@
+#include "util/latency_histogram.hpp"
+#include "util/metrics.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(metrics_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(histogram_buckets_test)
+{
+    const std::vector<std::uint64_t> values = {
+        0, 1, 7, 8, 9, 15, 16, 17, 100, 1000, 123456, std::uint64_t{1} << 31};
+    for (const auto value : values)
+    {
+        const auto bucket = LatencyHistogram::BucketIndex(value);
+        BOOST_CHECK_LT(value, LatencyHistogram::BucketUpperBound(bucket));
+        if (bucket > 0)
+        {
+            BOOST_CHECK_GE(value, LatencyHistogram::BucketUpperBound(bucket - 1));
+        }
+        // the bucket width is at most an eighth of its lower bound
+        BOOST_CHECK_LE(LatencyHistogram::BucketUpperBound(bucket) - value, value / 8 + 1);
+    }
+    BOOST_CHECK_EQUAL(LatencyHistogram::BucketIndex(std::uint64_t{1} << 40),
+                      LatencyHistogram::NUM_BUCKETS - 1);
+
+    LatencyHistogram histogram;
+    histogram.Record(10);
+    histogram.Record(10);
+    histogram.Record(1000);
+    BOOST_CHECK_EQUAL(histogram.Count(LatencyHistogram::BucketIndex(10)), 2);
+    BOOST_CHECK_EQUAL(histogram.Count(LatencyHistogram::BucketIndex(1000)), 1);
+    BOOST_CHECK_EQUAL(histogram.Sum(), 1020);
+}
+
+BOOST_AUTO_TEST_CASE(render_test)
+{
+    const auto service = metrics::RegisterService("metrics_test");
+    BOOST_CHECK_EQUAL(metrics::RegisterService("metrics_test"), service);
+    BOOST_CHECK_EQUAL(metrics::FindService("metrics_test"), service);
+    BOOST_CHECK_EQUAL(metrics::FindService("unknown"), metrics::INVALID_SERVICE);
+
+    // histograms of different threads are merged
+    metrics::Record(service, metrics::Stage::Search, std::chrono::microseconds(20));
+    std::thread([service] {
+        metrics::ScopedService scoped_service(service);
+        BOOST_CHECK_EQUAL(metrics::CurrentService(), service);
+        metrics::Record(service, metrics::Stage::Search, std::chrono::milliseconds(3));
+    }).join();
+    BOOST_CHECK_EQUAL(metrics::CurrentService(), metrics::INVALID_SERVICE);
+
+    std::vector<char> output;
+    metrics::Render(output);
+    const std::string text(output.begin(), output.end());
+
+    const std::string prefix =
+        "osrm_stage_duration_seconds_bucket{service=\"metrics_test\",stage=\"search\",le=";
+    BOOST_CHECK(text.find("# TYPE osrm_stage_duration_seconds histogram\n") != std::string::npos);
+    BOOST_CHECK(text.find(prefix + "\"0.000016\"} 0\n") != std::string::npos);
+    BOOST_CHECK(text.find(prefix + "\"0.000032\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find(prefix + "\"0.002048\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find(prefix + "\"0.004096\"} 2\n") != std::string::npos);
+    BOOST_CHECK(text.find(prefix + "\"+Inf\"} 2\n") != std::string::npos);
+    BOOST_CHECK(text.find("osrm_stage_duration_seconds_sum{service=\"metrics_test\","
+                          "stage=\"search\"} 0.003020\n") != std::string::npos);
+    BOOST_CHECK(text.find("osrm_stage_duration_seconds_count{service=\"metrics_test\","
+                          "stage=\"search\"} 2\n") != std::string::npos);
+    // stages without samples are left out
+    BOOST_CHECK(text.find("stage=\"render\"") == std::string::npos);
+    // counters are always exported
+    BOOST_CHECK(text.find("# TYPE osrm_snapping_cache_hits_total counter\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(counter_test)
+{
+    const auto before = metrics::Get(metrics::Counter::SnappingCacheMisses);
+    metrics::Increment(metrics::Counter::SnappingCacheMisses);
+    std::thread([] { metrics::Increment(metrics::Counter::SnappingCacheMisses, 2); }).join();
+    BOOST_CHECK_EQUAL(metrics::Get(metrics::Counter::SnappingCacheMisses) - before, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -46,6 +46,12 @@ using TestStaticRTree = StaticRTree<TestData,
                                     TEST_BRANCHING_FACTOR,
                                     TEST_LEAF_NODE_SIZE>;
 using MiniStaticRTree = StaticRTree<TestData, std::vector<Coordinate>, false, 2, 128>;
+using QuantizedTestRTree = StaticRTree<TestData,
+                                       std::vector<Coordinate>,
+                                       false,
+                                       TEST_BRANCHING_FACTOR,
+                                       TEST_LEAF_NODE_SIZE,
+                                       true>;
 
 // Choosen by a fair W20 dice roll (this value is completely arbitrary)
 constexpr unsigned RANDOM_SEED = 42;
@@ -302,6 +308,112 @@ BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_M
     construction_test("test_5", this);
 }
 
+BOOST_FIXTURE_TEST_CASE(in_memory_leaves_test, TestRandomGraphFixture_MultipleLevels)
+{
+    using SharedTestRTree = StaticRTree<TestData,
+                                        std::vector<Coordinate>,
+                                        true,
+                                        TEST_BRANCHING_FACTOR,
+                                        TEST_LEAF_NODE_SIZE>;
+    using LeafNode = SharedTestRTree::LeafNode;
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<TestRandomGraphFixture_MultipleLevels>("test_6", this, leaves_path, nodes_path);
+
+    // load nodes and leaves into memory like osrm-datastore does
+    storage::io::FileReader nodes_file(nodes_path, storage::io::FileReader::HasNoFingerprint);
+    std::vector<SharedTestRTree::TreeNode> nodes(SharedTestRTree::ReadTreeHeader(nodes_file));
+    nodes_file.ReadInto(nodes);
+
+    storage::io::FileReader leaves_file(leaves_path, storage::io::FileReader::HasNoFingerprint);
+    const auto number_of_leaves = leaves_file.Size() / sizeof(LeafNode);
+    std::size_t buffer_size = (number_of_leaves + 1) * sizeof(LeafNode);
+    std::unique_ptr<char[]> buffer(new char[buffer_size]);
+    void *leaves_ptr = buffer.get();
+    BOOST_REQUIRE(std::align(alignof(LeafNode), sizeof(LeafNode), leaves_ptr, buffer_size));
+    leaves_file.ReadInto(static_cast<LeafNode *>(leaves_ptr), number_of_leaves);
+
+    SharedTestRTree rtree(nodes.data(),
+                          nodes.size(),
+                          static_cast<const LeafNode *>(leaves_ptr),
+                          number_of_leaves,
+                          coords);
+    BOOST_CHECK_EQUAL(rtree.WarmUp(), edges.size());
+
+    LinearSearchNN<TestData> lsnn(coords, edges);
+    simple_verify_rtree(rtree, coords, edges);
+    sampling_verify_rtree(rtree, lsnn, coords, 100);
+
+    // the mapped leaf file holds the same segments
+    TestStaticRTree mapped_rtree(nodes_path, leaves_path, coords);
+    BOOST_CHECK_EQUAL(mapped_rtree.WarmUp(), edges.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(construct_quantized_test, TestRandomGraphFixture_MultipleLevels)
+{
+    construction_test<QuantizedTestRTree>("test_7", this);
+}
+
+BOOST_FIXTURE_TEST_CASE(quantized_bbox_search_test, TestRandomGraphFixture_MultipleLevels)
+{
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<TestRandomGraphFixture_MultipleLevels>("test_8", this, leaves_path, nodes_path);
+    TestStaticRTree rtree(nodes_path, leaves_path, coords);
+    build_rtree<TestRandomGraphFixture_MultipleLevels, QuantizedTestRTree>(
+        "test_9", this, leaves_path, nodes_path);
+    QuantizedTestRTree quantized_rtree(nodes_path, leaves_path, coords);
+
+    const auto sorted_ids = [](std::vector<TestData> edges) {
+        std::vector<std::pair<NodeID, NodeID>> ids;
+        for (const auto &edge : edges)
+        {
+            ids.emplace_back(edge.u, edge.v);
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_real_distribution<> lat_udist(-80, 80);
+    std::uniform_real_distribution<> lon_udist(-180, 180);
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        const auto lon = lon_udist(g);
+        const auto lat = lat_udist(g);
+        const RectangleInt2D bbox{FloatLongitude{lon},
+                                  FloatLongitude{std::min(lon + 10, 180.)},
+                                  FloatLatitude{lat},
+                                  FloatLatitude{std::min(lat + 10, 80.)}};
+
+        // the quantized boxes are only larger, so both trees find the same segments
+        const auto results = sorted_ids(rtree.SearchInBox(bbox));
+        const auto quantized_results = sorted_ids(quantized_rtree.SearchInBox(bbox));
+        BOOST_CHECK(results == quantized_results);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(node_layout_mismatch_test, TestRandomGraphFixture_MultipleLevels)
+{
+    using PlainTestRTree = StaticRTree<TestData,
+                                       std::vector<Coordinate>,
+                                       false,
+                                       TEST_BRANCHING_FACTOR,
+                                       TEST_LEAF_NODE_SIZE,
+                                       false>;
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<TestRandomGraphFixture_MultipleLevels, QuantizedTestRTree>(
+        "test_10", this, leaves_path, nodes_path);
+    BOOST_CHECK_THROW(PlainTestRTree(nodes_path, leaves_path, coords), util::exception);
+
+    build_rtree<TestRandomGraphFixture_MultipleLevels, PlainTestRTree>(
+        "test_11", this, leaves_path, nodes_path);
+    BOOST_CHECK_THROW(QuantizedTestRTree(nodes_path, leaves_path, coords), util::exception);
+}
+
 // Bug: If you querry a point that lies between two BBs that have a gap,
 // one BB will be pruned, even if it could contain a nearer match.
 BOOST_AUTO_TEST_CASE(regression_test)
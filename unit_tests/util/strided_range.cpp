@@ -0,0 +1,68 @@
+#include "util/strided_range.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(strided_range_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(forward_range_test)
+{
+    const std::vector<int> values = {1, 2, 3, 4, 5};
+    const auto range = makeForwardRange(values.data() + 1, values.data() + 4);
+
+    BOOST_CHECK_EQUAL(range.size(), 3);
+    BOOST_CHECK_EQUAL(range.front(), 2);
+    BOOST_CHECK_EQUAL(range.back(), 4);
+    BOOST_CHECK_EQUAL(range[1], 3);
+    BOOST_CHECK_EQUAL(std::distance(range.begin(), range.end()), 3);
+    BOOST_CHECK_EQUAL(std::accumulate(range.begin(), range.end(), 0), 9);
+
+    const std::vector<int> expected = {2, 3, 4};
+    const auto copy = toVector(range);
+    BOOST_CHECK_EQUAL_COLLECTIONS(copy.begin(), copy.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(reverse_range_test)
+{
+    const std::vector<int> values = {1, 2, 3, 4, 5};
+    const auto range = makeReverseRange(values.data() + 1, values.data() + 4);
+
+    BOOST_CHECK_EQUAL(range.size(), 3);
+    BOOST_CHECK_EQUAL(range.front(), 4);
+    BOOST_CHECK_EQUAL(range.back(), 2);
+    BOOST_CHECK_EQUAL(*(range.begin() + 2), 2);
+    BOOST_CHECK_EQUAL(*(range.end() - 1), 2);
+
+    const std::vector<int> expected = {4, 3, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(range.begin(), range.end(), expected.begin(), expected.end());
+
+    std::vector<int> reversed(values.begin() + 1, values.begin() + 4);
+    std::reverse(reversed.begin(), reversed.end());
+    BOOST_CHECK(std::equal(range.begin(), range.end(), reversed.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(repeated_range_test)
+{
+    const int value = 7;
+    const StridedRange<int> range(&value, 4, 0);
+
+    BOOST_CHECK_EQUAL(range.size(), 4);
+    BOOST_CHECK_EQUAL(std::count(range.begin(), range.end(), 7), 4);
+}
+
+BOOST_AUTO_TEST_CASE(empty_range_test)
+{
+    const StridedRange<int> range;
+
+    BOOST_CHECK(range.empty());
+    BOOST_CHECK(range.begin() == range.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()